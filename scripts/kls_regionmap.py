@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+#  SPDX-License-Identifier: GPL-3.0-only
+#  Script to render a region map dumped by kls_export_regions()
+#    Copyright (C) 2026  jgabaut
+#
+#    This program is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, version 3 of the License.
+#
+#    This program is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+"""
+Render a region map dumped by kls_export_regions() as an SVG file.
+
+Usage: kls_regionmap.py MAP_FILE [OUT_SVG]
+
+MAP_FILE can be either the CSV or the binary format. The SVG holds:
+  - an occupancy bar per block in the growable chain, showing data, alignment
+    padding, unused tail of grown-over blocks (abandoned) and free space;
+  - a treemap of data bytes, grouped by region type, then by region name.
+A text summary is printed to stdout.
+"""
+
+import csv
+import html
+import struct
+import sys
+
+script_version = "0.1"
+
+BIN_MAGIC = b"KLSRMAP1"
+BIN_HEADER = struct.Struct("<8sII")
+
+TYPE_NAMES = {0: "KLS_None", 1: "Temp_KLS_Header", 2: "KLS_Header"}
+COLORS = {
+    "header": "#9e9e9e",
+    "data": "#4caf50",
+    "temp": "#2196f3",
+    "padding": "#f44336",
+    "abandoned": "#ff9800",
+    "free": "#eeeeee",
+}
+PALETTE = ["#4caf50", "#2196f3", "#9c27b0", "#00bcd4", "#cddc39", "#795548", "#607d8b", "#e91e63"]
+
+
+def load(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+    records = []
+    if raw.startswith(BIN_MAGIC):
+        _, count, name_size = BIN_HEADER.unpack_from(raw, 0)
+        # The name field follows KLS_REGION_MAX_NAME_SIZE of the dumping build
+        record = struct.Struct("<cIqqqi%ds" % name_size)
+        pos = BIN_HEADER.size
+        for _ in range(count):
+            kind, block, offset, size, padding, rtype, name = record.unpack_from(raw, pos)
+            pos += record.size
+            records.append({
+                "kind": kind.decode(), "block": block, "offset": offset, "size": size,
+                "padding": padding, "type": rtype, "name": name.split(b"\0", 1)[0].decode(errors="replace"),
+            })
+    else:
+        for row in csv.DictReader(raw.decode().splitlines()):
+            records.append({
+                "kind": row["kind"], "block": int(row["block"]), "offset": int(row["offset"]),
+                "size": int(row["size"]), "padding": int(row["padding"]), "type": int(row["type"]),
+                "name": row["name"],
+            })
+    return records
+
+
+def human(n):
+    for unit in ("B", "KB", "MB", "GB"):
+        if n < 1024 or unit == "GB":
+            return "%d %s" % (n, unit) if unit == "B" else "%.2f %s" % (n, unit)
+        n /= 1024.0
+
+
+def summarize(blocks, regions):
+    last = max(blocks) if blocks else 0
+    stats = []
+    for b in sorted(blocks):
+        used, capacity = blocks[b]
+        regs = [r for r in regions if r["block"] == b]
+        padding = sum(r["padding"] for r in regs)
+        data = sum(r["size"] - r["padding"] for r in regs)
+        tail = capacity - used
+        stats.append({
+            "block": b, "capacity": capacity, "used": used, "data": data, "padding": padding,
+            "abandoned": tail if b != last else 0, "free": tail if b == last else 0,
+        })
+    return stats
+
+
+def squarify(items, x, y, w, h):
+    """Lay out (value, payload) items, sorted by decreasing value, in the passed rectangle."""
+    out = []
+    items = [it for it in items if it[0] > 0]
+    total = float(sum(v for v, _ in items))
+    while items and w > 0 and h > 0:
+        short = min(w, h)
+        row, row_sum, best = [], 0.0, None
+        for v, p in items:
+            cand_sum = row_sum + v
+            side = cand_sum / total * (w * h) / short
+            worst = max(max(side / (vv / total * w * h / side), (vv / total * w * h / side) / side) for vv, _ in row + [(v, p)])
+            if best is not None and worst > best:
+                break
+            row.append((v, p))
+            row_sum, best = cand_sum, worst
+        side = row_sum / total * (w * h) / short
+        pos = 0.0
+        for v, p in row:
+            length = v / total * (w * h) / side
+            if w >= h:
+                out.append((x, y + pos, side, length, p))
+            else:
+                out.append((x + pos, y, length, side, p))
+            pos += length
+        if w >= h:
+            x, w = x + side, w - side
+        else:
+            y, h = y + side, h - side
+        total -= row_sum
+        items = items[len(row):]
+    return out
+
+
+def render(blocks, regions, stats, out_path):
+    width, bar_h, margin = 1000, 28, 20
+    parts = []
+    y = margin
+    parts.append('<text x="%d" y="%d" font-weight="bold">Occupancy by block</text>' % (margin, y))
+    y += 10
+    for st in stats:
+        b = st["block"]
+        scale = (width - 2 * margin) / float(max(st["capacity"], 1))
+        parts.append('<rect x="%d" y="%d" width="%d" height="%d" fill="%s"/>' % (margin, y, width - 2 * margin, bar_h, COLORS["free"]))
+        for r in regions:
+            if r["block"] != b:
+                continue
+            kind = "header" if r["type"] in (1, 2) else ("temp" if r["kind"] == "T" else "data")
+            if r["padding"] > 0:
+                parts.append('<rect x="%.2f" y="%d" width="%.2f" height="%d" fill="%s"/>' % (
+                    margin + r["offset"] * scale, y, r["padding"] * scale, bar_h, COLORS["padding"]))
+            parts.append('<rect x="%.2f" y="%d" width="%.2f" height="%d" fill="%s"><title>%s: %d bytes</title></rect>' % (
+                margin + (r["offset"] + r["padding"]) * scale, y, (r["size"] - r["padding"]) * scale, bar_h,
+                COLORS[kind], html.escape(r["name"]), r["size"] - r["padding"]))
+        if st["abandoned"] > 0:
+            parts.append('<rect x="%.2f" y="%d" width="%.2f" height="%d" fill="%s"/>' % (
+                margin + st["used"] * scale, y, st["abandoned"] * scale, bar_h, COLORS["abandoned"]))
+        y += bar_h + 14
+        parts.append('<text x="%d" y="%d" font-size="11">block %d: %s used of %s, padding %s, abandoned %s</text>' % (
+            margin, y, b, human(st["used"]), human(st["capacity"]), human(st["padding"]), human(st["abandoned"])))
+        y += 12
+    y += 10
+    for i, key in enumerate(("header", "data", "temp", "padding", "abandoned", "free")):
+        parts.append('<rect x="%d" y="%d" width="12" height="12" fill="%s" stroke="#000"/><text x="%d" y="%d" font-size="11">%s</text>' % (
+            margin + i * 110, y, COLORS[key], margin + i * 110 + 16, y + 10, key))
+    y += 36
+
+    parts.append('<text x="%d" y="%d" font-weight="bold">Data bytes by type</text>' % (margin, y))
+    y += 10
+    by_type = {}
+    for r in regions:
+        by_type.setdefault(r["type"], {}).setdefault(r["name"], 0)
+        by_type[r["type"]][r["name"]] += r["size"] - r["padding"]
+    types = sorted(((sum(names.values()), t) for t, names in by_type.items()), reverse=True)
+    tm_h = 400
+    for tx, ty, tw, th, t in squarify(types, margin, y, width - 2 * margin, tm_h):
+        color = PALETTE[t % len(PALETTE)]
+        parts.append('<rect x="%.2f" y="%.2f" width="%.2f" height="%.2f" fill="%s" stroke="#000" stroke-width="2"/>' % (tx, ty, tw, th, color))
+        names = sorted(((v, n) for n, v in by_type[t].items()), reverse=True)
+        for nx, ny, nw, nh, n in squarify(names, tx + 2, ty + 2, tw - 4, th - 4):
+            parts.append('<rect x="%.2f" y="%.2f" width="%.2f" height="%.2f" fill="%s" fill-opacity="0.6" stroke="#fff"><title>%s / %s: %d bytes</title></rect>' % (
+                nx, ny, nw, nh, color, TYPE_NAMES.get(t, "type %d" % t), html.escape(n), by_type[t][n]))
+            if nw > 60 and nh > 14:
+                parts.append('<text x="%.2f" y="%.2f" font-size="11">%s</text>' % (nx + 3, ny + 12, html.escape(n)))
+    y += tm_h + margin
+
+    with open(out_path, "w") as f:
+        f.write('<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" font-family="monospace">\n' % (width, y))
+        f.write("\n".join(parts))
+        f.write("\n</svg>\n")
+
+
+def main(argv):
+    if len(argv) < 2 or argv[1] in ("-h", "--help"):
+        print(__doc__.strip())
+        return 0 if len(argv) >= 2 else 1
+    if argv[1] in ("-v", "--version"):
+        print(script_version)
+        return 0
+    records = load(argv[1])
+    out_path = argv[2] if len(argv) > 2 else argv[1] + ".svg"
+    blocks = {r["block"]: (r["offset"], r["size"]) for r in records if r["kind"] == "B"}
+    regions = [r for r in records if r["kind"] != "B"]
+    stats = summarize(blocks, regions)
+    for st in stats:
+        print("block %d: capacity %s, used %s, data %s, padding %s, abandoned %s, free %s" % (
+            st["block"], human(st["capacity"]), human(st["used"]), human(st["data"]),
+            human(st["padding"]), human(st["abandoned"]), human(st["free"])))
+    tot_cap = sum(st["capacity"] for st in stats)
+    waste = sum(st["padding"] + st["abandoned"] for st in stats)
+    if tot_cap > 0:
+        print("total: capacity %s, padding + abandoned %s (%.2f%%)" % (human(tot_cap), human(waste), waste * 100.0 / tot_cap))
+    render(blocks, regions, stats, out_path)
+    print("Wrote %s" % out_path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
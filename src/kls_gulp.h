@@ -43,6 +43,151 @@ Kstr kstr_token(Kstr* k, char delim);
 bool kstr_try_token(Kstr* k, char delim, Kstr* part);
 Kstr kstr_token_kstr(Kstr* k, Kstr delim);
 
+/**
+ * Represents a Kstr needle precompiled for substring search.
+ * Build it once with kstr_needle_new() to reuse it across many searches.
+ * @see kstr_find_needle()
+ * @see kstr_token_needle()
+ */
+typedef struct Kstr_Needle {
+    Kstr needle; /**< The searched Kstr. Its data must outlive the Kstr_Needle.*/
+    size_t ms; /**< Critical factorization position, minus one.*/
+    size_t period; /**< Shift applied after a full match of the right half.*/
+    size_t mem0; /**< Prefix known to match after a shift by period, for periodic needles.*/
+} Kstr_Needle;
+
+Kstr_Needle kstr_needle_new(Kstr needle);
+bool kstr_find_needle(Kstr k, const Kstr_Needle* needle, size_t* pos);
+bool kstr_find(Kstr k, Kstr needle, size_t* pos);
+Kstr kstr_token_needle(Kstr* k, const Kstr_Needle* needle);
+
+/**
+ * Defines the instruction sets used by the Kstr scanning functions.
+ * @see kstr_simd_level()
+ * @see kstr_set_simd_level()
+ */
+typedef enum Kstr_Simd_Level {
+    KSTR_SIMD_SCALAR = 0,
+    KSTR_SIMD_SSE2,
+    KSTR_SIMD_AVX2,
+    KSTR_SIMD_AVX512,
+} Kstr_Simd_Level;
+
+Kstr_Simd_Level kstr_simd_level(void);
+void kstr_set_simd_level(Kstr_Simd_Level max_level);
+
+/**
+ * Represents a lazy split of a Kstr on a delimiter char.
+ * Delimiters are found 64 bytes at a time and kept as a bitmask, so each step only pops the next bit.
+ * @see kstr_split_iter()
+ * @see kstr_split_next()
+ */
+typedef struct Kstr_Split_Iter {
+    Kstr k; /**< The Kstr being split.*/
+    size_t pos; /**< Start of the next token.*/
+    size_t block; /**< Start of the 64 bytes block covered by mask.*/
+    uint64_t mask; /**< Pending delimiter positions in the current block.*/
+    char delim; /**< The delimiter char.*/
+    Kstr_Simd_Level level; /**< The Kstr_Simd_Level used for the scan.*/
+} Kstr_Split_Iter;
+
+size_t kstr_count(Kstr k, char c);
+Kstr_Split_Iter kstr_split_iter(Kstr k, char delim);
+bool kstr_split_next(Kstr_Split_Iter* it, Kstr* part);
+Kstr* kstr_split_all(Koliseo* kls, Kstr k, char delim, size_t* count);
+
+/**
+ * Represents an index of line start offsets over a Kstr, for random access to its lines.
+ * Lines are the tokens yielded by kstr_token() on '\n', so a trailing newline does not start a new line.
+ * Only one every stride line starts is stored, trading lookup time for memory.
+ * @see kstr_line_index_new()
+ */
+typedef struct Kstr_Line_Index {
+    Kstr k; /**< The indexed Kstr.*/
+    size_t lines; /**< Number of lines in k.*/
+    size_t stride; /**< Distance in lines between stored offsets.*/
+    size_t count; /**< Number of stored offsets, not counting the final sentinel.*/
+    size_t* offsets; /**< Start offsets of lines 0, stride, 2*stride, ..., followed by k.len.*/
+} Kstr_Line_Index;
+
+Kstr_Line_Index* kstr_line_index_new(Koliseo* kls, Kstr k, size_t stride);
+bool kstr_line_at(const Kstr_Line_Index* idx, size_t line, Kstr* res);
+bool kstr_line_range(const Kstr_Line_Index* idx, size_t first, size_t count, Kstr* res);
+size_t kstr_line_of(const Kstr_Line_Index* idx, size_t offset);
+
+/**
+ * Represents an interned string, stored once in a Koliseo with its length and hash.
+ * Handles from the same Kstr_Intern_Pool are equal if and only if their pointers are equal.
+ * @see kstr_intern()
+ */
+typedef struct Kstr_Interned {
+    uint64_t hash; /**< kstr_hash() of the string.*/
+    size_t len; /**< Length of the string.*/
+    char data[]; /**< The string, with a terminating null char.*/
+} Kstr_Interned;
+
+/**
+ * Represents a set of interned strings, all stored in a Koliseo.
+ * @see kstr_intern_pool_new()
+ * @see kstr_intern()
+ */
+typedef struct Kstr_Intern_Pool {
+    Koliseo* kls; /**< The Koliseo holding strings and slots.*/
+    struct Kstr_Intern_Slot* slots; /**< Open addressing table, sized to a power of two.*/
+    size_t cap; /**< Number of slots.*/
+    size_t count; /**< Number of interned strings.*/
+} Kstr_Intern_Pool;
+
+uint64_t kstr_hash(Kstr k);
+Kstr_Intern_Pool* kstr_intern_pool_new(Koliseo* kls, size_t cap);
+const Kstr_Interned* kstr_intern(Kstr_Intern_Pool* pool, Kstr k);
+const Kstr_Interned* kstr_intern_lookup(const Kstr_Intern_Pool* pool, Kstr k);
+Kstr kstr_from_interned(const Kstr_Interned* interned);
+
+#ifndef KSTR_PHF_BUCKET_SIZE
+#define KSTR_PHF_BUCKET_SIZE 4 /**< Average number of keys per bucket of a Kstr_Phf.*/
+#endif // KSTR_PHF_BUCKET_SIZE
+
+#ifndef KSTR_PHF_MAX_SEEDS
+#define KSTR_PHF_MAX_SEEDS 16 /**< Number of seeds kstr_phf_new() tries before giving up.*/
+#endif // KSTR_PHF_MAX_SEEDS
+
+#ifndef KSTR_PHF_MAX_PILOT
+#define KSTR_PHF_MAX_PILOT (1u << 20) /**< Number of pilots kstr_phf_new() tries for a bucket before changing seed.*/
+#endif // KSTR_PHF_MAX_PILOT
+
+#define KSTR_PHF_FORMAT 1 /**< Version of the layout written by kstr_phf_serialize().*/
+
+/**
+ * Represents a minimal perfect hash table over a fixed set of distinct keys.
+ * Each key gets an id from 0 to count - 1, found with a single probe: index your values by it.
+ * Keys go in buckets, and each bucket has a pilot picking the hash that places its keys on free positions.
+ * Positions past count are mapped back to the ids left free by remap.
+ * The arrays can point into a blob made by kstr_phf_serialize(), so that a saved table is loaded without rebuilding.
+ * @see kstr_phf_new()
+ * @see kstr_phf_lookup()
+ * @see kstr_phf_load()
+ */
+typedef struct Kstr_Phf {
+    uint64_t seed; /**< Seed mixed in the key hashes.*/
+    uint32_t count; /**< Number of keys.*/
+    uint32_t bucket_count; /**< Number of buckets.*/
+    uint32_t table_size; /**< Number of positions, slightly more than count.*/
+    const uint32_t* pilots; /**< Pilot of each bucket.*/
+    const uint32_t* remap; /**< Id of each position from count to table_size - 1.*/
+    const uint32_t* key_offs; /**< Offset in keys of each key by id, followed by the total length.*/
+    const char* keys; /**< The keys by id, without separators.*/
+} Kstr_Phf;
+
+Kstr_Phf* kstr_phf_new(Koliseo* kls, const Kstr* keys, size_t count);
+ptrdiff_t kstr_phf_lookup(const Kstr_Phf* phf, Kstr k);
+Kstr kstr_phf_key(const Kstr_Phf* phf, uint32_t id);
+Kstr kstr_phf_serialize(Koliseo* kls, const Kstr_Phf* phf);
+bool kstr_phf_save(const Kstr_Phf* phf, FILE* fp);
+Kstr_Phf* kstr_phf_load(Koliseo* kls, Kstr blob);
+bool kls_strbuf_append_kstr(Kls_StrBuf* sb, Kstr k);
+Kstr kls_strbuf_finish_kstr(Kls_StrBuf* sb);
+
 #define KSTR(c_lit) kstr_new(c_lit, sizeof(c_lit) - 1)
 #define KSTR_NULL kstr_new(NULL, 0)
 
@@ -81,6 +226,8 @@ typedef enum Gulp_Res {
     GULP_FILE_READ_ERROR,
     GULP_FILE_CONTAINS_NULLCHAR,
     GULP_FILE_KLS_NULL,
+    GULP_FILE_KLS_HAS_TEMP,
+    GULP_FILE_KLS_PUSH_FAILED,
     TOT_GULP_RES
 } Gulp_Res;
 
@@ -108,11 +255,151 @@ char * try_kls_gulp_file(Koliseo* kls, const char * filepath, size_t max_size);
 Kstr * kls_gulp_file_sized_to_kstr(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size, bool allow_nullchar);
 Kstr * try_kls_gulp_file_to_kstr(Koliseo* kls, const char * filepath, size_t max_size, bool allow_nullchar);
 #define KLS_GULP_FILE_KSTR(kls, filepath) try_kls_gulp_file_to_kstr((kls),(filepath), GULP_MAX_FILE_SIZE, false)
+Kstr * kls_gulp_file_mmap(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size);
+Kstr * try_kls_gulp_file_mmap(Koliseo* kls, const char * filepath, size_t max_size);
+#define KLS_GULP_FILE_MMAP(kls, filepath) try_kls_gulp_file_mmap((kls),(filepath), GULP_MAX_FILE_SIZE)
+
+/**
+ * Defines default chunk size for a Kls_Gulp_Stream.
+ * @see kls_gulp_stream_start()
+ */
+#define KLS_GULP_STREAM_CHUNK_SIZE (64*1024)
+
+/**
+ * Represents a streaming reader over a file descriptor, handing out Kstr records split by a delimiter.
+ * Reads fixed-size chunks into a buffer pushed once on the Koliseo, so that memory stays bounded.
+ * Records crossing a chunk boundary are stitched in a Koliseo_Temp, which is rewound when a new chunk is read.
+ * @see kls_gulp_stream_start()
+ * @see kls_gulp_stream_next()
+ * @see kls_gulp_stream_end()
+ */
+typedef struct Kls_Gulp_Stream {
+    int fd; /**< The file descriptor to read from. Not closed by kls_gulp_stream_end().*/
+    char delim; /**< The record delimiter.*/
+    char* buf; /**< The chunk buffer.*/
+    size_t cap; /**< Size of the chunk buffer.*/
+    size_t pos; /**< Position of the first unread byte in buf.*/
+    size_t len; /**< Number of valid bytes in buf.*/
+    bool eof; /**< Set once the file descriptor reported end of file.*/
+    Gulp_Res err; /**< Result of the last read.*/
+    Koliseo_Temp* t_kls; /**< Holds stitched records.*/
+    char* stitch; /**< Current stitched record, in t_kls.*/
+    size_t stitch_len; /**< Length of the stitched record.*/
+    size_t stitch_cap; /**< Capacity of the stitched record.*/
+} Kls_Gulp_Stream;
+
+Gulp_Res kls_gulp_stream_start(Kls_Gulp_Stream* stream, Koliseo* kls, int fd, size_t chunk_size, char delim);
+bool kls_gulp_stream_next(Kls_Gulp_Stream* stream, Kstr* record);
+void kls_gulp_stream_end(Kls_Gulp_Stream* stream);
+
+/**
+ * Defines the starting size for each worker Koliseo of kls_gulp_files(). Worker Koliseo are growable.
+ * @see kls_gulp_files()
+ */
+#define KLS_GULP_BATCH_ARENA_SIZE (1024*1024)
+
+/**
+ * Represents the results of a kls_gulp_files() call.
+ * Contents are held by per-worker Koliseo, which are freed when the Koliseo passed to kls_gulp_files() is freed or cleared.
+ * @see kls_gulp_files()
+ */
+typedef struct Kls_Gulp_Batch {
+    size_t count; /**< Number of gulped paths.*/
+    Kstr* files; /**< Contents of each path, or KSTR_NULL on failure.*/
+    Gulp_Res* results; /**< Gulp_Res of each path.*/
+    int workers; /**< Number of workers used.*/
+    Koliseo** arenas; /**< Koliseo of each worker, holding the contents. Allocated outside of the passed Koliseo.*/
+} Kls_Gulp_Batch;
+
+Kls_Gulp_Batch* kls_gulp_files(Koliseo* kls, const char** paths, size_t count, int workers, size_t max_size, bool allow_nullchar);
+
+/**
+ * Defines the I/O backends for a Kls_Gulp_Async.
+ * @see kls_gulp_async_start()
+ */
+typedef enum Kls_Gulp_Async_Backend {
+    KLS_GULP_ASYNC_AUTO = 0, /**< Use io_uring when available, a pread() thread pool otherwise.*/
+    KLS_GULP_ASYNC_URING, /**< Use io_uring, falling back to the thread pool when it is not available.*/
+    KLS_GULP_ASYNC_THREADS, /**< Use a pread() thread pool.*/
+} Kls_Gulp_Async_Backend;
+
+/**
+ * Defines the default number of reads in flight for a Kls_Gulp_Async.
+ * @see kls_gulp_async_start()
+ */
+#define KLS_GULP_ASYNC_DEPTH 32
+
+/**
+ * Defines the max number of threads for the pread() fallback of a Kls_Gulp_Async.
+ */
+#define KLS_GULP_ASYNC_MAX_THREADS 8
+
+/**
+ * Represents a finished read of a Kls_Gulp_Async.
+ * @see kls_gulp_async_next()
+ */
+typedef struct Kls_Gulp_Completion {
+    size_t id; /**< Id set by kls_gulp_async_submit().*/
+    const char* path; /**< The submitted path.*/
+    Kstr data; /**< The file contents, or KSTR_NULL on failure.*/
+    Gulp_Res res; /**< Result of the read.*/
+} Kls_Gulp_Completion;
+
+/**
+ * Represents a queue of asynchronous file gulps, whose buffers are pushed on a Koliseo.
+ * Paths are sized and their buffers pushed at submit time, from the calling thread, so the Koliseo is never touched by the backend.
+ * @see kls_gulp_async_start()
+ * @see kls_gulp_async_submit()
+ * @see kls_gulp_async_next()
+ * @see kls_gulp_async_end()
+ */
+typedef struct Kls_Gulp_Async {
+    Koliseo* kls; /**< The Koliseo holding the file buffers.*/
+    Kls_Gulp_Async_Backend backend; /**< The backend in use, never KLS_GULP_ASYNC_AUTO.*/
+    size_t max_size; /**< Max size allowed for each read file.*/
+    bool allow_nullchar; /**< Keep the contents of binary files.*/
+    unsigned depth; /**< Max number of reads in flight.*/
+    struct Kls_Gulp_Async_Req* reqs; /**< Submitted requests.*/
+    size_t count; /**< Number of submitted requests.*/
+    size_t cap; /**< Capacity of reqs.*/
+    size_t issued; /**< Number of requests handed to the backend.*/
+    size_t delivered; /**< Number of completions returned by kls_gulp_async_next().*/
+    size_t inflight; /**< Number of reads in flight.*/
+    size_t done_head; /**< First finished request not yet delivered, or SIZE_MAX.*/
+    size_t done_tail; /**< Last finished request not yet delivered, or SIZE_MAX.*/
+    void* backend_data; /**< State of the backend.*/
+} Kls_Gulp_Async;
+
+Gulp_Res kls_gulp_async_start(Kls_Gulp_Async* as, Koliseo* kls, Kls_Gulp_Async_Backend backend, unsigned depth, size_t max_size, bool allow_nullchar);
+bool kls_gulp_async_submit(Kls_Gulp_Async* as, const char* path, size_t* id);
+bool kls_gulp_async_next(Kls_Gulp_Async* as, Kls_Gulp_Completion* completion);
+void kls_gulp_async_end(Kls_Gulp_Async* as);
 
 #endif // KLS_GULP_H_
 
 #ifdef KLS_GULP_IMPLEMENTATION
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+// syscall() needs _DEFAULT_SOURCE or _GNU_SOURCE, set by koliseo.h when included before the system headers
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__)) && !defined(KLS_GULP_NO_URING) && defined(__has_include) && (defined(_DEFAULT_SOURCE) || defined(_GNU_SOURCE))
+#if __has_include(<linux/io_uring.h>)
+#define KLS_GULP_HAS_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#endif
+#else
+#include <io.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
 /**
  * Contains the constant string representation of Gulp_Res values.
  * @see Gulp_Res
@@ -124,6 +411,8 @@ const char* gulp_res_names[TOT_GULP_RES+1] = {
     [GULP_FILE_READ_ERROR] = "File could not be read",
     [GULP_FILE_CONTAINS_NULLCHAR] = "File contains nullchar",
     [GULP_FILE_KLS_NULL] = "Koliseo was NULL",
+    [GULP_FILE_KLS_HAS_TEMP] = "Koliseo has an active Koliseo_Temp",
+    [GULP_FILE_KLS_PUSH_FAILED] = "Failed pushing to Koliseo",
     [TOT_GULP_RES] = "Total of Gulp_Res values",
 };
 
@@ -140,6 +429,387 @@ const char* string_from_Gulp_Res(Gulp_Res g)
     return gulp_res_names[g];
 }
 
+/*
+ * SIMD scanning for Kstr.
+ * On x86 with GCC or Clang, each primitive has SSE2, AVX2 and AVX-512BW variants, picked at runtime by kstr__level().
+ * Define KLS_GULP_NO_SIMD to only build the scalar variants.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(KLS_GULP_NO_SIMD)
+#define KLS_GULP_HAS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+static Kstr_Simd_Level kstr__max_level = KSTR_SIMD_AVX512;
+
+/**
+ * Returns the best Kstr_Simd_Level supported by the running CPU.
+ * @see Kstr_Simd_Level
+ * @return The detected Kstr_Simd_Level.
+ */
+Kstr_Simd_Level kstr_simd_level(void)
+{
+#ifdef KLS_GULP_HAS_X86_SIMD
+    if (__builtin_cpu_supports("avx512bw")) {
+        return KSTR_SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return KSTR_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return KSTR_SIMD_SSE2;
+    }
+#endif // KLS_GULP_HAS_X86_SIMD
+    return KSTR_SIMD_SCALAR;
+}
+
+/**
+ * Caps the Kstr_Simd_Level used by the Kstr scanning functions. Useful for benchmarks and tests.
+ * Levels not supported by the running CPU are never used, whatever the cap.
+ * @see Kstr_Simd_Level
+ * @param max_level The highest Kstr_Simd_Level to use.
+ */
+void kstr_set_simd_level(Kstr_Simd_Level max_level)
+{
+    kstr__max_level = max_level;
+}
+
+static inline Kstr_Simd_Level kstr__level(void)
+{
+    Kstr_Simd_Level detected = kstr_simd_level();
+    return (detected < kstr__max_level ? detected : kstr__max_level);
+}
+
+static size_t kstr__find_byte_scalar(const char* p, size_t len, char c)
+{
+    size_t i = 0;
+    while (i < len && p[i] != c) {
+        i++;
+    }
+    return i;
+}
+
+static bool kstr__eq_scalar(const char* l, const char* r, size_t len)
+{
+    for (size_t i=0; i < len; i++) {
+        if (l[i] != r[i]) return false;
+    }
+    return true;
+}
+
+static inline char kstr__fold(char c)
+{
+    return ('A' <= c && 'Z' >= c) ? c + 32 : c;
+}
+
+static bool kstr__eq_ignorecase_scalar(const char* l, const char* r, size_t len)
+{
+    for (size_t i=0; i < len; i++) {
+        if (kstr__fold(l[i]) != kstr__fold(r[i])) return false;
+    }
+    return true;
+}
+
+#ifdef KLS_GULP_HAS_X86_SIMD
+__attribute__((target("sse2")))
+static size_t kstr__find_byte_sse2(const char* p, size_t len, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(p + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + kstr__find_byte_scalar(p + i, len - i, c);
+}
+
+__attribute__((target("sse2")))
+static inline __m128i kstr__fold_sse2(__m128i x)
+{
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), x));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("sse2")))
+static bool kstr__eq_sse2(const char* l, const char* r, size_t len, bool ignorecase)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(l + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(r + i));
+        if (ignorecase) {
+            a = kstr__fold_sse2(a);
+            b = kstr__fold_sse2(b);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF) {
+            return false;
+        }
+    }
+    return (ignorecase ? kstr__eq_ignorecase_scalar(l + i, r + i, len - i) : kstr__eq_scalar(l + i, r + i, len - i));
+}
+
+__attribute__((target("avx2")))
+static size_t kstr__find_byte_avx2(const char* p, size_t len, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(p + i));
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + kstr__find_byte_sse2(p + i, len - i, c);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i kstr__fold_avx2(__m256i x)
+{
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), x));
+    return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+static bool kstr__eq_avx2(const char* l, const char* r, size_t len, bool ignorecase)
+{
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(l + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(r + i));
+        if (ignorecase) {
+            a = kstr__fold_avx2(a);
+            b = kstr__fold_avx2(b);
+        }
+        if ((unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return kstr__eq_sse2(l + i, r + i, len - i, ignorecase);
+}
+
+__attribute__((target("avx512bw")))
+static size_t kstr__find_byte_avx512(const char* p, size_t len, char c)
+{
+    const __m512i needle = _mm512_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i chunk = _mm512_loadu_si512((const void*)(p + i));
+        __mmask64 mask = _mm512_cmpeq_epi8_mask(chunk, needle);
+        if (mask != 0) {
+            return i + __builtin_ctzll(mask);
+        }
+    }
+    return i + kstr__find_byte_avx2(p + i, len - i, c);
+}
+
+__attribute__((target("avx512bw")))
+static inline __m512i kstr__fold_avx512(__m512i x)
+{
+    __mmask64 upper = _mm512_cmpgt_epi8_mask(x, _mm512_set1_epi8('A' - 1)) & _mm512_cmplt_epi8_mask(x, _mm512_set1_epi8('Z' + 1));
+    return _mm512_mask_blend_epi8(upper, x, _mm512_or_si512(x, _mm512_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx512bw")))
+static bool kstr__eq_avx512(const char* l, const char* r, size_t len, bool ignorecase)
+{
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i a = _mm512_loadu_si512((const void*)(l + i));
+        __m512i b = _mm512_loadu_si512((const void*)(r + i));
+        if (ignorecase) {
+            a = kstr__fold_avx512(a);
+            b = kstr__fold_avx512(b);
+        }
+        if (_mm512_cmpneq_epi8_mask(a, b) != 0) {
+            return false;
+        }
+    }
+    return kstr__eq_avx2(l + i, r + i, len - i, ignorecase);
+}
+#endif // KLS_GULP_HAS_X86_SIMD
+
+/**
+ * Returns the index of the first occurrence of the passed char in the passed buffer, or len if it is not present.
+ * Dispatches to the best available Kstr_Simd_Level.
+ */
+static size_t kstr__find_byte(const char* p, size_t len, char c)
+{
+#ifdef KLS_GULP_HAS_X86_SIMD
+    if (len >= 16) {
+        switch (kstr__level()) {
+        case KSTR_SIMD_AVX512:
+            return kstr__find_byte_avx512(p, len, c);
+        case KSTR_SIMD_AVX2:
+            return kstr__find_byte_avx2(p, len, c);
+        case KSTR_SIMD_SSE2:
+            return kstr__find_byte_sse2(p, len, c);
+        default:
+            break;
+        }
+    }
+#endif // KLS_GULP_HAS_X86_SIMD
+    return kstr__find_byte_scalar(p, len, c);
+}
+
+/**
+ * Checks if the two passed buffers of len bytes are equal, optionally ignoring ASCII case.
+ * Dispatches to the best available Kstr_Simd_Level.
+ */
+static bool kstr__eq(const char* l, const char* r, size_t len, bool ignorecase)
+{
+#ifdef KLS_GULP_HAS_X86_SIMD
+    if (len >= 16) {
+        switch (kstr__level()) {
+        case KSTR_SIMD_AVX512:
+            return kstr__eq_avx512(l, r, len, ignorecase);
+        case KSTR_SIMD_AVX2:
+            return kstr__eq_avx2(l, r, len, ignorecase);
+        case KSTR_SIMD_SSE2:
+            return kstr__eq_sse2(l, r, len, ignorecase);
+        default:
+            break;
+        }
+    }
+#endif // KLS_GULP_HAS_X86_SIMD
+    return (ignorecase ? kstr__eq_ignorecase_scalar(l, r, len) : kstr__eq_scalar(l, r, len));
+}
+
+static uint64_t kstr__mask64_scalar(const char* p, size_t len, char c)
+{
+    uint64_t mask = 0;
+    for (size_t i = 0; i < len; i++) {
+        mask |= (uint64_t)(p[i] == c) << i;
+    }
+    return mask;
+}
+
+static size_t kstr__count_byte_scalar(const char* p, size_t len, char c)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        count += (p[i] == c);
+    }
+    return count;
+}
+
+#ifdef KLS_GULP_HAS_X86_SIMD
+__attribute__((target("sse2")))
+static uint64_t kstr__mask64_sse2(const char* p, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(p + 16 * i));
+        mask |= (uint64_t)(uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)) << (16 * i);
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+static uint64_t kstr__mask64_avx2(const char* p, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    uint32_t lo = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) p), needle));
+    uint32_t hi = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + 32)), needle));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+__attribute__((target("avx512bw")))
+static uint64_t kstr__mask64_avx512(const char* p, char c)
+{
+    return _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*) p), _mm512_set1_epi8(c));
+}
+
+// No popcnt here: SSE2 is the x86-64 baseline, POPCNT is not.
+__attribute__((target("sse2")))
+static size_t kstr__count_byte_sse2(const char* p, size_t len, char c)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        count += __builtin_popcountll(kstr__mask64_sse2(p + i, c));
+    }
+    return count + kstr__count_byte_scalar(p + i, len - i, c);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t kstr__count_byte_avx2(const char* p, size_t len, char c)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        count += __builtin_popcountll(kstr__mask64_avx2(p + i, c));
+    }
+    return count + kstr__count_byte_scalar(p + i, len - i, c);
+}
+
+__attribute__((target("avx512bw,popcnt")))
+static size_t kstr__count_byte_avx512(const char* p, size_t len, char c)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        count += __builtin_popcountll(kstr__mask64_avx512(p + i, c));
+    }
+    return count + kstr__count_byte_scalar(p + i, len - i, c);
+}
+#endif // KLS_GULP_HAS_X86_SIMD
+
+/**
+ * Returns a bitmask of the positions of the passed char in the passed buffer of at most 64 bytes.
+ * Dispatches to the passed Kstr_Simd_Level for full blocks.
+ */
+static uint64_t kstr__mask64(const char* p, size_t len, char c, Kstr_Simd_Level level)
+{
+#ifdef KLS_GULP_HAS_X86_SIMD
+    if (len == 64) {
+        switch (level) {
+        case KSTR_SIMD_AVX512:
+            return kstr__mask64_avx512(p, c);
+        case KSTR_SIMD_AVX2:
+            return kstr__mask64_avx2(p, c);
+        case KSTR_SIMD_SSE2:
+            return kstr__mask64_sse2(p, c);
+        default:
+            break;
+        }
+    }
+#else
+    (void) level;
+#endif // KLS_GULP_HAS_X86_SIMD
+    return kstr__mask64_scalar(p, len, c);
+}
+
+/**
+ * Returns the number of occurrences of the passed char in the passed buffer.
+ * Dispatches to the best available Kstr_Simd_Level.
+ */
+static size_t kstr__count_byte(const char* p, size_t len, char c)
+{
+#ifdef KLS_GULP_HAS_X86_SIMD
+    if (len >= 64) {
+        Kstr_Simd_Level level = kstr__level();
+        if (level > KSTR_SIMD_SSE2 && !__builtin_cpu_supports("popcnt")) {
+            level = KSTR_SIMD_SSE2;
+        }
+        switch (level) {
+        case KSTR_SIMD_AVX512:
+            return kstr__count_byte_avx512(p, len, c);
+        case KSTR_SIMD_AVX2:
+            return kstr__count_byte_avx2(p, len, c);
+        case KSTR_SIMD_SSE2:
+            return kstr__count_byte_sse2(p, len, c);
+        default:
+            break;
+        }
+    }
+#endif // KLS_GULP_HAS_X86_SIMD
+    return kstr__count_byte_scalar(p, len, c);
+}
+
 /**
  * Returns a new Kstr with the passed args set.
  * @see Kstr
@@ -179,10 +849,7 @@ bool kstr_eq(Kstr left, Kstr right)
         return false;
     }
 
-    for (size_t i=0; i < left.len; i++) {
-        if (left.data[i] != right.data[i]) return false;
-    }
-    return true;
+    return kstr__eq(left.data, right.data, left.len, false);
 }
 
 /**
@@ -198,17 +865,7 @@ bool kstr_eq_ignorecase(Kstr left, Kstr right)
         return false;
     }
 
-    char l, r;
-    for (size_t i=0; i < left.len; i++) {
-        l = 'A' <= left.data[i] && 'Z' >= left.data[i]
-            ? left.data[i] + 32
-            : left.data[i];
-        r = 'A' <= right.data[i] && 'Z' >= right.data[i]
-            ? right.data[i] + 32
-            : right.data[i];
-        if (l != r) return false;
-    }
-    return true;
+    return kstr__eq(left.data, right.data, left.len, true);
 }
 
 /**
@@ -304,14 +961,10 @@ bool kstr_indexof(Kstr k, char c, int* idx)
     if (k.len == 0) {
         return false;
     } else {
-        size_t i = 0;
-        while (i < k.len) {
-            if (k.data[i] == c) {
-                *idx = i;
-                return true;
-            }
-
-            i++;
+        size_t i = kstr__find_byte(k.data, k.len, c);
+        if (i < k.len) {
+            *idx = i;
+            return true;
         }
         return false;
     }
@@ -327,10 +980,7 @@ bool kstr_indexof(Kstr k, char c, int* idx)
  */
 bool kstr_try_token(Kstr *k, char delim, Kstr* part)
 {
-    size_t i = 0;
-    while (i < k->len && k->data[i] != delim) {
-        i++;
-    }
+    size_t i = kstr__find_byte(k->data, k->len, delim);
 
     Kstr res = kstr_new(k->data,i);
 
@@ -355,10 +1005,7 @@ bool kstr_try_token(Kstr *k, char delim, Kstr* part)
  */
 Kstr kstr_token(Kstr *k, char delim)
 {
-    size_t i = 0;
-    while (i < k->len && k->data[i] != delim) {
-        i++;
-    }
+    size_t i = kstr__find_byte(k->data, k->len, delim);
 
     Kstr res = kstr_new(k->data,i);
 
@@ -373,60 +1020,1282 @@ Kstr kstr_token(Kstr *k, char delim)
     return res;
 }
 
-Kstr kstr_token_kstr(Kstr* k, Kstr delim)
+/**
+ * Precompiles the passed Kstr for substring search, computing its critical factorization for the Two-Way algorithm.
+ * @see Kstr_Needle
+ * @param needle The Kstr to search for. Its data must outlive the returned Kstr_Needle.
+ * @return The resulting Kstr_Needle.
+ */
+Kstr_Needle kstr_needle_new(Kstr needle)
 {
-
-    //Kstr to scroll k data, sized as the delimiter
-    Kstr win = kstr_new(k->data, delim.len);
-
-    size_t i = 0;
-
-    //Loop checking if k data can still be scrolled and if current window is equal to the delimiter
-    while (i + delim.len < k->len &&
-           !(kstr_eq(win, delim))) {
-        i++;
-        win.data++;
+    const unsigned char* n = (const unsigned char*) needle.data;
+    size_t l = needle.len;
+    Kstr_Needle res = {
+        .needle = needle,
+        .ms = (size_t)-1,
+        .period = 1,
+        .mem0 = 0,
+    };
+    if (l < 2) {
+        return res;
     }
-
-    //New Kstr just up to the delimiter position
-    Kstr res = kstr_new(k->data, i);
-
-    //If we don't cleanly empty k, we increase result len so that it holds the remaining chars
-    if (i + delim.len == k->len) {
-        res.len += delim.len;
+    // Maximal suffix, for both orderings
+    size_t ms = 0, p0 = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        size_t ip = (size_t)-1, jp = 0, k = 1, p = 1;
+        while (jp + k < l) {
+            unsigned char a = n[ip + k];
+            unsigned char b = n[jp + k];
+            if (a == b) {
+                if (k == p) {
+                    jp += p;
+                    k = 1;
+                } else {
+                    k++;
+                }
+            } else if (pass == 0 ? a > b : a < b) {
+                jp += k;
+                k = 1;
+                p = jp - ip;
+            } else {
+                ip = jp++;
+                k = p = 1;
+            }
+        }
+        if (pass == 0) {
+            ms = ip;
+            p0 = p;
+        } else if (ip + 1 > ms + 1) {
+            ms = ip;
+            p0 = p;
+        }
+    }
+    res.ms = ms;
+    if (memcmp(n, n + p0, ms + 1) != 0) {
+        res.period = (ms > l - ms - 1 ? ms : l - ms - 1) + 1;
+        res.mem0 = 0;
+    } else {
+        res.period = p0;
+        res.mem0 = l - p0;
     }
-
-    //Advance k by the delimiter size, plus its starting position
-    k->data += i + delim.len;
-    k->len += i + delim.len;
-
     return res;
 }
 
-static char * kls_read_file(Koliseo* kls, const char * f_name, Gulp_Res * err, size_t * f_size, ...)
+/**
+ * Two-Way search of the passed Kstr_Needle, with length of at least 2, in the passed buffer.
+ * Runs in linear time and constant space.
+ * @return The position of the first match, or len if there is none.
+ */
+static size_t kstr__twoway(const char* hay, size_t len, const Kstr_Needle* needle)
 {
-    if (!kls) {
-        *err = GULP_FILE_KLS_NULL;
-        return NULL;
+    const unsigned char* h = (const unsigned char*) hay;
+    const unsigned char* n = (const unsigned char*) needle->needle.data;
+    const size_t l = needle->needle.len;
+    const size_t ms = needle->ms;
+    size_t pos = 0;
+    size_t mem = 0;
+    while (len - pos >= l) {
+        // Compare right half
+        size_t k = (ms + 1 > mem ? ms + 1 : mem);
+        while (k < l && n[k] == h[pos + k]) {
+            k++;
+        }
+        if (k < l) {
+            pos += k - ms;
+            mem = 0;
+            continue;
+        }
+        // Compare left half
+        k = ms + 1;
+        while (k > mem && n[k - 1] == h[pos + k - 1]) {
+            k--;
+        }
+        if (k <= mem) {
+            return pos;
+        }
+        pos += needle->period;
+        mem = needle->mem0;
     }
-    char * buffer;
-    size_t length = 0;
-    FILE * f = fopen(f_name, "rb");
-    size_t read_length;
-
-    if (f) {
-        fseek(f, 0, SEEK_END);
-        length = ftell(f);
-        fseek(f, 0, SEEK_SET);
+    return len;
+}
+
+#ifdef KLS_GULP_HAS_X86_SIMD
+/*
+ * First/last byte filters: candidates are the positions where both the first and the last needle byte match, verified with memcmp().
+ * When too many candidates fail verification, the rest of the buffer is searched with kstr__twoway(), to keep the linear bound.
+ */
+#define KSTR__FILTER_FAILS(fails, scanned) ((fails) > 64 && (fails) > (scanned) / 32)
+
+__attribute__((target("sse2")))
+static size_t kstr__find_sse2(const char* h, size_t len, const Kstr_Needle* needle)
+{
+    const char* n = needle->needle.data;
+    const size_t l = needle->needle.len;
+    const __m128i first = _mm_set1_epi8(n[0]);
+    const __m128i last = _mm_set1_epi8(n[l - 1]);
+    size_t fails = 0;
+    size_t i = 0;
+    for (; i + l - 1 + 16 <= len; i += 16) {
+        __m128i bf = _mm_loadu_si128((const __m128i*)(h + i));
+        __m128i bl = _mm_loadu_si128((const __m128i*)(h + i + l - 1));
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last)));
+        while (mask != 0) {
+            size_t at = i + __builtin_ctz(mask);
+            if (memcmp(h + at + 1, n + 1, l - 2) == 0) {
+                return at;
+            }
+            fails++;
+            mask &= mask - 1;
+        }
+        if (KSTR__FILTER_FAILS(fails, i)) {
+            break;
+        }
+    }
+    return i + kstr__twoway(h + i, len - i, needle);
+}
+
+__attribute__((target("avx2")))
+static size_t kstr__find_avx2(const char* h, size_t len, const Kstr_Needle* needle)
+{
+    const char* n = needle->needle.data;
+    const size_t l = needle->needle.len;
+    const __m256i first = _mm256_set1_epi8(n[0]);
+    const __m256i last = _mm256_set1_epi8(n[l - 1]);
+    size_t fails = 0;
+    size_t i = 0;
+    for (; i + l - 1 + 32 <= len; i += 32) {
+        __m256i bf = _mm256_loadu_si256((const __m256i*)(h + i));
+        __m256i bl = _mm256_loadu_si256((const __m256i*)(h + i + l - 1));
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, last)));
+        while (mask != 0) {
+            size_t at = i + __builtin_ctz(mask);
+            if (memcmp(h + at + 1, n + 1, l - 2) == 0) {
+                return at;
+            }
+            fails++;
+            mask &= mask - 1;
+        }
+        if (KSTR__FILTER_FAILS(fails, i)) {
+            break;
+        }
+    }
+    return i + kstr__twoway(h + i, len - i, needle);
+}
+#endif // KLS_GULP_HAS_X86_SIMD
+
+/**
+ * Looks for the passed Kstr_Needle in the passed Kstr.
+ * Uses a SIMD first/last byte filter when available, and the Two-Way algorithm otherwise, so it never goes quadratic.
+ * @see Kstr_Needle
+ * @param k The Kstr to scan.
+ * @param needle The Kstr_Needle to look for.
+ * @param pos Pointer to store the position of the first match into. Can be NULL.
+ * @return true if the needle was found, false otherwise.
+ */
+bool kstr_find_needle(Kstr k, const Kstr_Needle* needle, size_t* pos)
+{
+    assert(needle != NULL);
+    const size_t l = needle->needle.len;
+    size_t res = k.len;
+    if (l == 0) {
+        res = 0;
+    } else if (l > k.len) {
+        return false;
+    } else if (l == 1) {
+        res = kstr__find_byte(k.data, k.len, needle->needle.data[0]);
+    } else {
+#ifdef KLS_GULP_HAS_X86_SIMD
+        switch (kstr__level()) {
+        case KSTR_SIMD_AVX512:
+        case KSTR_SIMD_AVX2:
+            res = kstr__find_avx2(k.data, k.len, needle);
+            break;
+        case KSTR_SIMD_SSE2:
+            res = kstr__find_sse2(k.data, k.len, needle);
+            break;
+        default:
+            res = kstr__twoway(k.data, k.len, needle);
+            break;
+        }
+#else
+        res = kstr__twoway(k.data, k.len, needle);
+#endif // KLS_GULP_HAS_X86_SIMD
+    }
+    if (res >= k.len && l > 0) {
+        return false;
+    }
+    if (pos) {
+        *pos = res;
+    }
+    return true;
+}
+
+/**
+ * Looks for the passed needle Kstr in the passed Kstr.
+ * Use kstr_find_needle() with a precompiled Kstr_Needle when searching for the same needle many times.
+ * @see kstr_find_needle()
+ * @param k The Kstr to scan.
+ * @param needle The Kstr to look for.
+ * @param pos Pointer to store the position of the first match into. Can be NULL.
+ * @return true if the needle was found, false otherwise.
+ */
+bool kstr_find(Kstr k, Kstr needle, size_t* pos)
+{
+    Kstr_Needle n = kstr_needle_new(needle);
+    return kstr_find_needle(k, &n, pos);
+}
+
+/**
+ * Scans the passed Kstr and cuts it up to the first occurrence of the passed Kstr_Needle, even if it is not present. Returns a new Kstr with the original data.
+ * @see kstr_token_kstr()
+ * @param k The Kstr to scan.
+ * @param needle The Kstr_Needle to look for.
+ * @return A new Kstr with the original data up to the delimiter, or all of it if the delimiter is not present.
+ */
+Kstr kstr_token_needle(Kstr* k, const Kstr_Needle* needle)
+{
+    size_t i = 0;
+    if (kstr_find_needle(*k, needle, &i)) {
+        Kstr res = kstr_new(k->data, i);
+        //Advance k by the delimiter size, plus its starting position
+        k->data += i + needle->needle.len;
+        k->len -= i + needle->needle.len;
+        return res;
+    }
+    Kstr res = *k;
+    k->data += k->len;
+    k->len = 0;
+    return res;
+}
+
+/**
+ * Scans the passed Kstr and cuts it up to the first occurrence of the passed delimiter Kstr, even if it is not present. Returns a new Kstr with the original data.
+ * @see kstr_token_needle()
+ * @param k The Kstr to scan.
+ * @param delim The Kstr to look for.
+ * @return A new Kstr with the original data up to the delimiter, or all of it if the delimiter is not present.
+ */
+Kstr kstr_token_kstr(Kstr* k, Kstr delim)
+{
+    Kstr_Needle needle = kstr_needle_new(delim);
+    return kstr_token_needle(k, &needle);
+}
+
+/**
+ * Returns the number of occurrences of the passed char in the passed Kstr.
+ * @param k The Kstr to scan.
+ * @param c The char to count.
+ * @return The number of occurrences.
+ */
+size_t kstr_count(Kstr k, char c)
+{
+    return kstr__count_byte(k.data, k.len, c);
+}
+
+/**
+ * Returns a new Kstr_Split_Iter over the passed Kstr.
+ * Calling kstr_split_next() on it yields the same tokens as calling kstr_token() until the Kstr is empty.
+ * @see kstr_split_next()
+ * @param k The Kstr to split. Its data must outlive the Kstr_Split_Iter.
+ * @param delim The delimiter char.
+ * @return The resulting Kstr_Split_Iter.
+ */
+Kstr_Split_Iter kstr_split_iter(Kstr k, char delim)
+{
+    Kstr_Split_Iter it = {
+        .k = k,
+        .pos = 0,
+        .block = 0,
+        .mask = 0,
+        .delim = delim,
+        .level = kstr__level(),
+    };
+    if (k.len > 0) {
+        it.mask = kstr__mask64(k.data, (k.len < 64 ? k.len : 64), delim, it.level);
+    }
+    return it;
+}
+
+/**
+ * Advances the passed Kstr_Split_Iter, setting the passed Kstr to the next token.
+ * @see kstr_split_iter()
+ * @param it The Kstr_Split_Iter to advance.
+ * @param part Pointer to the Kstr to set to the next token.
+ * @return true if a token was found, false when the Kstr was fully consumed.
+ */
+bool kstr_split_next(Kstr_Split_Iter* it, Kstr* part)
+{
+    assert(it != NULL);
+    assert(part != NULL);
+    if (it->pos >= it->k.len) {
+        return false;
+    }
+    while (it->mask == 0) {
+        it->block += 64;
+        if (it->block >= it->k.len) {
+            *part = kstr_new(it->k.data + it->pos, it->k.len - it->pos);
+            it->pos = it->k.len;
+            return true;
+        }
+        size_t left = it->k.len - it->block;
+        it->mask = kstr__mask64(it->k.data + it->block, (left < 64 ? left : 64), it->delim, it->level);
+    }
+    size_t at = it->block + __builtin_ctzll(it->mask);
+    it->mask &= it->mask - 1;
+    *part = kstr_new(it->k.data + it->pos, at - it->pos);
+    it->pos = at + 1;
+    return true;
+}
+
+/**
+ * Splits the passed Kstr on the passed delimiter, into a Kstr array pushed on the passed Koliseo and sized exactly.
+ * Yields the same tokens as calling kstr_token() until the Kstr is empty.
+ * @see kstr_split_iter()
+ * @param kls The Koliseo to push the array to.
+ * @param k The Kstr to split. The resulting Kstr point into its data.
+ * @param delim The delimiter char.
+ * @param count Pointer to store the number of tokens into.
+ * @return The pushed Kstr array, or NULL if there are no tokens or the push failed.
+ */
+Kstr* kstr_split_all(Koliseo* kls, Kstr k, char delim, size_t* count)
+{
+    assert(count != NULL);
+    *count = 0;
+    if (k.len == 0) {
+        return NULL;
+    }
+    size_t tot = kstr__count_byte(k.data, k.len, delim);
+    if (k.data[k.len - 1] != delim) {
+        // The last token has no trailing delimiter
+        tot++;
+    }
+    Kstr* res = KLS_PUSH_ARR(kls, Kstr, tot);
+    if (res == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing {%zu} Kstr.\n", __func__, tot);
+        return NULL;
+    }
+    Kstr_Split_Iter it = kstr_split_iter(k, delim);
+    size_t i = 0;
+    while (kstr_split_next(&it, &res[i])) {
+        i++;
+    }
+    assert(i == tot);
+    *count = tot;
+    return res;
+}
+
+/**
+ * Builds a Kstr_Line_Index over the passed Kstr, pushing it and its offsets on the passed Koliseo.
+ * Newlines are counted with SIMD first, so the offsets array is sized exactly.
+ * @see Kstr_Line_Index
+ * @param kls The Koliseo to push the index to.
+ * @param k The Kstr to index. Its data must outlive the index.
+ * @param stride Store one every stride line starts. 1 gives O(1) lookups; 0 is treated as 1.
+ * @return The pushed Kstr_Line_Index, or NULL if a push failed.
+ */
+Kstr_Line_Index* kstr_line_index_new(Koliseo* kls, Kstr k, size_t stride)
+{
+    if (stride == 0) {
+        stride = 1;
+    }
+    size_t lines = 0;
+    if (k.len > 0) {
+        lines = kstr__count_byte(k.data, k.len, '\n') + (k.data[k.len - 1] != '\n');
+    }
+    size_t count = (lines + stride - 1) / stride;
+    Kstr_Line_Index* idx = KLS_PUSH(kls, Kstr_Line_Index);
+    size_t* offsets = KLS_PUSH_ARR(kls, size_t, count + 1);
+    if (idx == NULL || offsets == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing index for {%zu} lines.\n", __func__, lines);
+        return NULL;
+    }
+    Kstr_Split_Iter it = kstr_split_iter(k, '\n');
+    Kstr part = KSTR_NULL;
+    size_t line = 0;
+    size_t i = 0;
+    while (kstr_split_next(&it, &part)) {
+        if (line % stride == 0) {
+            offsets[i++] = part.data - k.data;
+        }
+        line++;
+    }
+    assert(line == lines && i == count);
+    offsets[count] = k.len;
+    *idx = (Kstr_Line_Index) {
+        .k = k,
+        .lines = lines,
+        .stride = stride,
+        .count = count,
+        .offsets = offsets,
+    };
+    return idx;
+}
+
+/**
+ * Returns the start offset of the passed line, which must be valid, scanning at most stride - 1 lines.
+ */
+static size_t kstr__line_start(const Kstr_Line_Index* idx, size_t line)
+{
+    size_t start = idx->offsets[line / idx->stride];
+    for (size_t r = line % idx->stride; r > 0; r--) {
+        start += kstr__find_byte(idx->k.data + start, idx->k.len - start, '\n') + 1;
+    }
+    return start;
+}
+
+/**
+ * Returns the end offset of the passed line, which must be valid, excluding its newline.
+ */
+static size_t kstr__line_end(const Kstr_Line_Index* idx, size_t line, size_t start)
+{
+    if (line + 1 == idx->lines) {
+        return idx->k.len - (idx->k.data[idx->k.len - 1] == '\n');
+    }
+    if (idx->stride == 1) {
+        return idx->offsets[line + 1] - 1;
+    }
+    return start + kstr__find_byte(idx->k.data + start, idx->k.len - start, '\n');
+}
+
+/**
+ * Sets the passed Kstr to the passed line of an indexed Kstr, without its newline.
+ * Runs in O(1) for a stride of 1, and scans at most stride lines otherwise.
+ * @see kstr_line_range()
+ * @param idx The Kstr_Line_Index to query.
+ * @param line The line number, starting from 0.
+ * @param res Pointer to the Kstr to set.
+ * @return true if the line exists, false otherwise.
+ */
+bool kstr_line_at(const Kstr_Line_Index* idx, size_t line, Kstr* res)
+{
+    return kstr_line_range(idx, line, 1, res);
+}
+
+/**
+ * Sets the passed Kstr to count lines of an indexed Kstr starting from first, without the last newline.
+ * Runs in O(1) for a stride of 1, and scans at most stride lines otherwise.
+ * @see kstr_line_at()
+ * @param idx The Kstr_Line_Index to query.
+ * @param first The first line number, starting from 0.
+ * @param count The number of lines. Must be at least 1.
+ * @param res Pointer to the Kstr to set.
+ * @return true if all the lines exist, false otherwise.
+ */
+bool kstr_line_range(const Kstr_Line_Index* idx, size_t first, size_t count, Kstr* res)
+{
+    assert(idx != NULL);
+    assert(res != NULL);
+    if (count == 0 || first >= idx->lines || count > idx->lines - first) {
+        return false;
+    }
+    size_t start = kstr__line_start(idx, first);
+    size_t last = first + count - 1;
+    size_t last_start = (count == 1 ? start : kstr__line_start(idx, last));
+    size_t end = kstr__line_end(idx, last, last_start);
+    *res = kstr_new(idx->k.data + start, end - start);
+    return true;
+}
+
+/**
+ * Returns the number of the line holding the passed byte offset of an indexed Kstr.
+ * Runs a binary search on the stored offsets, then scans at most stride lines.
+ * @param idx The Kstr_Line_Index to query.
+ * @param offset The byte offset. Offsets past the end map to the last line.
+ * @return The line number, starting from 0. Returns 0 for an empty Kstr.
+ */
+size_t kstr_line_of(const Kstr_Line_Index* idx, size_t offset)
+{
+    assert(idx != NULL);
+    if (idx->lines == 0) {
+        return 0;
+    }
+    if (offset >= idx->k.len) {
+        return idx->lines - 1;
+    }
+    // Last stored offset <= offset
+    size_t lo = 0, hi = idx->count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (idx->offsets[mid] <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    size_t start = idx->offsets[lo];
+    return lo * idx->stride + kstr__count_byte(idx->k.data + start, offset - start, '\n');
+}
+
+/**
+ * Returns the 64 bit FNV-1a hash of the passed Kstr.
+ * Matches the default hash of templates/hashmap.h, so that precomputed hashes can be reused there.
+ * @param k The Kstr to hash.
+ * @return The hash.
+ */
+uint64_t kstr_hash(Kstr k)
+{
+    const unsigned char* p = (const unsigned char*) k.data;
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < k.len; i++) {
+        h ^= (uint64_t)p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * Holds one slot of a Kstr_Intern_Pool. The hash is kept in the slot to skip most mismatches without a dereference.
+ */
+typedef struct Kstr_Intern_Slot {
+    uint64_t hash;
+    const Kstr_Interned* interned;
+} Kstr_Intern_Slot;
+
+/**
+ * Returns the first slot index to probe for the passed hash. Folds the high bits in, since FNV-1a low bits mix poorly.
+ */
+static inline size_t kstr__intern_home(uint64_t hash, size_t cap)
+{
+    return (size_t)(hash ^ (hash >> 32)) & (cap - 1);
+}
+
+/**
+ * Pushes a new Kstr_Intern_Pool on the passed Koliseo.
+ * Slots are pushed on the same Koliseo, and replaced by a table twice as big when the pool is 3/4 full.
+ * @see Kstr_Intern_Pool
+ * @param kls The Koliseo to store the pool, its slots and the interned strings.
+ * @param cap Starting number of slots, rounded up to a power of two. When 0, 64 is used.
+ * @return The new Kstr_Intern_Pool, or NULL if a push failed.
+ */
+Kstr_Intern_Pool* kstr_intern_pool_new(Koliseo* kls, size_t cap)
+{
+    size_t real_cap = 64;
+    while (real_cap < cap) {
+        real_cap *= 2;
+    }
+    Kstr_Intern_Pool* pool = KLS_PUSH(kls, Kstr_Intern_Pool);
+    Kstr_Intern_Slot* slots = KLS_PUSH_ARR(kls, Kstr_Intern_Slot, real_cap);
+    if (pool == NULL || slots == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing pool with {%zu} slots.\n", __func__, real_cap);
+        return NULL;
+    }
+    *pool = (Kstr_Intern_Pool) {
+        .kls = kls,
+        .slots = slots,
+        .cap = real_cap,
+        .count = 0,
+    };
+    return pool;
+}
+
+/**
+ * Returns the slot holding the passed Kstr, or the empty slot where it would go.
+ */
+static Kstr_Intern_Slot* kstr__intern_find(const Kstr_Intern_Pool* pool, Kstr k, uint64_t hash)
+{
+    size_t mask = pool->cap - 1;
+    for (size_t i = kstr__intern_home(hash, pool->cap);; i = (i + 1) & mask) {
+        Kstr_Intern_Slot* slot = &pool->slots[i];
+        if (slot->interned == NULL) {
+            return slot;
+        }
+        if (slot->hash == hash && slot->interned->len == k.len && memcmp(slot->interned->data, k.data, k.len) == 0) {
+            return slot;
+        }
+    }
+}
+
+/**
+ * Returns the interned handle for the passed Kstr, adding it to the pool if needed.
+ * The string is copied once in the Koliseo, so the passed Kstr can be freed afterwards.
+ * @see Kstr_Interned
+ * @param pool The Kstr_Intern_Pool at hand.
+ * @param k The Kstr to intern.
+ * @return The handle, stable for the lifetime of the Koliseo, or NULL if a push failed.
+ */
+const Kstr_Interned* kstr_intern(Kstr_Intern_Pool* pool, Kstr k)
+{
+    assert(pool != NULL);
+    uint64_t hash = kstr_hash(k);
+    Kstr_Intern_Slot* slot = kstr__intern_find(pool, k, hash);
+    if (slot->interned != NULL) {
+        return slot->interned;
+    }
+    if ((pool->count + 1) * 4 > pool->cap * 3) {
+        size_t new_cap = pool->cap * 2;
+        Kstr_Intern_Slot* slots = KLS_PUSH_ARR(pool->kls, Kstr_Intern_Slot, new_cap);
+        if (slots == NULL) {
+            fprintf(stderr, "[ERROR] [%s()]: Failed pushing {%zu} slots.\n", __func__, new_cap);
+            return NULL;
+        }
+        for (size_t i = 0; i < pool->cap; i++) {
+            if (pool->slots[i].interned == NULL) continue;
+            size_t j = kstr__intern_home(pool->slots[i].hash, new_cap);
+            while (slots[j].interned != NULL) {
+                j = (j + 1) & (new_cap - 1);
+            }
+            slots[j] = pool->slots[i];
+        }
+        // The old slots stay in the Koliseo until it is cleared
+        pool->slots = slots;
+        pool->cap = new_cap;
+        slot = kstr__intern_find(pool, k, hash);
+    }
+    Kstr_Interned* interned = kls_push_zero_ext(pool->kls, 1, KLS_ALIGNOF(Kstr_Interned), sizeof(Kstr_Interned) + k.len + 1);
+    if (interned == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing string of len {%zu}.\n", __func__, k.len);
+        return NULL;
+    }
+    interned->hash = hash;
+    interned->len = k.len;
+    if (k.len > 0) {
+        memcpy(interned->data, k.data, k.len);
+    }
+    interned->data[k.len] = '\0';
+    slot->hash = hash;
+    slot->interned = interned;
+    pool->count++;
+    return interned;
+}
+
+/**
+ * Returns the interned handle for the passed Kstr, without adding it to the pool.
+ * @param pool The Kstr_Intern_Pool at hand.
+ * @param k The Kstr to look for.
+ * @return The handle, or NULL if the Kstr was never interned.
+ */
+const Kstr_Interned* kstr_intern_lookup(const Kstr_Intern_Pool* pool, Kstr k)
+{
+    assert(pool != NULL);
+    return kstr__intern_find(pool, k, kstr_hash(k))->interned;
+}
+
+/**
+ * Returns a Kstr viewing the passed interned string.
+ * @param interned The Kstr_Interned at hand.
+ * @return The resulting Kstr.
+ */
+Kstr kstr_from_interned(const Kstr_Interned* interned)
+{
+    assert(interned != NULL);
+    return kstr_new(interned->data, interned->len);
+}
+
+/**
+ * Header of a Kstr_Phf made by kstr_phf_serialize(). It is followed by the pilots, the remap and the key offsets,
+ * as uint32_t, then by the keys. Fields are in native byte order, so a table saved on a machine with another one
+ * is rejected for its format.
+ */
+typedef struct Kstr_Phf_Header {
+    char magic[4];
+    uint32_t format;
+    uint64_t seed;
+    uint32_t count;
+    uint32_t bucket_count;
+    uint32_t table_size;
+    uint32_t reserved;
+    uint64_t keys_len;
+} Kstr_Phf_Header;
+
+static const char kstr__phf_magic[4] = { 'K', 'P', 'H', 'F' };
+
+/**
+ * splitmix64 finalizer.
+ */
+static inline uint64_t kstr__phf_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * Sets the bucket and position hashes of a key from its kstr_hash() and the seed of a Kstr_Phf.
+ */
+static inline void kstr__phf_hashes(uint64_t hash, uint64_t seed, uint64_t* hb, uint64_t* hp)
+{
+    *hb = kstr__phf_mix(hash ^ seed);
+    *hp = kstr__phf_mix(*hb ^ 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * Returns the bucket for the passed bucket hash. About 60% of the keys go to the first 30% of the buckets:
+ * those are placed first, while most positions are free, so that pilots for the rest stay small.
+ */
+static inline uint32_t kstr__phf_bucket(uint64_t hb, uint32_t bucket_count)
+{
+    uint32_t dense = (uint32_t)((uint64_t) bucket_count * 3 / 10);
+    uint64_t lo = (uint32_t) hb;
+    if (dense == 0) {
+        return (uint32_t)((lo * bucket_count) >> 32);
+    }
+    if ((hb >> 32) < 0x9999999AULL) {
+        return (uint32_t)((lo * dense) >> 32);
+    }
+    return dense + (uint32_t)((lo * (bucket_count - dense)) >> 32);
+}
+
+/**
+ * Returns the position of a key with the passed position hash, for the pilot of its bucket.
+ */
+static inline uint32_t kstr__phf_pos(uint64_t hp, uint32_t pilot, uint32_t table_size)
+{
+    return (uint32_t)((hp ^ kstr__phf_mix(pilot)) % table_size);
+}
+
+#define KSTR__PHF_TAKEN(bits, p) (((bits)[(p) / 64] >> ((p) % 64)) & 1)
+
+/**
+ * Tries to find a pilot for every bucket, with the passed seed. Sets pos_of to the position of each key.
+ * Returns 1 on success, 0 if a bucket ran out of pilots, and -1 if two keys have the same hash.
+ */
+static int kstr__phf_place(const Kstr* keys, uint32_t n, uint32_t m, uint32_t b, uint64_t seed,
+                           uint32_t* pilots, uint64_t* hp, uint64_t* taken, uint32_t* bucket_of, uint32_t* by_bucket,
+                           uint32_t* bucket_start, uint32_t* order, uint32_t* pos_of)
+{
+    memset(bucket_start, 0, (b + 2) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t hb = 0;
+        kstr__phf_hashes(kstr_hash(keys[i]), seed, &hb, &hp[i]);
+        bucket_of[i] = kstr__phf_bucket(hb, b);
+        bucket_start[bucket_of[i] + 2]++;
+    }
+    // Counting sort of the keys by bucket, then of the buckets by size, biggest first
+    uint32_t max_size = 0;
+    for (uint32_t i = 0; i < b; i++) {
+        max_size = KLS_MAX(max_size, bucket_start[i + 2]);
+    }
+    uint32_t* by_size = KLS_DEFAULT_ALLOCF((max_size + 2) * sizeof(uint32_t));
+    if (by_size == NULL) {
+        return 0;
+    }
+    memset(by_size, 0, (max_size + 2) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < b; i++) {
+        by_size[max_size - bucket_start[i + 2] + 1]++;
+    }
+    for (uint32_t s = 1; s <= max_size + 1; s++) {
+        by_size[s] += by_size[s - 1];
+    }
+    for (uint32_t i = 0; i < b; i++) {
+        order[by_size[max_size - bucket_start[i + 2]]++] = i;
+    }
+    KLS_DEFAULT_FREEF(by_size);
+    for (uint32_t i = 2; i < b + 2; i++) {
+        bucket_start[i] += bucket_start[i - 1];
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        by_bucket[bucket_start[bucket_of[i] + 1]++] = i;
+    }
+
+    memset(taken, 0, ((m + 63) / 64) * sizeof(uint64_t));
+    memset(pilots, 0, b * sizeof(uint32_t));
+    for (uint32_t o = 0; o < b; o++) {
+        uint32_t bucket = order[o];
+        const uint32_t* bkeys = by_bucket + bucket_start[bucket];
+        uint32_t size = bucket_start[bucket + 1] - bucket_start[bucket];
+        if (size == 0) {
+            break;
+        }
+        // Keys with the same hash can never be split
+        for (uint32_t j = 0; j < size; j++) {
+            for (uint32_t k = j + 1; k < size; k++) {
+                if (hp[bkeys[j]] == hp[bkeys[k]]) {
+                    bucket_of[0] = bkeys[j];
+                    bucket_of[1] = bkeys[k];
+                    return -1;
+                }
+            }
+        }
+        uint32_t pilot = 0;
+        for (;; pilot++) {
+            if (pilot == KSTR_PHF_MAX_PILOT) {
+                return 0;
+            }
+            uint32_t placed = 0;
+            for (; placed < size; placed++) {
+                uint32_t p = kstr__phf_pos(hp[bkeys[placed]], pilot, m);
+                if (KSTR__PHF_TAKEN(taken, p)) {
+                    break;
+                }
+                taken[p / 64] |= 1ULL << (p % 64);
+                pos_of[bkeys[placed]] = p;
+            }
+            if (placed == size) {
+                break;
+            }
+            for (uint32_t j = 0; j < placed; j++) {
+                uint32_t p = pos_of[bkeys[j]];
+                taken[p / 64] &= ~(1ULL << (p % 64));
+            }
+        }
+        pilots[bucket] = pilot;
+    }
+    return 1;
+}
+
+/**
+ * Builds a minimal perfect hash table over the passed keys, pushing it on the passed Koliseo with a copy of the keys.
+ * The ids of the keys can be found with kstr_phf_lookup(), in a single probe.
+ * Building takes linear time, with scratch memory from KLS_DEFAULT_ALLOCF that is freed before returning.
+ * Fails for duplicate keys, and for distinct keys with the same kstr_hash().
+ * @see Kstr_Phf
+ * @param kls The Koliseo to push the table to.
+ * @param keys Array of distinct keys, e.g. from kstr_split_all() on a gulped file.
+ * @param count Number of keys. Must be less than UINT32_MAX / 2.
+ * @return The new Kstr_Phf, or NULL on errors.
+ */
+Kstr_Phf* kstr_phf_new(Koliseo* kls, const Kstr* keys, size_t count)
+{
+    assert(keys != NULL || count == 0);
+    size_t keys_len = 0;
+    for (size_t i = 0; i < count; i++) {
+        keys_len += keys[i].len;
+    }
+    if (count >= UINT32_MAX / 2 || keys_len > UINT32_MAX) {
+        fprintf(stderr, "[ERROR] [%s()]: Too many keys: {%zu}, {%zu} bytes.\n", __func__, count, keys_len);
+        return NULL;
+    }
+    uint32_t n = (uint32_t) count;
+    uint32_t m = n + n / 64 + (n > 0);
+    uint32_t b = n / KSTR_PHF_BUCKET_SIZE + 1;
+    Kstr_Phf* phf = KLS_PUSH(kls, Kstr_Phf);
+    uint32_t* pilots = KLS_PUSH_ARR(kls, uint32_t, b);
+    uint32_t* remap = KLS_PUSH_ARR(kls, uint32_t, m - n + 1);
+    uint32_t* key_offs = KLS_PUSH_ARR(kls, uint32_t, n + 1);
+    char* key_data = KLS_PUSH_ARR(kls, char, keys_len + 1);
+    if (phf == NULL || pilots == NULL || remap == NULL || key_offs == NULL || key_data == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing table for {%zu} keys.\n", __func__, count);
+        return NULL;
+    }
+
+    size_t words = (m + 63) / 64;
+    size_t scratch_size = ((size_t) n + words) * sizeof(uint64_t) + ((size_t) n * 3 + (b + 2) + b) * sizeof(uint32_t);
+    uint64_t* hp = KLS_DEFAULT_ALLOCF(scratch_size);
+    if (hp == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed allocating scratch buffer.\n", __func__);
+        return NULL;
+    }
+    uint64_t* taken = hp + n;
+    uint32_t* bucket_of = (uint32_t*)(taken + words);
+    uint32_t* by_bucket = bucket_of + n;
+    uint32_t* pos_of = by_bucket + n;
+    uint32_t* bucket_start = pos_of + n;
+    uint32_t* order = bucket_start + b + 2;
+
+    uint64_t seed = 0;
+    int res = 0;
+    for (int attempt = 0; res == 0 && attempt < KSTR_PHF_MAX_SEEDS; attempt++) {
+        seed = kstr__phf_mix(0x5EEDULL + attempt);
+        res = kstr__phf_place(keys, n, m, b, seed, pilots, hp, taken, bucket_of, by_bucket, bucket_start, order, pos_of);
+    }
+    if (res != 1) {
+        if (res < 0 && kstr_eq(keys[bucket_of[0]], keys[bucket_of[1]])) {
+            fprintf(stderr, "[ERROR] [%s()]: Duplicate key {" Kstr_Fmt "}.\n", __func__, Kstr_Arg(keys[bucket_of[0]]));
+        } else if (res < 0) {
+            fprintf(stderr, "[ERROR] [%s()]: Keys {" Kstr_Fmt "} and {" Kstr_Fmt "} have the same hash.\n", __func__,
+                    Kstr_Arg(keys[bucket_of[0]]), Kstr_Arg(keys[bucket_of[1]]));
+        } else {
+            fprintf(stderr, "[ERROR] [%s()]: No pilots found after {%i} seeds.\n", __func__, KSTR_PHF_MAX_SEEDS);
+        }
+        KLS_DEFAULT_FREEF(hp);
+        return NULL;
+    }
+
+    // Taken positions past n are mapped to the free ones before n, in order
+    uint32_t free_pos = 0;
+    for (uint32_t p = n; p < m; p++) {
+        if (!KSTR__PHF_TAKEN(taken, p)) continue;
+        while (KSTR__PHF_TAKEN(taken, free_pos)) {
+            free_pos++;
+        }
+        remap[p - n] = free_pos++;
+    }
+    // Key index of each id, then the keys laid out by id
+    uint32_t* key_of = bucket_of;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t p = pos_of[i];
+        key_of[p < n ? p : remap[p - n]] = i;
+    }
+    uint32_t off = 0;
+    for (uint32_t id = 0; id < n; id++) {
+        const Kstr* k = &keys[key_of[id]];
+        key_offs[id] = off;
+        if (k->len > 0) {
+            memcpy(key_data + off, k->data, k->len);
+        }
+        off += (uint32_t) k->len;
+    }
+    key_offs[n] = off;
+    KLS_DEFAULT_FREEF(hp);
+
+    *phf = (Kstr_Phf) {
+        .seed = seed,
+        .count = n,
+        .bucket_count = b,
+        .table_size = m,
+        .pilots = pilots,
+        .remap = remap,
+        .key_offs = key_offs,
+        .keys = key_data,
+    };
+    return phf;
+}
+
+/**
+ * Returns the id of the passed key in a Kstr_Phf, with a single probe.
+ * Keys outside of the set are found missing by comparing them with the key at the probed id.
+ * @param phf The Kstr_Phf at hand.
+ * @param k The key to look for.
+ * @return The id of the key, from 0 to count - 1, or -1 if it is not in the set.
+ */
+ptrdiff_t kstr_phf_lookup(const Kstr_Phf* phf, Kstr k)
+{
+    assert(phf != NULL);
+    if (phf->count == 0) {
+        return -1;
+    }
+    uint64_t hb = 0, hp = 0;
+    kstr__phf_hashes(kstr_hash(k), phf->seed, &hb, &hp);
+    uint32_t pos = kstr__phf_pos(hp, phf->pilots[kstr__phf_bucket(hb, phf->bucket_count)], phf->table_size);
+    uint32_t id = (pos < phf->count ? pos : phf->remap[pos - phf->count]);
+    uint32_t off = phf->key_offs[id];
+    if (phf->key_offs[id + 1] - off != k.len || (k.len > 0 && memcmp(phf->keys + off, k.data, k.len) != 0)) {
+        return -1;
+    }
+    return id;
+}
+
+/**
+ * Returns a Kstr viewing the key with the passed id in a Kstr_Phf.
+ * @param phf The Kstr_Phf at hand.
+ * @param id The id of the key. Must be less than count.
+ * @return The key.
+ */
+Kstr kstr_phf_key(const Kstr_Phf* phf, uint32_t id)
+{
+    assert(phf != NULL);
+    assert(id < phf->count);
+    return kstr_new(phf->keys + phf->key_offs[id], phf->key_offs[id + 1] - phf->key_offs[id]);
+}
+
+/**
+ * Fills the serialized header for the passed Kstr_Phf, and returns the size of the whole blob.
+ */
+static size_t kstr__phf_header(const Kstr_Phf* phf, Kstr_Phf_Header* h)
+{
+    *h = (Kstr_Phf_Header) {
+        .format = KSTR_PHF_FORMAT,
+        .seed = phf->seed,
+        .count = phf->count,
+        .bucket_count = phf->bucket_count,
+        .table_size = phf->table_size,
+        .keys_len = phf->key_offs[phf->count],
+    };
+    memcpy(h->magic, kstr__phf_magic, sizeof(h->magic));
+    return sizeof(*h) + ((size_t) phf->bucket_count + (phf->table_size - phf->count) + phf->count + 1) * sizeof(uint32_t)
+           + h->keys_len;
+}
+
+/**
+ * Serializes the passed Kstr_Phf to a blob pushed on the passed Koliseo, to be reloaded with kstr_phf_load().
+ * @see kstr_phf_save()
+ * @param kls The Koliseo to push the blob to.
+ * @param phf The Kstr_Phf to serialize.
+ * @return A Kstr viewing the blob, or KSTR_NULL if the push failed.
+ */
+Kstr kstr_phf_serialize(Koliseo* kls, const Kstr_Phf* phf)
+{
+    assert(phf != NULL);
+    Kstr_Phf_Header h;
+    size_t size = kstr__phf_header(phf, &h);
+    char* blob = kls_push_zero_ext(kls, 1, KLS_ALIGNOF(Kstr_Phf_Header), size);
+    if (blob == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing blob of size {%zu}.\n", __func__, size);
+        return KSTR_NULL;
+    }
+    char* p = blob;
+    memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    memcpy(p, phf->pilots, phf->bucket_count * sizeof(uint32_t));
+    p += phf->bucket_count * sizeof(uint32_t);
+    memcpy(p, phf->remap, (phf->table_size - phf->count) * sizeof(uint32_t));
+    p += (phf->table_size - phf->count) * sizeof(uint32_t);
+    memcpy(p, phf->key_offs, (phf->count + 1) * sizeof(uint32_t));
+    p += (phf->count + 1) * sizeof(uint32_t);
+    if (h.keys_len > 0) {
+        memcpy(p, phf->keys, h.keys_len);
+    }
+    return kstr_new(blob, size);
+}
+
+/**
+ * Writes the passed Kstr_Phf to the passed file, in the layout of kstr_phf_serialize().
+ * The file can be reloaded without copies by passing KLS_GULP_FILE_MMAP() contents to kstr_phf_load().
+ * @param phf The Kstr_Phf to save.
+ * @param fp The file to write to.
+ * @return true on success, false if a write failed.
+ */
+bool kstr_phf_save(const Kstr_Phf* phf, FILE* fp)
+{
+    assert(phf != NULL);
+    assert(fp != NULL);
+    Kstr_Phf_Header h;
+    kstr__phf_header(phf, &h);
+    return fwrite(&h, sizeof(h), 1, fp) == 1
+           && fwrite(phf->pilots, sizeof(uint32_t), phf->bucket_count, fp) == phf->bucket_count
+           && fwrite(phf->remap, sizeof(uint32_t), phf->table_size - phf->count, fp) == phf->table_size - phf->count
+           && fwrite(phf->key_offs, sizeof(uint32_t), phf->count + 1, fp) == (size_t) phf->count + 1
+           && (h.keys_len == 0 || fwrite(phf->keys, 1, h.keys_len, fp) == h.keys_len);
+}
+
+/**
+ * Loads a Kstr_Phf from a blob made by kstr_phf_serialize() or kstr_phf_save(), without rebuilding it.
+ * The table points into the blob, which must outlive it. Blobs not aligned for uint32_t are copied to the Koliseo first.
+ * The layout is checked, so that lookups stay in bounds for any accepted blob.
+ * @param kls The Koliseo to push the Kstr_Phf to.
+ * @param blob The serialized table.
+ * @return The loaded Kstr_Phf, or NULL for malformed blobs and failed pushes.
+ */
+Kstr_Phf* kstr_phf_load(Koliseo* kls, Kstr blob)
+{
+    Kstr_Phf_Header h;
+    if (blob.len < sizeof(h)) {
+        fprintf(stderr, "[ERROR] [%s()]: Blob too short: {%zu}.\n", __func__, blob.len);
+        return NULL;
+    }
+    memcpy(&h, blob.data, sizeof(h));
+    if (memcmp(h.magic, kstr__phf_magic, sizeof(h.magic)) != 0 || h.format != KSTR_PHF_FORMAT) {
+        fprintf(stderr, "[ERROR] [%s()]: Not a Kstr_Phf of format {%i}.\n", __func__, KSTR_PHF_FORMAT);
+        return NULL;
+    }
+    uint64_t size = sizeof(h) + ((uint64_t) h.bucket_count + h.table_size + 1) * sizeof(uint32_t) + h.keys_len;
+    if (h.table_size < h.count || (h.count > 0 && h.bucket_count == 0) || h.keys_len > UINT32_MAX || size != blob.len) {
+        fprintf(stderr, "[ERROR] [%s()]: Bad layout for blob of size {%zu}.\n", __func__, blob.len);
+        return NULL;
+    }
+    const char* data = blob.data;
+    if ((uintptr_t) data % KLS_ALIGNOF(uint32_t) != 0) {
+        char* copy = kls_push_zero_ext(kls, 1, KLS_ALIGNOF(Kstr_Phf_Header), blob.len);
+        if (copy == NULL) {
+            fprintf(stderr, "[ERROR] [%s()]: Failed pushing copy of size {%zu}.\n", __func__, blob.len);
+            return NULL;
+        }
+        memcpy(copy, blob.data, blob.len);
+        data = copy;
+    }
+    const uint32_t* pilots = (const uint32_t*)(data + sizeof(h));
+    const uint32_t* remap = pilots + h.bucket_count;
+    const uint32_t* key_offs = remap + (h.table_size - h.count);
+    bool ok = (key_offs[0] == 0 && key_offs[h.count] == h.keys_len);
+    for (uint32_t i = 0; ok && i < h.count; i++) {
+        ok = (key_offs[i] <= key_offs[i + 1]);
+    }
+    for (uint32_t i = 0; ok && i < h.table_size - h.count; i++) {
+        ok = (remap[i] < h.count);
+    }
+    if (!ok) {
+        fprintf(stderr, "[ERROR] [%s()]: Bad key offsets or remap.\n", __func__);
+        return NULL;
+    }
+    Kstr_Phf* phf = KLS_PUSH(kls, Kstr_Phf);
+    if (phf == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing table.\n", __func__);
+        return NULL;
+    }
+    *phf = (Kstr_Phf) {
+        .seed = h.seed,
+        .count = h.count,
+        .bucket_count = h.bucket_count,
+        .table_size = h.table_size,
+        .pilots = pilots,
+        .remap = remap,
+        .key_offs = key_offs,
+        .keys = (const char*)(key_offs + h.count + 1),
+    };
+    return phf;
+}
+
+/**
+ * Appends the passed Kstr to the passed Kls_StrBuf.
+ * @see kls_strbuf_append()
+ * @param sb The Kls_StrBuf at hand.
+ * @param k The Kstr to append.
+ * @return true on success, false if a push failed.
+ */
+bool kls_strbuf_append_kstr(Kls_StrBuf* sb, Kstr k)
+{
+    return kls_strbuf_append(sb, k.data, k.len);
+}
+
+/**
+ * Finishes the passed Kls_StrBuf, returning a Kstr viewing the built string where it lies.
+ * The data is also null-terminated.
+ * @see kls_strbuf_finish()
+ * @param sb The Kls_StrBuf at hand.
+ * @return The resulting Kstr, or KSTR_NULL if no capacity was ever pushed.
+ */
+Kstr kls_strbuf_finish_kstr(Kls_StrBuf* sb)
+{
+    ptrdiff_t len = 0;
+    char* data = kls_strbuf_finish(sb, &len);
+    return kstr_new(data, len);
+}
+
+static char * kls_read_file(Koliseo* kls, const char * f_name, Gulp_Res * err, size_t * f_size, ...)
+{
+    if (!kls) {
+        *err = GULP_FILE_KLS_NULL;
+        return NULL;
+    }
+    char * buffer;
+    size_t length = 0;
+    FILE * f = fopen(f_name, "rb");
+    size_t read_length;
+
+    if (f) {
+        fseek(f, 0, SEEK_END);
+        length = ftell(f);
+        fseek(f, 0, SEEK_SET);
+
+        va_list args;
+        va_start(args, f_size);
+        size_t max_size = va_arg(args, size_t);
+        if (length > max_size) {
+            *err = GULP_FILE_TOO_LARGE;
+
+            return NULL;
+        }
+        va_end(args);
+
+        buffer = KLS_PUSH_ARR_NAMED(kls,char,length + 1,"char*","Buffer for file gulp");
+
+        if (buffer == NULL) {
+            assert(0 && "KLS_PUSH_NAMED() failed\n");
+        }
+
+        if (length) {
+            read_length = fread(buffer, 1, length, f);
+
+            if (length != read_length) {
+                *err = GULP_FILE_READ_ERROR;
+                fclose(f);
+                return NULL;
+            }
+        }
+
+        fclose(f);
+
+        *err = GULP_FILE_OK;
+        buffer[length] = '\0';
+        *f_size = length;
+    } else {
+        *err = GULP_FILE_NOT_EXIST;
+
+        return NULL;
+    }
+
+    if (strlen(buffer) == length) {
+        return buffer;
+    } else {
+        *err = GULP_FILE_CONTAINS_NULLCHAR;
+        return buffer;
+    }
+}
+
+/**
+ * Tries mapping the passed file on the Koliseo.
+ * Sets the passed Gulp_Res to the result of the operation, .
+ * @param kls The Koliseo to push to.
+ * @param filepath Path to the file to gulp.
+ * @param err Pointer to the Gulp_Res variable to store result.
+ * @param max_size Max size allowed for the read file.
+ * @see KLS_GULP_FILE()
+ */
+char * kls_gulp_file_sized(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size)
+{
+    static_assert(TOT_GULP_RES == 8, "Number of Gulp_Res changed");
+    size_t f_size;
+    char * data = NULL;
+    data = kls_read_file(kls, filepath, err, &f_size, max_size);
+    if (*err != GULP_FILE_OK) {
+        switch (*err) {
+        case GULP_FILE_NOT_EXIST:
+        case GULP_FILE_TOO_LARGE:
+        case GULP_FILE_READ_ERROR:
+        case GULP_FILE_CONTAINS_NULLCHAR:
+        case GULP_FILE_KLS_NULL: {
+            fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+        }
+        break;
+        default: {
+            fprintf(stderr,"[ERROR]    %s():  Unexpected error {%i}.\n",__func__, *err);
+        }
+        break;
+        }
+        if (*err != GULP_FILE_CONTAINS_NULLCHAR) return NULL;
+    } else {
+        assert(strlen(data) == f_size && "data len should be equal to f_size here!");
+        if (!data) {
+            assert(0 && "kls_read_file() failed\n");
+        }
+        //printf("%s\n\n",data);
+        //printf("SIZE: {%i}\n",f_size);
+    }
+    return data;
+}
+
+/**
+ * Tries mapping the passed file on the Koliseo.
+ * @param kls The Koliseo to push to.
+ * @param filepath Path to the file to gulp.
+ * @param max_size Max size allowed for the read file.
+ * @see KLS_GULP_FILE()
+ * @return A pointer to the string with file contents.
+ */
+char * try_kls_gulp_file(Koliseo* kls, const char * filepath, size_t max_size)
+{
+    Gulp_Res err = -1;
+
+    char* res = kls_gulp_file_sized(kls, filepath, &err, max_size);
+
+    if (err != GULP_FILE_OK && err != GULP_FILE_CONTAINS_NULLCHAR) {
+        fprintf(stderr, "%s():  kls_gulp_file_sized() failed with err {%s}.\n",__func__,string_from_Gulp_Res(err));
+    }
+
+    return res;
+}
+
+static Kstr * kls_read_file_to_kstr(Koliseo* kls, const char * f_name, Gulp_Res * err, size_t * f_size, ...)
+{
+    if (!kls) {
+        *err = GULP_FILE_KLS_NULL;
+        return NULL;
+    }
+    char * buffer = NULL;
+    size_t length = 0;
+    FILE * f = fopen(f_name, "rb");
+    size_t read_length;
+    bool allow_nullchar = false;
+
+    if (f) {
+        fseek(f, 0, SEEK_END);
+        length = ftell(f);
+        fseek(f, 0, SEEK_SET);
 
         va_list args;
         va_start(args, f_size);
         size_t max_size = va_arg(args, size_t);
         if (length > max_size) {
             *err = GULP_FILE_TOO_LARGE;
-
+            va_end(args);
+            fclose(f);
             return NULL;
         }
+        bool allow_nulls = va_arg(args, int);
+        allow_nullchar = allow_nulls;
         va_end(args);
 
         buffer = KLS_PUSH_ARR_NAMED(kls,char,length + 1,"char*","Buffer for file gulp");
@@ -438,234 +2307,1150 @@ static char * kls_read_file(Koliseo* kls, const char * f_name, Gulp_Res * err, s
         if (length) {
             read_length = fread(buffer, 1, length, f);
 
-            if (length != read_length) {
-                *err = GULP_FILE_READ_ERROR;
-                return NULL;
-            }
+            if (length != read_length) {
+                *err = GULP_FILE_READ_ERROR;
+                return NULL;
+            }
+        }
+
+        fclose(f);
+
+        *err = GULP_FILE_OK;
+        buffer[length] = '\0';
+        *f_size = length;
+    } else {
+        *err = GULP_FILE_NOT_EXIST;
+
+        return NULL;
+    }
+
+    if (strlen(buffer) == length) {
+    } else {
+        *err = GULP_FILE_CONTAINS_NULLCHAR;
+        if (!allow_nullchar) {
+            return NULL;
+        }
+    }
+    Kstr * res = KLS_PUSH_NAMED(kls,Kstr,"Kstr","Kstr for file gulp");
+    if (res == NULL) {
+        assert(0 && "KLS_PUSH_NAMED() failed\n");
+    }
+    res->data = buffer;
+    if (*err == GULP_FILE_CONTAINS_NULLCHAR) {
+        res->len = length;
+    } else {
+        res->len = strlen(buffer);
+    }
+    return res;
+}
+
+/**
+ * Tries mapping the passed file on the Koliseo.
+ * Sets the passed Gulp_Res to the result of the operation.
+ * @param kls The Koliseo to push to.
+ * @param filepath Path to the file to gulp.
+ * @param err Pointer to the Gulp_Res variable to store result.
+ * @param max_size Max size allowed for the read file.
+ * @param allow_nullchar Bool to avoid returning NULL for a binary file.
+ * @see KLS_GULP_FILE()
+ * @return A Kstr for the passed filepath contents.
+ */
+Kstr * kls_gulp_file_sized_to_kstr(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size, bool allow_nullchar)
+{
+    static_assert(TOT_GULP_RES == 8, "Number of Gulp_Res changed");
+    size_t f_size;
+    Kstr * data = NULL;
+    data = kls_read_file_to_kstr(kls, filepath, err, &f_size, max_size, allow_nullchar);
+    if (*err != GULP_FILE_OK) {
+        switch (*err) {
+        case GULP_FILE_NOT_EXIST:
+        case GULP_FILE_TOO_LARGE:
+        case GULP_FILE_READ_ERROR:
+        case GULP_FILE_CONTAINS_NULLCHAR:
+        case GULP_FILE_KLS_NULL: {
+            fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+        }
+        break;
+        default: {
+            fprintf(stderr,"[ERROR]    %s():  Unexpected error {%i}.\n",__func__, *err);
+        }
+        break;
+        }
+        return data;
+    } else {
+        assert(data->len == f_size && "data len should be equal to f_size here!");
+        if (!data) {
+            assert(0 && "kls_read_file_to_kstr() failed\n");
+        }
+        //printf("%s\n\n",data->data);
+        //printf("SIZE: {%i}\n",f_size);
+    }
+    return data;
+}
+
+/**
+ * Tries mapping the passed file on the Koliseo.
+ * @param kls The Koliseo to push to.
+ * @param filepath Path to the file to gulp.
+ * @param max_size Max size allowed for the read file.
+ * @param allow_nullchar Boolean to avoid returning NULL for a binary file.
+ * @see KLS_GULP_FILE()
+ * @return A pointer to the Kstr with file contents.
+ */
+Kstr * try_kls_gulp_file_to_kstr(Koliseo* kls, const char * filepath, size_t max_size, bool allow_nullchar)
+{
+    Gulp_Res err = -1;
+
+    Kstr * res = NULL;
+    res = kls_gulp_file_sized_to_kstr(kls, filepath, &err, max_size, allow_nullchar);
+
+    if (err != GULP_FILE_OK) {
+        fprintf(stderr, "%s():  kls_gulp_file_sized_to_kstr() failed with err {%s}.\n",__func__,string_from_Gulp_Res(err));
+    }
+
+    return res;
+}
+
+#ifndef _WIN32
+/**
+ * Holds a file mapping made by kls_gulp_file_mmap(), released by kls_gulp__munmap() when the owning Koliseo is freed.
+ */
+typedef struct Kls_Gulp_Mapping {
+    void* addr;
+    size_t len;
+} Kls_Gulp_Mapping;
+
+static void kls_gulp__munmap(void* ctx)
+{
+    Kls_Gulp_Mapping* mapping = ctx;
+    if (munmap(mapping->addr, mapping->len) != 0) {
+        fprintf(stderr,"[ERROR]    %s():  Failed munmap() call.\n",__func__);
+    }
+    KLS_DEFAULT_FREEF(mapping);
+}
+#endif // _WIN32
+
+/**
+ * Tries mapping the passed file read-only, without copying it on the Koliseo.
+ * The returned Kstr is a view over the mapping, which is released when the passed Koliseo is freed or cleared.
+ * Notably, the view is not NUL-terminated and its contents are not checked for nullchars.
+ * Hints the kernel for sequential access and readahead.
+ * On Windows, falls back to kls_gulp_file_sized_to_kstr(), allowing nullchars.
+ * Sets the passed Gulp_Res to the result of the operation.
+ * @param kls The Koliseo to tie the mapping to. Only the Kstr itself is pushed on it.
+ * @param filepath Path to the file to gulp.
+ * @param err Pointer to the Gulp_Res variable to store result.
+ * @param max_size Max size allowed for the mapped file.
+ * @see KLS_GULP_FILE_MMAP()
+ * @see kls_on_free()
+ * @return A Kstr for the passed filepath contents, or NULL for errors.
+ */
+Kstr * kls_gulp_file_mmap(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size)
+{
+    static_assert(TOT_GULP_RES == 8, "Number of Gulp_Res changed");
+#ifdef _WIN32
+    return kls_gulp_file_sized_to_kstr(kls, filepath, err, max_size, true);
+#else
+    if (!kls) {
+        *err = GULP_FILE_KLS_NULL;
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+        return NULL;
+    }
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) {
+        *err = GULP_FILE_NOT_EXIST;
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        *err = GULP_FILE_READ_ERROR;
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+        return NULL;
+    }
+    size_t length = st.st_size;
+    if (length > max_size) {
+        close(fd);
+        *err = GULP_FILE_TOO_LARGE;
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+        return NULL;
+    }
+    if (length == 0) {
+        // Can't map an empty file
+        close(fd);
+        Kstr * res = KLS_PUSH_NAMED(kls,Kstr,"Kstr","Kstr for file mmap");
+        if (res == NULL) {
+            assert(0 && "KLS_PUSH_NAMED() failed\n");
+        }
+        *res = kstr_new("", 0);
+        *err = GULP_FILE_OK;
+        return res;
+    }
+    void* addr = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        *err = GULP_FILE_READ_ERROR;
+        fprintf(stderr,"[ERROR]    %s():  Failed mmap() call.\n",__func__);
+        return NULL;
+    }
+    Kls_Gulp_Mapping* mapping = KLS_DEFAULT_ALLOCF(sizeof(Kls_Gulp_Mapping));
+    if (mapping == NULL || !kls_on_free(kls, &kls_gulp__munmap, mapping)) {
+        KLS_DEFAULT_FREEF(mapping);
+        munmap(addr, length);
+        *err = GULP_FILE_READ_ERROR;
+        fprintf(stderr,"[ERROR]    %s():  Failed tying mapping to Koliseo.\n",__func__);
+        return NULL;
+    }
+    mapping->addr = addr;
+    mapping->len = length;
+    // Hints are best-effort, ignore failures
+    posix_madvise(addr, length, POSIX_MADV_SEQUENTIAL);
+    posix_madvise(addr, length, POSIX_MADV_WILLNEED);
+
+    // Pushed last, so failed mappings leave nothing on the Koliseo
+    Kstr * res = KLS_PUSH_NAMED(kls,Kstr,"Kstr","Kstr for file mmap");
+    if (res == NULL) {
+        assert(0 && "KLS_PUSH_NAMED() failed\n");
+    }
+    *res = kstr_new(addr, length);
+    *err = GULP_FILE_OK;
+    return res;
+#endif // _WIN32
+}
+
+/**
+ * Tries mapping the passed file read-only, without copying it on the Koliseo.
+ * @param kls The Koliseo to tie the mapping to.
+ * @param filepath Path to the file to gulp.
+ * @param max_size Max size allowed for the mapped file.
+ * @see kls_gulp_file_mmap()
+ * @see KLS_GULP_FILE_MMAP()
+ * @return A pointer to the Kstr viewing the file contents.
+ */
+Kstr * try_kls_gulp_file_mmap(Koliseo* kls, const char * filepath, size_t max_size)
+{
+    Gulp_Res err = -1;
+
+    Kstr * res = kls_gulp_file_mmap(kls, filepath, &err, max_size);
+
+    if (err != GULP_FILE_OK) {
+        fprintf(stderr, "%s():  kls_gulp_file_mmap() failed with err {%s}.\n",__func__,string_from_Gulp_Res(err));
+    }
+
+    return res;
+}
+
+/**
+ * Starts a Kls_Gulp_Stream over the passed file descriptor.
+ * Pushes the chunk buffer on the passed Koliseo, then starts a Koliseo_Temp on it, used to stitch records crossing chunk boundaries.
+ * Notably, the passed Koliseo must not have an active Koliseo_Temp, or GULP_FILE_KLS_HAS_TEMP is returned, and should not be used until kls_gulp_stream_end().
+ * @param stream The Kls_Gulp_Stream to initialise.
+ * @param kls The Koliseo to push the chunk buffer to.
+ * @param fd The file descriptor to read from.
+ * @param chunk_size Size of the chunk buffer. Pass 0 to use KLS_GULP_STREAM_CHUNK_SIZE.
+ * @param delim The record delimiter, e.g. '\n' for lines.
+ * @return GULP_FILE_OK on success, or the error result.
+ * @see kls_gulp_stream_next()
+ */
+Gulp_Res kls_gulp_stream_start(Kls_Gulp_Stream* stream, Koliseo* kls, int fd, size_t chunk_size, char delim)
+{
+    assert(stream != NULL);
+    if (!kls) {
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(GULP_FILE_KLS_NULL));
+        return GULP_FILE_KLS_NULL;
+    }
+    if (fd < 0) {
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(GULP_FILE_NOT_EXIST));
+        return GULP_FILE_NOT_EXIST;
+    }
+    if (kls->has_temp) {
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(GULP_FILE_KLS_HAS_TEMP));
+        return GULP_FILE_KLS_HAS_TEMP;
+    }
+    if (chunk_size == 0) {
+        chunk_size = KLS_GULP_STREAM_CHUNK_SIZE;
+    }
+    char* buf = KLS_PUSH_ARR_NAMED(kls, char, chunk_size, "char*", "Chunk for gulp stream");
+    if (buf == NULL) {
+        assert(0 && "KLS_PUSH_ARR_NAMED() failed\n");
+    }
+    Koliseo_Temp* t_kls = kls_temp_start(kls);
+    if (t_kls == NULL) {
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(GULP_FILE_KLS_HAS_TEMP));
+        return GULP_FILE_KLS_HAS_TEMP;
+    }
+    *stream = (Kls_Gulp_Stream) {
+        .fd = fd,
+        .delim = delim,
+        .buf = buf,
+        .cap = chunk_size,
+        .err = GULP_FILE_OK,
+        .t_kls = t_kls,
+    };
+    return GULP_FILE_OK;
+}
+
+/**
+ * Appends the passed bytes to the record being stitched, growing it geometrically in the Koliseo_Temp.
+ */
+static void kls_gulp__stream_stitch(Kls_Gulp_Stream* stream, const char* data, size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+    if (stream->stitch_len + len > stream->stitch_cap) {
+        size_t new_cap = (stream->stitch_cap > 0 ? stream->stitch_cap : stream->cap);
+        while (new_cap < stream->stitch_len + len) {
+            new_cap *= 2;
+        }
+        if (stream->stitch == NULL) {
+            stream->stitch = KLS_PUSH_ARR_T(stream->t_kls, char, new_cap);
+        } else {
+            stream->stitch = KLS_REPUSH_T(stream->t_kls, stream->stitch, char, stream->stitch_cap, new_cap);
+        }
+        if (stream->stitch == NULL) {
+            assert(0 && "Failed growing stitched record\n");
+        }
+        stream->stitch_cap = new_cap;
+    }
+    memcpy(stream->stitch + stream->stitch_len, data, len);
+    stream->stitch_len += len;
+}
+
+/**
+ * Reads the next chunk into the buffer of the passed Kls_Gulp_Stream.
+ * @return false at end of file or on read errors.
+ */
+static bool kls_gulp__stream_fill(Kls_Gulp_Stream* stream)
+{
+    for (;;) {
+#ifndef _WIN32
+        ssize_t n = read(stream->fd, stream->buf, stream->cap);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+#else
+        int n = _read(stream->fd, stream->buf, (unsigned int) stream->cap);
+#endif // _WIN32
+        stream->pos = 0;
+        if (n < 0) {
+            stream->len = 0;
+            stream->eof = true;
+            stream->err = GULP_FILE_READ_ERROR;
+            return false;
+        }
+        stream->len = n;
+        if (n == 0) {
+            stream->eof = true;
+            return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * Hands out the next record from the passed Kls_Gulp_Stream, without its delimiter.
+ * Records fully contained in a chunk are views over the chunk buffer. Records crossing chunk boundaries are stitched in the Koliseo_Temp.
+ * Notably, the returned Kstr is only valid until the next call.
+ * The last record is returned even when the file does not end with the delimiter.
+ * @param stream The Kls_Gulp_Stream at hand.
+ * @param record Pointer to the Kstr to store the record into.
+ * @return true if a record was stored, false at end of file or on errors (check stream->err).
+ */
+bool kls_gulp_stream_next(Kls_Gulp_Stream* stream, Kstr* record)
+{
+    assert(stream != NULL);
+    assert(record != NULL);
+    stream->stitch_len = 0;
+    for (;;) {
+        const char* start = stream->buf + stream->pos;
+        size_t avail = stream->len - stream->pos;
+        const char* found = memchr(start, stream->delim, avail);
+        if (found != NULL) {
+            size_t piece_len = found - start;
+            stream->pos += piece_len + 1;
+            if (stream->stitch_len == 0) {
+                *record = kstr_new(start, piece_len);
+            } else {
+                kls_gulp__stream_stitch(stream, start, piece_len);
+                *record = kstr_new(stream->stitch, stream->stitch_len);
+            }
+            return true;
+        }
+        if (stream->eof) {
+            stream->pos = stream->len;
+            if (stream->stitch_len == 0 && avail == 0) {
+                return false;
+            }
+            if (stream->stitch_len == 0) {
+                *record = kstr_new(start, avail);
+            } else {
+                kls_gulp__stream_stitch(stream, start, avail);
+                *record = kstr_new(stream->stitch, stream->stitch_len);
+            }
+            return true;
+        }
+        if (stream->stitch_len == 0) {
+            // Starting a new stitched record: rewind the Koliseo_Temp
+            Koliseo* kls = stream->t_kls->kls;
+            kls_temp_end(stream->t_kls);
+            stream->t_kls = kls_temp_start(kls);
+            stream->stitch = NULL;
+            stream->stitch_cap = 0;
+        }
+        kls_gulp__stream_stitch(stream, start, avail);
+        if (!kls_gulp__stream_fill(stream) && stream->err != GULP_FILE_OK) {
+            fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(stream->err));
+            return false;
+        }
+    }
+}
+
+/**
+ * Ends the passed Kls_Gulp_Stream, ending its Koliseo_Temp.
+ * Notably, the file descriptor is not closed, and the chunk buffer stays on the Koliseo.
+ * @param stream The Kls_Gulp_Stream at hand.
+ */
+void kls_gulp_stream_end(Kls_Gulp_Stream* stream)
+{
+    assert(stream != NULL);
+    if (stream->t_kls != NULL) {
+        kls_temp_end(stream->t_kls);
+        stream->t_kls = NULL;
+    }
+    stream->stitch = NULL;
+    stream->stitch_len = 0;
+    stream->stitch_cap = 0;
+}
+
+/**
+ * Holds the state shared by the workers of a kls_gulp_files() call.
+ */
+typedef struct Kls_Gulp_Batch_Job {
+    Kls_Gulp_Batch* batch;
+    const char** paths;
+    size_t max_size;
+    bool allow_nullchar;
+#ifndef _WIN32
+    atomic_size_t next;
+#else
+    size_t next;
+#endif // _WIN32
+} Kls_Gulp_Batch_Job;
+
+/**
+ * Holds the arguments for one worker of a kls_gulp_files() call.
+ */
+typedef struct Kls_Gulp_Batch_Worker {
+    Kls_Gulp_Batch_Job* job;
+    Koliseo* kls;
+} Kls_Gulp_Batch_Worker;
+
+/**
+ * Gulps paths picked from the shared job into the worker Koliseo, until none are left.
+ */
+static void* kls_gulp__batch_worker(void* arg)
+{
+    Kls_Gulp_Batch_Worker* worker = arg;
+    Kls_Gulp_Batch_Job* job = worker->job;
+    for (;;) {
+#ifndef _WIN32
+        size_t i = atomic_fetch_add(&job->next, 1);
+#else
+        size_t i = job->next++;
+#endif // _WIN32
+        if (i >= job->batch->count) {
+            break;
+        }
+        size_t f_size = 0;
+        Gulp_Res err = GULP_FILE_OK;
+        Kstr* res = kls_read_file_to_kstr(worker->kls, job->paths[i], &err, &f_size, job->max_size, job->allow_nullchar);
+        job->batch->results[i] = err;
+        job->batch->files[i] = (res != NULL ? *res : KSTR_NULL);
+    }
+    return NULL;
+}
+
+/**
+ * Owns the worker Koliseo of a Kls_Gulp_Batch.
+ * Allocated outside of the passed Koliseo, so that it outlives any clear or rewind until its callback runs.
+ */
+typedef struct Kls_Gulp_Batch_Arenas {
+    int workers;
+    Koliseo* arenas[];
+} Kls_Gulp_Batch_Arenas;
+
+/**
+ * Frees the worker Koliseo of a Kls_Gulp_Batch, and the Kls_Gulp_Batch_Arenas holding them. Registered with kls_on_free() by kls_gulp_files().
+ */
+static void kls_gulp__batch_free(void* ctx)
+{
+    Kls_Gulp_Batch_Arenas* owner = ctx;
+    for (int i = 0; i < owner->workers; i++) {
+        if (owner->arenas[i] != NULL) {
+            kls_free(owner->arenas[i]);
+        }
+    }
+    KLS_DEFAULT_FREEF(owner);
+}
+
+/**
+ * Gulps the passed files concurrently, with a pool of workers each reading into its own growable Koliseo.
+ * The Kls_Gulp_Batch and its result arrays are pushed on the passed Koliseo.
+ * The worker Koliseo are allocated outside of it, and freed when it is freed or cleared.
+ * Failures are reported per file in Kls_Gulp_Batch.results, and do not stop the other reads.
+ * On _WIN32, the files are gulped sequentially in a single worker.
+ * @see Kls_Gulp_Batch
+ * @param kls The Koliseo to push the results to.
+ * @param paths Array of paths to gulp.
+ * @param count Number of paths.
+ * @param workers Number of workers. When 0 or less, uses the number of online CPUs. Never more than count.
+ * @param max_size Max size allowed for each read file.
+ * @param allow_nullchar Bool to keep the contents of binary files.
+ * @return The pushed Kls_Gulp_Batch, or NULL if count was 0, a push failed or the worker Koliseo could not be tied to kls.
+ */
+Kls_Gulp_Batch* kls_gulp_files(Koliseo* kls, const char** paths, size_t count, int workers, size_t max_size, bool allow_nullchar)
+{
+    static_assert(TOT_GULP_RES == 8, "Number of Gulp_Res changed");
+    if (kls == NULL) {
+        fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(GULP_FILE_KLS_NULL));
+        return NULL;
+    }
+    if (count == 0) {
+        return NULL;
+    }
+#ifndef _WIN32
+    if (workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (cpus > 0 ? (int) cpus : 1);
+    }
+#else
+    workers = 1;
+#endif // _WIN32
+    if ((size_t) workers > count) {
+        workers = (int) count;
+    }
+    Kls_Gulp_Batch* batch = KLS_PUSH(kls, Kls_Gulp_Batch);
+    Kstr* files = KLS_PUSH_ARR(kls, Kstr, count);
+    Gulp_Res* results = KLS_PUSH_ARR(kls, Gulp_Res, count);
+    Kls_Gulp_Batch_Worker* args = KLS_PUSH_ARR(kls, Kls_Gulp_Batch_Worker, workers);
+    if (batch == NULL || files == NULL || results == NULL || args == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed pushing batch for {%zu} files.\n", __func__, count);
+        return NULL;
+    }
+    Kls_Gulp_Batch_Arenas* owner = KLS_DEFAULT_ALLOCF(sizeof(Kls_Gulp_Batch_Arenas) + sizeof(Koliseo*) * workers);
+    if (owner == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed allocating worker Koliseo for {%zu} files.\n", __func__, count);
+        return NULL;
+    }
+    owner->workers = workers;
+    KLS_Conf conf = KLS_DEFAULT_CONF;
+    conf.kls_growable = 1;
+    for (int i = 0; i < workers; i++) {
+        owner->arenas[i] = kls_new_conf_alloc_ext(KLS_GULP_BATCH_ARENA_SIZE, conf, KLS_DEFAULT_ALLOCF, KLS_DEFAULT_FREEF, NULL, NULL, 0);
+    }
+    if (!kls_on_free(kls, kls_gulp__batch_free, owner)) {
+        kls_gulp__batch_free(owner);
+        fprintf(stderr, "[ERROR] [%s()]: Failed tying worker Koliseo to Koliseo.\n", __func__);
+        return NULL;
+    }
+    Koliseo** arenas = owner->arenas;
+    *batch = (Kls_Gulp_Batch) {
+        .count = count,
+        .files = files,
+        .results = results,
+        .workers = workers,
+        .arenas = arenas,
+    };
+
+    Kls_Gulp_Batch_Job job = {
+        .batch = batch,
+        .paths = paths,
+        .max_size = max_size,
+        .allow_nullchar = allow_nullchar,
+    };
+#ifndef _WIN32
+    atomic_init(&job.next, 0);
+    pthread_t* threads = KLS_DEFAULT_ALLOCF(sizeof(pthread_t) * workers);
+    bool* started = KLS_DEFAULT_ALLOCF(sizeof(bool) * workers);
+    // The calling thread runs worker 0, and picks up all the paths if no other worker could start
+    for (int i = 1; i < workers && threads != NULL && started != NULL; i++) {
+        args[i] = (Kls_Gulp_Batch_Worker) {
+            .job = &job,
+            .kls = arenas[i],
+        };
+        started[i] = (arenas[i] != NULL && pthread_create(&threads[i], NULL, kls_gulp__batch_worker, &args[i]) == 0);
+    }
+#else
+    job.next = 0;
+#endif // _WIN32
+    args[0] = (Kls_Gulp_Batch_Worker) {
+        .job = &job,
+        .kls = arenas[0],
+    };
+    kls_gulp__batch_worker(&args[0]);
+#ifndef _WIN32
+    for (int i = 1; i < workers && threads != NULL && started != NULL; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
         }
+    }
+    KLS_DEFAULT_FREEF(threads);
+    KLS_DEFAULT_FREEF(started);
+#endif // _WIN32
+    return batch;
+}
 
-        fclose(f);
+/**
+ * Holds one submitted path of a Kls_Gulp_Async.
+ */
+typedef struct Kls_Gulp_Async_Req {
+    const char* path;
+    char* buf;
+    size_t len;
+    size_t got;
+    int fd;
+    Gulp_Res res;
+    bool pending; /**< Set until the request is handed to the backend.*/
+    size_t next_done;
+} Kls_Gulp_Async_Req;
 
-        *err = GULP_FILE_OK;
-        buffer[length] = '\0';
-        *f_size = length;
+/**
+ * Appends the passed request to the finished list of the passed Kls_Gulp_Async, checking its contents for null chars.
+ */
+static void kls_gulp__async_finish(Kls_Gulp_Async* as, size_t idx, Gulp_Res res)
+{
+    Kls_Gulp_Async_Req* req = &as->reqs[idx];
+    req->res = res;
+    if (res == GULP_FILE_OK) {
+        req->buf[req->len] = '\0';
+        if (kstr__find_byte(req->buf, req->len, '\0') < req->len) {
+            req->res = GULP_FILE_CONTAINS_NULLCHAR;
+        }
+    }
+    req->next_done = SIZE_MAX;
+    if (as->done_tail == SIZE_MAX) {
+        as->done_head = idx;
     } else {
-        *err = GULP_FILE_NOT_EXIST;
-
-        return NULL;
+        as->reqs[as->done_tail].next_done = idx;
     }
+    as->done_tail = idx;
+}
 
-    if (strlen(buffer) == length) {
-        return buffer;
-    } else {
-        *err = GULP_FILE_CONTAINS_NULLCHAR;
-        return buffer;
+/**
+ * Pops the first finished request of the passed Kls_Gulp_Async into the passed Kls_Gulp_Completion.
+ */
+static bool kls_gulp__async_pop(Kls_Gulp_Async* as, Kls_Gulp_Completion* completion)
+{
+    if (as->done_head == SIZE_MAX) {
+        return false;
+    }
+    size_t idx = as->done_head;
+    Kls_Gulp_Async_Req* req = &as->reqs[idx];
+    as->done_head = req->next_done;
+    if (as->done_head == SIZE_MAX) {
+        as->done_tail = SIZE_MAX;
     }
+    bool keep = (req->res == GULP_FILE_OK || (req->res == GULP_FILE_CONTAINS_NULLCHAR && as->allow_nullchar));
+    *completion = (Kls_Gulp_Completion) {
+        .id = idx,
+        .path = req->path,
+        .data = (keep ? kstr_new(req->buf, req->len) : KSTR_NULL),
+        .res = req->res,
+    };
+    as->delivered++;
+    return true;
 }
 
+#ifndef _WIN32
 /**
- * Tries mapping the passed file on the Koliseo.
- * Sets the passed Gulp_Res to the result of the operation, .
- * @param kls The Koliseo to push to.
- * @param filepath Path to the file to gulp.
- * @param err Pointer to the Gulp_Res variable to store result.
- * @param max_size Max size allowed for the read file.
- * @see KLS_GULP_FILE()
+ * Holds the state of the pread() thread pool backend.
  */
-char * kls_gulp_file_sized(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size)
+typedef struct Kls_Gulp_Async_Pool {
+    Kls_Gulp_Async* as;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+    pthread_t threads[KLS_GULP_ASYNC_MAX_THREADS];
+    int nthreads;
+    bool stop;
+} Kls_Gulp_Async_Pool;
+
+/**
+ * Reads requests of the Kls_Gulp_Async with pread(), until the pool is stopped.
+ */
+static void* kls_gulp__async_worker(void* arg)
 {
-    static_assert(TOT_GULP_RES == 6, "Number of Gulp_Res changed");
-    size_t f_size;
-    char * data = NULL;
-    data = kls_read_file(kls, filepath, err, &f_size, max_size);
-    if (*err != GULP_FILE_OK) {
-        switch (*err) {
-        case GULP_FILE_NOT_EXIST:
-        case GULP_FILE_TOO_LARGE:
-        case GULP_FILE_READ_ERROR:
-        case GULP_FILE_CONTAINS_NULLCHAR:
-        case GULP_FILE_KLS_NULL: {
-            fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+    Kls_Gulp_Async_Pool* pool = arg;
+    Kls_Gulp_Async* as = pool->as;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stop && as->issued == as->count) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
         }
-        break;
-        default: {
-            fprintf(stderr,"[ERROR]    %s():  Unexpected error {%i}.\n",__func__, *err);
+        if (pool->stop) {
+            break;
         }
-        break;
+        size_t idx = as->issued++;
+        if (!as->reqs[idx].pending) {
+            continue;
         }
-        if (*err != GULP_FILE_CONTAINS_NULLCHAR) return NULL;
-    } else {
-        assert(strlen(data) == f_size && "data len should be equal to f_size here!");
-        if (!data) {
-            assert(0 && "kls_read_file() failed\n");
+        as->reqs[idx].pending = false;
+        const char* path = as->reqs[idx].path;
+        char* buf = as->reqs[idx].buf;
+        size_t len = as->reqs[idx].len;
+        pthread_mutex_unlock(&pool->lock);
+
+        Gulp_Res res = GULP_FILE_OK;
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            res = GULP_FILE_NOT_EXIST;
+        } else {
+            size_t got = 0;
+            while (got < len) {
+                ssize_t n = pread(fd, buf + got, len - got, (off_t) got);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    // Read failed, or the file was truncated after submit
+                    res = GULP_FILE_READ_ERROR;
+                    break;
+                }
+                got += n;
+            }
+            close(fd);
         }
-        //printf("%s\n\n",data);
-        //printf("SIZE: {%i}\n",f_size);
+
+        pthread_mutex_lock(&pool->lock);
+        kls_gulp__async_finish(as, idx, res);
+        pthread_cond_signal(&pool->done_cv);
     }
-    return data;
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
 }
+#endif // _WIN32
 
+#ifdef KLS_GULP_HAS_URING
 /**
- * Tries mapping the passed file on the Koliseo.
- * @param kls The Koliseo to push to.
- * @param filepath Path to the file to gulp.
- * @param max_size Max size allowed for the read file.
- * @see KLS_GULP_FILE()
- * @return A pointer to the string with file contents.
+ * Holds the state of the io_uring backend, with the rings mapped from the kernel.
  */
-char * try_kls_gulp_file(Koliseo* kls, const char * filepath, size_t max_size)
+typedef struct Kls_Gulp_Async_Ring {
+    int fd;
+    void* sq_ptr;
+    size_t sq_size;
+    void* cq_ptr;
+    size_t cq_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+    unsigned to_submit;
+} Kls_Gulp_Async_Ring;
+
+static void kls_gulp__ring_free(Kls_Gulp_Async_Ring* ring)
 {
-    Gulp_Res err = -1;
-
-    char* res = kls_gulp_file_sized(kls, filepath, &err, max_size);
-
-    if (err != GULP_FILE_OK && err != GULP_FILE_CONTAINS_NULLCHAR) {
-        fprintf(stderr, "%s():  kls_gulp_file_sized() failed with err {%s}.\n",__func__,string_from_Gulp_Res(err));
-    }
-
-    return res;
+    if (ring->sqes != NULL) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ptr != NULL && ring->cq_ptr != ring->sq_ptr) munmap(ring->cq_ptr, ring->cq_size);
+    if (ring->sq_ptr != NULL) munmap(ring->sq_ptr, ring->sq_size);
+    if (ring->fd >= 0) close(ring->fd);
+    KLS_DEFAULT_FREEF(ring);
 }
 
-static Kstr * kls_read_file_to_kstr(Koliseo* kls, const char * f_name, Gulp_Res * err, size_t * f_size, ...)
+/**
+ * Sets up an io_uring with the passed number of entries.
+ * @return The new Kls_Gulp_Async_Ring, or NULL if io_uring or IORING_OP_READ are not available.
+ */
+static Kls_Gulp_Async_Ring* kls_gulp__ring_new(unsigned entries)
 {
-    if (!kls) {
-        *err = GULP_FILE_KLS_NULL;
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        return NULL;
+    }
+    Kls_Gulp_Async_Ring* ring = KLS_DEFAULT_ALLOCF(sizeof(Kls_Gulp_Async_Ring));
+    if (ring == NULL) {
+        close(fd);
+        return NULL;
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = fd;
+
+    // Plain reads need Linux 5.6
+    size_t probe_size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = KLS_DEFAULT_ALLOCF(probe_size);
+    bool has_read = false;
+    if (probe != NULL) {
+        memset(probe, 0, probe_size);
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) >= 0) {
+            has_read = (probe->last_op >= IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED));
+        }
+        KLS_DEFAULT_FREEF(probe);
+    }
+    if (!has_read) {
+        kls_gulp__ring_free(ring);
         return NULL;
     }
-    char * buffer = NULL;
-    size_t length = 0;
-    FILE * f = fopen(f_name, "rb");
-    size_t read_length;
-    bool allow_nullchar = false;
-
-    if (f) {
-        fseek(f, 0, SEEK_END);
-        length = ftell(f);
-        fseek(f, 0, SEEK_SET);
-
-        va_list args;
-        va_start(args, f_size);
-        size_t max_size = va_arg(args, size_t);
-        if (length > max_size) {
-            *err = GULP_FILE_TOO_LARGE;
 
+    ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_size = ring->cq_size = (ring->sq_size > ring->cq_size ? ring->sq_size : ring->cq_size);
+    }
+    ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ptr == MAP_FAILED) {
+        ring->sq_ptr = NULL;
+        kls_gulp__ring_free(ring);
+        return NULL;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ptr = ring->sq_ptr;
+    } else {
+        ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ptr == MAP_FAILED) {
+            ring->cq_ptr = NULL;
+            kls_gulp__ring_free(ring);
             return NULL;
         }
-        bool allow_nulls = va_arg(args, int);
-        allow_nullchar = allow_nulls;
-        va_end(args);
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        kls_gulp__ring_free(ring);
+        return NULL;
+    }
+    char* sq = ring->sq_ptr;
+    char* cq = ring->cq_ptr;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    return ring;
+}
 
-        buffer = KLS_PUSH_ARR_NAMED(kls,char,length + 1,"char*","Buffer for file gulp");
+/**
+ * Queues a read for the unread part of the passed request.
+ */
+static void kls_gulp__ring_queue(Kls_Gulp_Async_Ring* ring, Kls_Gulp_Async_Req* req, size_t idx)
+{
+    unsigned tail = *ring->sq_tail;
+    unsigned slot = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[slot];
+    size_t left = req->len - req->got;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = req->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(req->buf + req->got);
+    // Reads are capped by the kernel at about 2 GB anyway
+    sqe->len = (unsigned)(left < 0x7ffff000 ? left : 0x7ffff000);
+    sqe->off = req->got;
+    sqe->user_data = idx;
+    ring->sq_array[slot] = slot;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->to_submit++;
+}
 
-        if (buffer == NULL) {
-            assert(0 && "KLS_PUSH_NAMED() failed\n");
+/**
+ * Submits queued reads and waits for at least wait_nr completions, then handles all the available ones.
+ */
+static void kls_gulp__ring_wait(Kls_Gulp_Async* as, unsigned wait_nr)
+{
+    Kls_Gulp_Async_Ring* ring = as->backend_data;
+    int submitted = (int) syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, wait_nr, IORING_ENTER_GETEVENTS, NULL, 0);
+    if (submitted > 0) {
+        ring->to_submit -= submitted;
+    }
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+        size_t idx = cqe->user_data;
+        Kls_Gulp_Async_Req* req = &as->reqs[idx];
+        int res = cqe->res;
+        if (res == -EINTR || res == -EAGAIN) {
+            kls_gulp__ring_queue(ring, req, idx);
+            continue;
         }
-
-        if (length) {
-            read_length = fread(buffer, 1, length, f);
-
-            if (length != read_length) {
-                *err = GULP_FILE_READ_ERROR;
-                return NULL;
+        if (res > 0) {
+            req->got += res;
+            if (req->got < req->len) {
+                kls_gulp__ring_queue(ring, req, idx);
+                continue;
             }
         }
+        close(req->fd);
+        req->fd = -1;
+        as->inflight--;
+        // A zero read means the file was truncated after submit
+        kls_gulp__async_finish(as, idx, (res > 0 ? GULP_FILE_OK : GULP_FILE_READ_ERROR));
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
 
-        fclose(f);
-
-        *err = GULP_FILE_OK;
-        buffer[length] = '\0';
-        *f_size = length;
-    } else {
-        *err = GULP_FILE_NOT_EXIST;
-
-        return NULL;
+/**
+ * Opens and queues submitted requests, up to the depth of the passed Kls_Gulp_Async.
+ */
+static void kls_gulp__ring_issue(Kls_Gulp_Async* as)
+{
+    Kls_Gulp_Async_Ring* ring = as->backend_data;
+    while (as->inflight < as->depth && as->issued < as->count) {
+        size_t idx = as->issued++;
+        Kls_Gulp_Async_Req* req = &as->reqs[idx];
+        if (!req->pending) {
+            continue;
+        }
+        req->pending = false;
+        req->fd = open(req->path, O_RDONLY);
+        if (req->fd < 0) {
+            kls_gulp__async_finish(as, idx, GULP_FILE_NOT_EXIST);
+            continue;
+        }
+        as->inflight++;
+        kls_gulp__ring_queue(ring, req, idx);
     }
+}
+#endif // KLS_GULP_HAS_URING
 
-    if (strlen(buffer) == length) {
-    } else {
-        *err = GULP_FILE_CONTAINS_NULLCHAR;
-        if (!allow_nullchar) {
-            return NULL;
+/**
+ * Starts the passed Kls_Gulp_Async, setting up the requested backend.
+ * @see Kls_Gulp_Async
+ * @param as The Kls_Gulp_Async to start.
+ * @param kls The Koliseo to push file buffers to.
+ * @param backend The requested Kls_Gulp_Async_Backend. io_uring falls back to the thread pool when it is not available.
+ * @param depth Max number of reads in flight. When 0, KLS_GULP_ASYNC_DEPTH is used.
+ * @param max_size Max size allowed for each read file.
+ * @param allow_nullchar Bool to keep the contents of binary files.
+ * @return GULP_FILE_OK on success, GULP_FILE_KLS_NULL if the Koliseo was NULL, GULP_FILE_READ_ERROR if no backend could start.
+ */
+Gulp_Res kls_gulp_async_start(Kls_Gulp_Async* as, Koliseo* kls, Kls_Gulp_Async_Backend backend, unsigned depth, size_t max_size, bool allow_nullchar)
+{
+    assert(as != NULL);
+    memset(as, 0, sizeof(*as));
+    if (kls == NULL) {
+        return GULP_FILE_KLS_NULL;
+    }
+    *as = (Kls_Gulp_Async) {
+        .kls = kls,
+        .max_size = max_size,
+        .allow_nullchar = allow_nullchar,
+        .depth = (depth > 0 ? depth : KLS_GULP_ASYNC_DEPTH),
+        .done_head = SIZE_MAX,
+        .done_tail = SIZE_MAX,
+    };
+#ifdef KLS_GULP_HAS_URING
+    if (backend != KLS_GULP_ASYNC_THREADS) {
+        as->backend_data = kls_gulp__ring_new(as->depth);
+        if (as->backend_data != NULL) {
+            as->backend = KLS_GULP_ASYNC_URING;
+            return GULP_FILE_OK;
         }
     }
-    Kstr * res = KLS_PUSH_NAMED(kls,Kstr,"Kstr","Kstr for file gulp");
-    if (res == NULL) {
-        assert(0 && "KLS_PUSH_NAMED() failed\n");
+#else
+    (void) backend;
+#endif // KLS_GULP_HAS_URING
+    as->backend = KLS_GULP_ASYNC_THREADS;
+#ifndef _WIN32
+    Kls_Gulp_Async_Pool* pool = KLS_DEFAULT_ALLOCF(sizeof(Kls_Gulp_Async_Pool));
+    if (pool == NULL) {
+        return GULP_FILE_READ_ERROR;
     }
-    res->data = buffer;
-    if (*err == GULP_FILE_CONTAINS_NULLCHAR) {
-        res->len = length;
-    } else {
-        res->len = strlen(buffer);
+    pool->as = as;
+    pool->stop = false;
+    pool->nthreads = 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+    int nthreads = (as->depth < KLS_GULP_ASYNC_MAX_THREADS ? (int) as->depth : KLS_GULP_ASYNC_MAX_THREADS);
+    for (int i = 0; i < nthreads; i++) {
+        if (pthread_create(&pool->threads[pool->nthreads], NULL, kls_gulp__async_worker, pool) == 0) {
+            pool->nthreads++;
+        }
     }
-    return res;
+    as->backend_data = pool;
+    if (pool->nthreads == 0) {
+        kls_gulp_async_end(as);
+        return GULP_FILE_READ_ERROR;
+    }
+#endif // _WIN32
+    return GULP_FILE_OK;
 }
 
 /**
- * Tries mapping the passed file on the Koliseo.
- * Sets the passed Gulp_Res to the result of the operation.
- * @param kls The Koliseo to push to.
- * @param filepath Path to the file to gulp.
- * @param err Pointer to the Gulp_Res variable to store result.
- * @param max_size Max size allowed for the read file.
- * @param allow_nullchar Bool to avoid returning NULL for a binary file.
- * @see KLS_GULP_FILE()
- * @return A Kstr for the passed filepath contents.
+ * Submits the passed path to the passed Kls_Gulp_Async.
+ * The file is sized and its buffer pushed on the Koliseo right away, so that sizing failures are reported as completions without any read.
+ * @see kls_gulp_async_next()
+ * @param as The Kls_Gulp_Async at hand.
+ * @param path Path to the file to gulp. Must stay valid until its completion is returned.
+ * @param id Pointer to store the id of the request into, matching Kls_Gulp_Completion.id. Can be NULL.
+ * @return true if the path was queued, false if the request could not be stored.
  */
-Kstr * kls_gulp_file_sized_to_kstr(Koliseo* kls, const char * filepath, Gulp_Res * err, size_t max_size, bool allow_nullchar)
+bool kls_gulp_async_submit(Kls_Gulp_Async* as, const char* path, size_t* id)
 {
-    static_assert(TOT_GULP_RES == 6, "Number of Gulp_Res changed");
-    size_t f_size;
-    Kstr * data = NULL;
-    data = kls_read_file_to_kstr(kls, filepath, err, &f_size, max_size, allow_nullchar);
-    if (*err != GULP_FILE_OK) {
-        switch (*err) {
-        case GULP_FILE_NOT_EXIST:
-        case GULP_FILE_TOO_LARGE:
-        case GULP_FILE_READ_ERROR:
-        case GULP_FILE_CONTAINS_NULLCHAR:
-        case GULP_FILE_KLS_NULL: {
-            fprintf(stderr,"[ERROR]    %s():  {" Gulp_Res_Fmt "}.\n",__func__, Gulp_Res_Arg(*err));
+    assert(as != NULL);
+    Gulp_Res res = GULP_FILE_OK;
+    char* buf = NULL;
+    size_t len = 0;
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        res = GULP_FILE_NOT_EXIST;
+    } else if ((size_t) st.st_size > as->max_size) {
+        res = GULP_FILE_TOO_LARGE;
+    } else {
+        len = st.st_size;
+        buf = KLS_PUSH_ARR_NAMED(as->kls, char, len + 1, "char*", "Buffer for async file gulp");
+        if (buf == NULL) {
+            res = GULP_FILE_KLS_PUSH_FAILED;
         }
-        break;
-        default: {
-            fprintf(stderr,"[ERROR]    %s():  Unexpected error {%i}.\n",__func__, *err);
+    }
+#ifndef _WIN32
+    Kls_Gulp_Async_Pool* pool = (as->backend == KLS_GULP_ASYNC_THREADS ? as->backend_data : NULL);
+    if (pool != NULL) {
+        pthread_mutex_lock(&pool->lock);
+    }
+#endif // _WIN32
+    bool ok = true;
+    if (as->count == as->cap) {
+        size_t new_cap = (as->cap > 0 ? as->cap * 2 : 64);
+        Kls_Gulp_Async_Req* reqs = realloc(as->reqs, new_cap * sizeof(Kls_Gulp_Async_Req));
+        if (reqs == NULL) {
+            ok = false;
+        } else {
+            as->reqs = reqs;
+            as->cap = new_cap;
         }
-        break;
+    }
+    if (ok) {
+        size_t idx = as->count;
+        as->reqs[idx] = (Kls_Gulp_Async_Req) {
+            .path = path,
+            .buf = buf,
+            .len = len,
+            .got = 0,
+            .fd = -1,
+            .res = res,
+            .pending = true,
+            .next_done = SIZE_MAX,
+        };
+        if (id != NULL) {
+            *id = idx;
         }
-        return data;
-    } else {
-        assert(data->len == f_size && "data len should be equal to f_size here!");
-        if (!data) {
-            assert(0 && "kls_read_file_to_kstr() failed\n");
+        as->count++;
+        if (res != GULP_FILE_OK || len == 0 || as->backend_data == NULL) {
+            // Nothing for the backend to read
+            as->reqs[idx].pending = false;
+            if (res == GULP_FILE_OK && len > 0) {
+                FILE* f = fopen(path, "rb");
+                res = (f != NULL && fread(buf, 1, len, f) == len ? GULP_FILE_OK : GULP_FILE_READ_ERROR);
+                if (f != NULL) fclose(f);
+            }
+            kls_gulp__async_finish(as, idx, res);
         }
-        //printf("%s\n\n",data->data);
-        //printf("SIZE: {%i}\n",f_size);
     }
-    return data;
+#ifndef _WIN32
+    if (pool != NULL) {
+        pthread_cond_signal(&pool->work_cv);
+        pthread_cond_signal(&pool->done_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+#endif // _WIN32
+    return ok;
 }
 
 /**
- * Tries mapping the passed file on the Koliseo.
- * @param kls The Koliseo to push to.
- * @param filepath Path to the file to gulp.
- * @param max_size Max size allowed for the read file.
- * @param allow_nullchar Boolean to avoid returning NULL for a binary file.
- * @see KLS_GULP_FILE()
- * @return A pointer to the Kstr with file contents.
+ * Returns the next finished read of the passed Kls_Gulp_Async, waiting for one if needed.
+ * Completions come in finishing order, not in submit order.
+ * @see Kls_Gulp_Completion
+ * @param as The Kls_Gulp_Async at hand.
+ * @param completion Pointer to the Kls_Gulp_Completion to set.
+ * @return true if a completion was set, false when all submitted paths were already returned.
  */
-Kstr * try_kls_gulp_file_to_kstr(Koliseo* kls, const char * filepath, size_t max_size, bool allow_nullchar)
+bool kls_gulp_async_next(Kls_Gulp_Async* as, Kls_Gulp_Completion* completion)
 {
-    Gulp_Res err = -1;
-
-    Kstr * res = NULL;
-    res = kls_gulp_file_sized_to_kstr(kls, filepath, &err, max_size, allow_nullchar);
-
-    if (err != GULP_FILE_OK) {
-        fprintf(stderr, "%s():  kls_gulp_file_sized_to_kstr() failed with err {%s}.\n",__func__,string_from_Gulp_Res(err));
+    assert(as != NULL);
+    assert(completion != NULL);
+#ifdef KLS_GULP_HAS_URING
+    if (as->backend == KLS_GULP_ASYNC_URING) {
+        for (;;) {
+            if (kls_gulp__async_pop(as, completion)) {
+                return true;
+            }
+            if (as->delivered == as->count) {
+                return false;
+            }
+            kls_gulp__ring_issue(as);
+            if (as->done_head == SIZE_MAX) {
+                kls_gulp__ring_wait(as, 1);
+            }
+        }
+    }
+#endif // KLS_GULP_HAS_URING
+#ifndef _WIN32
+    Kls_Gulp_Async_Pool* pool = as->backend_data;
+    if (pool != NULL) {
+        pthread_mutex_lock(&pool->lock);
+        while (as->done_head == SIZE_MAX && as->delivered < as->count) {
+            pthread_cond_wait(&pool->done_cv, &pool->lock);
+        }
+        bool res = kls_gulp__async_pop(as, completion);
+        pthread_mutex_unlock(&pool->lock);
+        return res;
     }
+#endif // _WIN32
+    return kls_gulp__async_pop(as, completion);
+}
 
-    return res;
+/**
+ * Ends the passed Kls_Gulp_Async, waiting for reads in flight and tearing down its backend.
+ * Notably, file buffers stay on the Koliseo, and undelivered completions are dropped.
+ * @param as The Kls_Gulp_Async at hand.
+ */
+void kls_gulp_async_end(Kls_Gulp_Async* as)
+{
+    assert(as != NULL);
+#ifdef KLS_GULP_HAS_URING
+    if (as->backend == KLS_GULP_ASYNC_URING && as->backend_data != NULL) {
+        // The kernel may still be writing to the buffers
+        while (as->inflight > 0) {
+            kls_gulp__ring_wait(as, 1);
+        }
+        kls_gulp__ring_free(as->backend_data);
+        as->backend_data = NULL;
+    }
+#endif // KLS_GULP_HAS_URING
+#ifndef _WIN32
+    if (as->backend == KLS_GULP_ASYNC_THREADS && as->backend_data != NULL) {
+        Kls_Gulp_Async_Pool* pool = as->backend_data;
+        pthread_mutex_lock(&pool->lock);
+        pool->stop = true;
+        pthread_cond_broadcast(&pool->work_cv);
+        pthread_mutex_unlock(&pool->lock);
+        for (int i = 0; i < pool->nthreads; i++) {
+            pthread_join(pool->threads[i], NULL);
+        }
+        pthread_cond_destroy(&pool->done_cv);
+        pthread_cond_destroy(&pool->work_cv);
+        pthread_mutex_destroy(&pool->lock);
+        KLS_DEFAULT_FREEF(pool);
+        as->backend_data = NULL;
+    }
+#endif // _WIN32
+    free(as->reqs);
+    as->reqs = NULL;
+    as->count = as->cap = as->issued = as->delivered = 0;
+    as->done_head = as->done_tail = SIZE_MAX;
 }
 
 #endif // KLS_GULP_IMPLEMENTATION
@@ -250,10 +250,8 @@ KLS_Region_List kls_rl_t_cons(Koliseo_Temp *t_kls, KLS_list_element e,
  */
 void kls_rl_freeList(KLS_Region_List l)
 {
-    if (kls_rl_empty(l)) {
-        return;
-    } else {
-        kls_rl_freeList(kls_rl_tail(l));
+    while (!kls_rl_empty(l)) {
+        KLS_Region_List next = kls_rl_tail(l);
 #ifdef KLS_DEBUG_CORE
         fprintf(stderr, "[KLS]    %s(): Freeing KLS_Region_List->value.\n",
                 __func__);
@@ -263,6 +261,7 @@ void kls_rl_freeList(KLS_Region_List l)
         fprintf(stderr, "[KLS]    %s(): Freeing KLS_Region_List.\n", __func__);
 #endif
         free(l);
+        l = next;
     }
     return;
 }
@@ -313,24 +312,45 @@ void kls_rl_showList(KLS_Region_List l)
 
 bool kls_rl_member(KLS_list_element el, KLS_Region_List l)
 {
-    if (kls_rl_empty(l)) {
-        return false;
-    } else {
+    while (!kls_rl_empty(l)) {
         if (el == kls_rl_head(l)) {
             return true;
-        } else {
-            return kls_rl_member(el, kls_rl_tail(l));
         }
+        l = kls_rl_tail(l);
     }
+    return false;
 }
 
 int kls_rl_length(KLS_Region_List l)
 {
-    if (kls_rl_empty(l)) {
-        return 0;
-    } else {
-        return 1 + kls_rl_length(kls_rl_tail(l));
+    int res = 0;
+    while (!kls_rl_empty(l)) {
+        res++;
+        l = kls_rl_tail(l);
     }
+    return res;
+}
+
+/**
+ * Copies the nodes of the passed list into a new list, stopping at the passed node (excluded), and links rest after the last copied node.
+ * Used internally to build lists front-to-back without recursion.
+ * @param kls The Koliseo used to allocate the new nodes.
+ * @param l The list to copy from.
+ * @param stop The first node not to copy. Pass NULL to copy the whole list.
+ * @param rest The list to link after the copied nodes.
+ * @return The resulting list.
+ */
+static KLS_Region_List kls_rl__copy_until(Koliseo *kls, KLS_Region_List l, KLS_Region_List stop, KLS_Region_List rest)
+{
+    KLS_Region_List res = kls_rl_emptyList();
+    KLS_Region_List *last = &res;
+    while (!kls_rl_empty(l) && l != stop) {
+        *last = kls_rl_cons(kls, kls_rl_head(l), kls_rl_emptyList());
+        last = &((*last)->next);
+        l = kls_rl_tail(l);
+    }
+    *last = rest;
+    return res;
 }
 
 KLS_Region_List kls_rl_append(Koliseo *kls, KLS_Region_List l1, KLS_Region_List l2)
@@ -339,11 +359,7 @@ KLS_Region_List kls_rl_append(Koliseo *kls, KLS_Region_List l1, KLS_Region_List
         fprintf(stderr, "[ERROR]  [%s()]: Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    if (kls_rl_empty(l1)) {
-        return l2;
-    } else {
-        return kls_rl_cons(kls, kls_rl_head(l1), kls_rl_append(kls, kls_rl_tail(l1), l2));
-    }
+    return kls_rl__copy_until(kls, l1, NULL, l2);
 }
 
 KLS_Region_List kls_rl_reverse(Koliseo *kls, KLS_Region_List l)
@@ -352,12 +368,12 @@ KLS_Region_List kls_rl_reverse(Koliseo *kls, KLS_Region_List l)
         fprintf(stderr, "[ERROR]  [%s()]: Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    if (kls_rl_empty(l)) {
-        return kls_rl_emptyList();
-    } else {
-        return kls_rl_append(kls, kls_rl_reverse(kls, kls_rl_tail(l)),
-                             kls_rl_cons(kls, kls_rl_head(l), kls_rl_emptyList()));
+    KLS_Region_List res = kls_rl_emptyList();
+    while (!kls_rl_empty(l)) {
+        res = kls_rl_cons(kls, kls_rl_head(l), res);
+        l = kls_rl_tail(l);
     }
+    return res;
 }
 
 KLS_Region_List kls_rl_copy(Koliseo *kls, KLS_Region_List l)
@@ -366,11 +382,7 @@ KLS_Region_List kls_rl_copy(Koliseo *kls, KLS_Region_List l)
         fprintf(stderr, "[ERROR]  [%s()]: Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    if (kls_rl_empty(l)) {
-        return l;
-    } else {
-        return kls_rl_cons(kls, kls_rl_head(l), kls_rl_copy(kls, kls_rl_tail(l)));
-    }
+    return kls_rl__copy_until(kls, l, NULL, kls_rl_emptyList());
 }
 
 KLS_Region_List kls_rl_delete(Koliseo *kls, KLS_list_element el, KLS_Region_List l)
@@ -379,15 +391,14 @@ KLS_Region_List kls_rl_delete(Koliseo *kls, KLS_list_element el, KLS_Region_List
         fprintf(stderr, "[ERROR]  [%s()]: Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    if (kls_rl_empty(l)) {
-        return kls_rl_emptyList();
-    } else {
-        if (el == kls_rl_head(l)) {
-            return kls_rl_tail(l);
-        } else {
-            return kls_rl_cons(kls, kls_rl_head(l), kls_rl_delete(kls, el, kls_rl_tail(l)));
-        }
+    KLS_Region_List found = l;
+    while (!kls_rl_empty(found) && kls_rl_head(found) != el) {
+        found = kls_rl_tail(found);
+    }
+    if (kls_rl_empty(found)) {
+        return kls_rl_copy(kls, l);
     }
+    return kls_rl__copy_until(kls, l, found, kls_rl_tail(found));
 }
 
 KLS_Region_List kls_rl_insord(Koliseo *kls, KLS_list_element el, KLS_Region_List l)
@@ -396,16 +407,12 @@ KLS_Region_List kls_rl_insord(Koliseo *kls, KLS_list_element el, KLS_Region_List
         fprintf(stderr, "[ERROR]  [%s()]: Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    if (kls_rl_empty(l)) {
-        return kls_rl_cons(kls, el, l);
-    } else {
-        //Insert KLS_list_element according to its begin_offset
-        if (el->begin_offset <= kls_rl_head(l)->begin_offset) {
-            return kls_rl_cons(kls, el, l);
-        } else {
-            return kls_rl_cons(kls, kls_rl_head(l), kls_rl_insord(kls, el, kls_rl_tail(l)));
-        }
+    //Insert KLS_list_element according to its begin_offset
+    KLS_Region_List pos = l;
+    while (!kls_rl_empty(pos) && el->begin_offset > kls_rl_head(pos)->begin_offset) {
+        pos = kls_rl_tail(pos);
     }
+    return kls_rl__copy_until(kls, l, pos, kls_rl_cons(kls, el, pos));
 }
 
 KLS_Region_List kls_rl_insord_p(Koliseo *kls, KLS_list_element el,
@@ -508,27 +515,114 @@ KLS_Region_List kls_rl_mergeList(Koliseo *kls, KLS_Region_List l1,
         fprintf(stderr, "[ERROR]  [%s()]: Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    if (kls_rl_empty(l1)) {
-        return l2;
-    } else {
-        if (kls_rl_empty(l2)) {
-            return l1;
+    KLS_Region_List res = kls_rl_emptyList();
+    KLS_Region_List *last = &res;
+    while (!kls_rl_empty(l1) && !kls_rl_empty(l2)) {
+        KLS_list_element el = NULL;
+        if (kls_rl_isLess(kls_rl_head(l1), kls_rl_head(l2))) {
+            el = kls_rl_head(l1);
+            l1 = kls_rl_tail(l1);
+        } else if (kls_rl_isEqual(kls_rl_head(l1), kls_rl_head(l2))) {
+            el = kls_rl_head(l1);
+            l1 = kls_rl_tail(l1);
+            l2 = kls_rl_tail(l2);
         } else {
-            if (kls_rl_isLess(kls_rl_head(l1), kls_rl_head(l2))) {
-                return kls_rl_cons(kls, kls_rl_head(l1),
-                                   kls_rl_mergeList(kls, kls_rl_tail(l1), l2));
-            } else {
-                if (kls_rl_isEqual(kls_rl_head(l1), kls_rl_head(l2))) {
-                    return kls_rl_cons(kls, kls_rl_head(l1),
-                                       kls_rl_mergeList(kls, kls_rl_tail(l1),
-                                                        kls_rl_tail(l2)));
-                } else {
-                    return kls_rl_cons(kls, kls_rl_head(l2),
-                                       kls_rl_mergeList(kls, l1, kls_rl_tail(l2)));
-                }
-            }
+            el = kls_rl_head(l2);
+            l2 = kls_rl_tail(l2);
+        }
+        *last = kls_rl_cons(kls, el, kls_rl_emptyList());
+        last = &((*last)->next);
+    }
+    *last = (kls_rl_empty(l1) ? l2 : l1);
+    return res;
+}
+
+/**
+ * Pairs a KLS_Region pointer with its position in a KLS_Region_List.
+ * Used internally by kls_rl__filter().
+ */
+typedef struct KLS_RL_Pos {
+    KLS_list_element el;
+    ptrdiff_t idx;
+} KLS_RL_Pos;
+
+static int kls_rl__ptr_cmp(const void *a, const void *b)
+{
+    uintptr_t pa = (uintptr_t) *(const KLS_list_element *)a;
+    uintptr_t pb = (uintptr_t) *(const KLS_list_element *)b;
+    return (pa > pb) - (pa < pb);
+}
+
+static int kls_rl__pos_cmp(const void *a, const void *b)
+{
+    const KLS_RL_Pos *pa = a;
+    const KLS_RL_Pos *pb = b;
+    int res = kls_rl__ptr_cmp(&pa->el, &pb->el);
+    if (res != 0) {
+        return res;
+    }
+    return (pa->idx > pb->idx) - (pa->idx < pb->idx);
+}
+
+/**
+ * Builds a new list with the elements of l1 whose membership in l2 matches keep_members, keeping only the last occurrence of each element of l1.
+ * Runs in O((n + m) log (n + m)) instead of the quadratic member() walks, using a scratch buffer from KLS_DEFAULT_ALLOCF.
+ * @param kls The Koliseo used to allocate the new nodes.
+ * @param l1 The list to filter.
+ * @param l2 The list to check membership against.
+ * @param keep_members When true, keep elements found in l2. When false, keep elements not found in l2.
+ * @return The resulting list, preserving the order of l1.
+ */
+static KLS_Region_List kls_rl__filter(Koliseo *kls, KLS_Region_List l1, KLS_Region_List l2, bool keep_members)
+{
+    ptrdiff_t n1 = kls_rl_length(l1);
+    ptrdiff_t n2 = kls_rl_length(l2);
+    size_t scratch_size = n1 * (sizeof(KLS_RL_Pos) + sizeof(bool)) + n2 * sizeof(KLS_list_element);
+    char *scratch = KLS_DEFAULT_ALLOCF(scratch_size);
+    if (scratch == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: Failed allocating scratch buffer.\n", __func__);
+        kls_free(kls);
+        exit(EXIT_FAILURE);
+    }
+    KLS_RL_Pos *pos = (KLS_RL_Pos *) scratch;
+    KLS_list_element *others = (KLS_list_element *) (scratch + n1 * sizeof(KLS_RL_Pos));
+    bool *keep = (bool *) (scratch + n1 * sizeof(KLS_RL_Pos) + n2 * sizeof(KLS_list_element));
+
+    ptrdiff_t i = 0;
+    for (KLS_Region_List it = l1; !kls_rl_empty(it); it = kls_rl_tail(it), i++) {
+        pos[i] = (KLS_RL_Pos) {
+            .el = kls_rl_head(it),
+            .idx = i,
+        };
+        keep[i] = false;
+    }
+    i = 0;
+    for (KLS_Region_List it = l2; !kls_rl_empty(it); it = kls_rl_tail(it), i++) {
+        others[i] = kls_rl_head(it);
+    }
+    qsort(pos, n1, sizeof(KLS_RL_Pos), kls_rl__pos_cmp);
+    qsort(others, n2, sizeof(KLS_list_element), kls_rl__ptr_cmp);
+
+    for (i = 0; i < n1; i++) {
+        if (i + 1 < n1 && pos[i + 1].el == pos[i].el) {
+            // Not the last occurrence in l1
+            continue;
+        }
+        bool is_member = (bsearch(&pos[i].el, others, n2, sizeof(KLS_list_element), kls_rl__ptr_cmp) != NULL);
+        keep[pos[i].idx] = (is_member == keep_members);
+    }
+
+    KLS_Region_List res = kls_rl_emptyList();
+    KLS_Region_List *last = &res;
+    i = 0;
+    for (KLS_Region_List it = l1; !kls_rl_empty(it); it = kls_rl_tail(it), i++) {
+        if (keep[i]) {
+            *last = kls_rl_cons(kls, kls_rl_head(it), kls_rl_emptyList());
+            last = &((*last)->next);
         }
     }
+    KLS_DEFAULT_FREEF(scratch);
+    return res;
 }
 
 KLS_Region_List kls_rl_intersect(Koliseo *kls, KLS_Region_List l1,
@@ -541,15 +635,7 @@ KLS_Region_List kls_rl_intersect(Koliseo *kls, KLS_Region_List l1,
     if (kls_rl_empty(l1) || kls_rl_empty(l2)) {
         return kls_rl_emptyList();
     }
-
-    if (kls_rl_member(kls_rl_head(l1), l2) && !kls_rl_member(kls_rl_head(l1), kls_rl_tail(l1))) {
-        return kls_rl_cons(kls, kls_rl_head(l1),
-                           kls_rl_intersect(kls, kls_rl_tail(l1), l2));
-    }
-
-    else {
-        return kls_rl_intersect(kls, kls_rl_tail(l1), l2);
-    }
+    return kls_rl__filter(kls, l1, l2, true);
 }
 
 KLS_Region_List kls_rl_diff(Koliseo *kls, KLS_Region_List l1, KLS_Region_List l2)
@@ -561,15 +647,190 @@ KLS_Region_List kls_rl_diff(Koliseo *kls, KLS_Region_List l1, KLS_Region_List l2
     if (kls_rl_empty(l1) || kls_rl_empty(l2)) {
         return l1;
     }
+    return kls_rl__filter(kls, l1, l2, false);
+}
+
+/**
+ * Returns a KLS_Region_Array holding the elements of the passed list, in list order.
+ * The array is allocated from the passed Koliseo_Temp.
+ * @param t_kls The Koliseo_Temp to allocate the array in.
+ * @param l The KLS_Region_List to read.
+ * @return The new KLS_Region_Array. Its regs field is NULL when the list is empty.
+ */
+KLS_Region_Array kls_ra_from_list(Koliseo_Temp *t_kls, KLS_Region_List l)
+{
+    if (t_kls == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: Koliseo_Temp was NULL.\n", __func__);
+        exit(EXIT_FAILURE);
+    }
+    KLS_Region_Array res = {0};
+    ptrdiff_t len = kls_rl_length(l);
+    if (len == 0) {
+        return res;
+    }
+    res.regs = KLS_PUSH_ARR_T(t_kls, KLS_list_element, len);
+    if (res.regs == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: Failed pushing array.\n", __func__);
+        return res;
+    }
+    for (; !kls_rl_empty(l); l = kls_rl_tail(l)) {
+        res.regs[res.count++] = kls_rl_head(l);
+    }
+    return res;
+}
+
+/**
+ * Total order used by the KLS_Region_Array functions: begin_offset, then end_offset, then address.
+ * Two regions compare equal only when they are the same pointer.
+ */
+static int kls_ra__cmp(const void *a, const void *b)
+{
+    const KLS_Region *r1 = *(const KLS_list_element *)a;
+    const KLS_Region *r2 = *(const KLS_list_element *)b;
+    if (r1->begin_offset != r2->begin_offset) {
+        return (r1->begin_offset > r2->begin_offset) - (r1->begin_offset < r2->begin_offset);
+    }
+    if (r1->end_offset != r2->end_offset) {
+        return (r1->end_offset > r2->end_offset) - (r1->end_offset < r2->end_offset);
+    }
+    return kls_rl__ptr_cmp(a, b);
+}
+
+/**
+ * Sorts the passed KLS_Region_Array in place by begin_offset, then end_offset, and drops duplicate pointers.
+ * The result is the set representation expected by kls_ra_merge(), kls_ra_intersect() and kls_ra_diff().
+ * @param ra The KLS_Region_Array to sort.
+ */
+void kls_ra_sort(KLS_Region_Array *ra)
+{
+    if (ra == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: KLS_Region_Array was NULL.\n", __func__);
+        exit(EXIT_FAILURE);
+    }
+    if (ra->count < 2) {
+        return;
+    }
+    qsort(ra->regs, ra->count, sizeof(KLS_list_element), kls_ra__cmp);
+    ptrdiff_t w = 1;
+    for (ptrdiff_t i = 1; i < ra->count; i++) {
+        if (ra->regs[i] != ra->regs[w - 1]) {
+            ra->regs[w++] = ra->regs[i];
+        }
+    }
+    ra->count = w;
+}
 
-    else {
-        if (!kls_rl_member(kls_rl_head(l1), l2)
-            && !kls_rl_member(kls_rl_head(l1), kls_rl_tail(l1))) {
-            return kls_rl_cons(kls, kls_rl_head(l1), kls_rl_diff(kls, kls_rl_tail(l1), l2));
+typedef enum KLS_RA_Op {
+    KLS_RA_UNION = 0,
+    KLS_RA_INTERSECT,
+    KLS_RA_DIFF,
+} KLS_RA_Op;
+
+static inline void kls_ra__emit(KLS_list_element *dest, ptrdiff_t *n, KLS_list_element el)
+{
+    if (dest != NULL) {
+        dest[*n] = el;
+    }
+    (*n)++;
+}
+
+/**
+ * Walks two sorted KLS_Region_Array and collects the elements selected by op into dest, if not NULL.
+ * @return The number of selected elements.
+ */
+static ptrdiff_t kls_ra__combine(KLS_Region_Array a, KLS_Region_Array b, KLS_RA_Op op, KLS_list_element *dest)
+{
+    ptrdiff_t i = 0, j = 0, n = 0;
+    while (i < a.count && j < b.count) {
+        int cmp = kls_ra__cmp(&a.regs[i], &b.regs[j]);
+        if (cmp < 0) {
+            if (op != KLS_RA_INTERSECT) {
+                kls_ra__emit(dest, &n, a.regs[i]);
+            }
+            i++;
+        } else if (cmp > 0) {
+            if (op == KLS_RA_UNION) {
+                kls_ra__emit(dest, &n, b.regs[j]);
+            }
+            j++;
         } else {
-            return kls_rl_diff(kls, kls_rl_tail(l1), l2);
+            if (op != KLS_RA_DIFF) {
+                kls_ra__emit(dest, &n, a.regs[i]);
+            }
+            i++;
+            j++;
+        }
+    }
+    if (op != KLS_RA_INTERSECT) {
+        for (; i < a.count; i++) {
+            kls_ra__emit(dest, &n, a.regs[i]);
+        }
+    }
+    if (op == KLS_RA_UNION) {
+        for (; j < b.count; j++) {
+            kls_ra__emit(dest, &n, b.regs[j]);
         }
     }
+    return n;
+}
+
+static KLS_Region_Array kls_ra__build(const char *caller, Koliseo_Temp *t_kls, KLS_Region_Array a, KLS_Region_Array b, KLS_RA_Op op)
+{
+    if (t_kls == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: Koliseo_Temp was NULL.\n", caller);
+        exit(EXIT_FAILURE);
+    }
+    KLS_Region_Array res = {0};
+    ptrdiff_t n = kls_ra__combine(a, b, op, NULL);
+    if (n == 0) {
+        return res;
+    }
+    res.regs = KLS_PUSH_ARR_T(t_kls, KLS_list_element, n);
+    if (res.regs == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: Failed pushing array.\n", caller);
+        return res;
+    }
+    res.count = kls_ra__combine(a, b, op, res.regs);
+    return res;
+}
+
+/**
+ * Returns the union of two sorted KLS_Region_Array, allocated from the passed Koliseo_Temp.
+ * Both inputs must have been prepared with kls_ra_sort(). The result is sorted too.
+ * @param t_kls The Koliseo_Temp to allocate the result in.
+ * @param a The first sorted KLS_Region_Array.
+ * @param b The second sorted KLS_Region_Array.
+ * @return The resulting KLS_Region_Array.
+ */
+KLS_Region_Array kls_ra_merge(Koliseo_Temp *t_kls, KLS_Region_Array a, KLS_Region_Array b)
+{
+    return kls_ra__build(__func__, t_kls, a, b, KLS_RA_UNION);
+}
+
+/**
+ * Returns the regions found in both sorted KLS_Region_Array, allocated from the passed Koliseo_Temp.
+ * Both inputs must have been prepared with kls_ra_sort(). The result is sorted too.
+ * @param t_kls The Koliseo_Temp to allocate the result in.
+ * @param a The first sorted KLS_Region_Array.
+ * @param b The second sorted KLS_Region_Array.
+ * @return The resulting KLS_Region_Array.
+ */
+KLS_Region_Array kls_ra_intersect(Koliseo_Temp *t_kls, KLS_Region_Array a, KLS_Region_Array b)
+{
+    return kls_ra__build(__func__, t_kls, a, b, KLS_RA_INTERSECT);
+}
+
+/**
+ * Returns the regions of the first sorted KLS_Region_Array not found in the second one, allocated from the passed Koliseo_Temp.
+ * Both inputs must have been prepared with kls_ra_sort(). The result is sorted too.
+ * @param t_kls The Koliseo_Temp to allocate the result in.
+ * @param a The sorted KLS_Region_Array to filter.
+ * @param b The sorted KLS_Region_Array of regions to exclude.
+ * @return The resulting KLS_Region_Array.
+ */
+KLS_Region_Array kls_ra_diff(Koliseo_Temp *t_kls, KLS_Region_Array a, KLS_Region_Array b)
+{
+    return kls_ra__build(__func__, t_kls, a, b, KLS_RA_DIFF);
 }
 
 /**
@@ -731,6 +992,172 @@ ptrdiff_t kls_total_padding(Koliseo * kls)
     return res;
 }
 
+static void kls__export_put_le(unsigned char *dest, uint64_t val, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        dest[i] = (unsigned char)(val >> (8 * i));
+    }
+}
+
+/**
+ * Writes a single region map record to the passed file, in the passed format.
+ * @see kls_export_regions_toFile()
+ */
+static int kls__export_record(FILE *fp, KLS_Region_Export_Format fmt, char kind, int block, ptrdiff_t offset, ptrdiff_t size, ptrdiff_t padding, int type, const char *name)
+{
+    switch (fmt) {
+    case KLS_REGION_EXPORT_CSV: {
+        fprintf(fp, "%c,%i,%td,%td,%td,%i,\"", kind, block, offset, size, padding, type);
+        for (const char *c = name; *c != '\0'; c++) {
+            if (*c == '"') {
+                fputc('"', fp);
+            }
+            fputc(*c, fp);
+        }
+        fprintf(fp, "\"\n");
+    }
+    break;
+    case KLS_REGION_EXPORT_BIN: {
+        unsigned char rec[KLS_REGION_EXPORT_BIN_RECORD_SIZE] = {0};
+        rec[0] = (unsigned char) kind;
+        kls__export_put_le(rec + 1, (uint32_t) block, 4);
+        kls__export_put_le(rec + 5, (uint64_t) offset, 8);
+        kls__export_put_le(rec + 13, (uint64_t) size, 8);
+        kls__export_put_le(rec + 21, (uint64_t) padding, 8);
+        kls__export_put_le(rec + 29, (uint32_t) type, 4);
+        strncpy((char *) rec + 33, name, KLS_REGION_MAX_NAME_SIZE);
+        if (fwrite(rec, sizeof(rec), 1, fp) != 1) {
+            return -1;
+        }
+    }
+    break;
+    default: {
+        return -1;
+    }
+    break;
+    }
+    return 0;
+}
+
+/**
+ * Writes records for the passed KLS_Region_List, oldest region first.
+ * @see kls_export_regions_toFile()
+ */
+static int kls__export_reglist(FILE *fp, KLS_Region_Export_Format fmt, char kind, KLS_Region_List l)
+{
+    ptrdiff_t len = kls_rl_length(l);
+    if (len == 0) {
+        return 0;
+    }
+    KLS_list_element *regs = KLS_DEFAULT_ALLOCF(len * sizeof(KLS_list_element));
+    if (regs == NULL) {
+        fprintf(stderr, "[ERROR]  [%s()]: Failed allocating scratch buffer.\n", __func__);
+        return -1;
+    }
+    for (ptrdiff_t i = len - 1; i >= 0; i--, l = kls_rl_tail(l)) {
+        regs[i] = kls_rl_head(l);
+    }
+    int res = 0;
+    for (ptrdiff_t i = 0; i < len && res == 0; i++) {
+        KLS_Region *r = regs[i];
+        res = kls__export_record(fp, fmt, kind, r->block, r->begin_offset, r->size, r->padding, r->type, r->name);
+    }
+    KLS_DEFAULT_FREEF(regs);
+    return res;
+}
+
+/**
+ * Writes the region map of the passed Koliseo to the passed file.
+ * Every Koliseo in the growable chain gets a KLS_REGION_EXPORT_BLOCK record, with offset set to its used bytes and size set to its capacity.
+ * Every KLS_Region gets a KLS_REGION_EXPORT_REGION record (or KLS_REGION_EXPORT_TEMP_REGION, for the ones of an active Koliseo_Temp).
+ * Region offset and size include the leading padding, so the data starts at offset + padding.
+ * CSV output starts with a header line. Binary output starts with KLS_REGION_EXPORT_BIN_MAGIC, a 4-byte record count and the 4-byte size of the record name field, followed by fixed-size little-endian records.
+ * @param kls The Koliseo to export.
+ * @param fp The file to write to.
+ * @param fmt The KLS_Region_Export_Format to use.
+ * @return 0 on success, -1 on errors.
+ * @see scripts/kls_regionmap.py
+ */
+int kls_export_regions_toFile(Koliseo *kls, FILE *fp, KLS_Region_Export_Format fmt)
+{
+    if (kls == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed Koliseo was NULL.\n", __func__);
+        return -1;
+    }
+    if (fp == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed file was NULL.\n", __func__);
+        return -1;
+    }
+    if (fmt != KLS_REGION_EXPORT_CSV && fmt != KLS_REGION_EXPORT_BIN) {
+        fprintf(stderr, "[ERROR] [%s()]: Unexpected KLS_Region_Export_Format value: {%i}.\n", __func__, fmt);
+        return -1;
+    }
+    KLS_Autoregion_Extension_Data *data_pt = (KLS_Autoregion_Extension_Data*) kls->extension_data[KLS_AUTOREGION_EXT_SLOT];
+    if (data_pt == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed Koliseo has no autoregion extension data.\n", __func__);
+        return -1;
+    }
+    KLS_Region_List t_regs = (kls->has_temp == 1 ? data_pt->t_regs : kls_rl_emptyList());
+
+    if (fmt == KLS_REGION_EXPORT_CSV) {
+        fprintf(fp, "kind,block,offset,size,padding,type,name\n");
+    } else {
+        uint32_t tot_records = kls_rl_length(data_pt->regs) + kls_rl_length(t_regs);
+        for (Koliseo *current = kls; current != NULL; current = current->next) {
+            tot_records++;
+        }
+        unsigned char header[KLS_REGION_EXPORT_BIN_HEADER_SIZE] = {0};
+        memcpy(header, KLS_REGION_EXPORT_BIN_MAGIC, 8);
+        kls__export_put_le(header + 8, tot_records, 4);
+        kls__export_put_le(header + 12, KLS_REGION_MAX_NAME_SIZE + 1, 4);
+        if (fwrite(header, sizeof(header), 1, fp) != 1) {
+            fprintf(stderr, "[ERROR] [%s()]: Failed writing header.\n", __func__);
+            return -1;
+        }
+    }
+
+    int block = 0;
+    for (Koliseo *current = kls; current != NULL; current = current->next, block++) {
+        if (kls__export_record(fp, fmt, KLS_REGION_EXPORT_BLOCK, block, current->offset, current->size, 0, KLS_None, "KLS_Block") != 0) {
+            fprintf(stderr, "[ERROR] [%s()]: Failed writing block record.\n", __func__);
+            return -1;
+        }
+    }
+    if (kls__export_reglist(fp, fmt, KLS_REGION_EXPORT_REGION, data_pt->regs) != 0
+        || kls__export_reglist(fp, fmt, KLS_REGION_EXPORT_TEMP_REGION, t_regs) != 0) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed writing region records.\n", __func__);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Writes the region map of the passed Koliseo to the file at the passed path.
+ * @param kls The Koliseo to export.
+ * @param path The path of the file to write, which is truncated.
+ * @param fmt The KLS_Region_Export_Format to use.
+ * @return 0 on success, -1 on errors.
+ * @see kls_export_regions_toFile()
+ */
+int kls_export_regions(Koliseo *kls, const char *path, KLS_Region_Export_Format fmt)
+{
+    if (path == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed path was NULL.\n", __func__);
+        return -1;
+    }
+    FILE *fp = fopen(path, (fmt == KLS_REGION_EXPORT_BIN ? "wb" : "w"));
+    if (fp == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed opening {\"%s\"}.\n", __func__, path);
+        return -1;
+    }
+    int res = kls_export_regions_toFile(kls, fp, fmt);
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed fclose() on {\"%s\"}.\n", __func__, path);
+        return -1;
+    }
+    return res;
+}
+
 /**
  * Calcs the max number of possible KLS_PUSH ops when using KLS_BASIC reglist alloc backend.
  * @return The max number of push ops possible, or -1 in case of error.
@@ -861,10 +1288,17 @@ static inline void kls__autoregion(const char* caller, Koliseo* kls, ptrdiff_t p
         }
         break;
         }
-        reg->begin_offset = kls->prev_offset;
-        reg->end_offset = kls->offset;
+        int block = 0;
+        Koliseo* current = kls;
+        while (current->next != NULL) {
+            current = current->next;
+            block++;
+        }
+        reg->begin_offset = current->prev_offset;
+        reg->end_offset = current->offset;
         reg->size = reg->end_offset - reg->begin_offset;
         reg->padding = padding;
+        reg->block = block;
         reg->type = region_type;
         strncpy(reg->name, region_name,
                 name_len);
@@ -942,10 +1376,17 @@ static inline void kls__temp_autoregion(const char* caller, Koliseo_Temp* t_kls,
         }
         break;
         }
-        reg->begin_offset = kls->prev_offset;
-        reg->end_offset = kls->offset;
+        int block = 0;
+        Koliseo* current = kls;
+        while (current->next != NULL) {
+            current = current->next;
+            block++;
+        }
+        reg->begin_offset = current->prev_offset;
+        reg->end_offset = current->offset;
         reg->size = reg->end_offset - reg->begin_offset;
         reg->padding = padding;
+        reg->block = block;
         reg->type = KLS_None;
         strncpy(reg->name, region_name,
                 name_len);
@@ -1184,6 +1625,7 @@ void KLS_autoregion_on_new(struct Koliseo* kls)
             kls_header->end_offset - kls_header->begin_offset;
         kls_header->padding = 0;
         kls_header->type = KLS_Header;
+        kls_header->block = 0;
         strncpy(kls_header->name, "KLS_Header", KLS_REGION_MAX_NAME_SIZE);
         kls_header->name[KLS_REGION_MAX_NAME_SIZE] = '\0';
         strncpy(kls_header->desc, "Sizeof Koliseo header",
@@ -1297,6 +1739,11 @@ void KLS_autoregion_on_temp_start(struct Koliseo_Temp* t_kls)
             temp_kls_header->end_offset - temp_kls_header->begin_offset;
         //TODO Padding??
         temp_kls_header->type = Temp_KLS_Header;
+        int block = 0;
+        for (Koliseo* current = kls; current != t_kls->block; current = current->next) {
+            block++;
+        }
+        temp_kls_header->block = block;
         strncpy(temp_kls_header->name, "T_KLS_Header",
                 KLS_REGION_MAX_NAME_SIZE);
         temp_kls_header->name[KLS_REGION_MAX_NAME_SIZE] = '\0';
@@ -112,6 +112,7 @@ typedef struct KLS_Region {
     char name[KLS_REGION_MAX_NAME_SIZE + 1];   /**< Name field for the KLS_Region.*/
     char desc[KLS_REGION_MAX_DESC_SIZE + 1];   /**< Description field for the KLS_Region.*/
     int type;	  /**< Used to identify which type the KLS_Region holds.*/
+    int block;	  /**< Index of the Koliseo holding the KLS_Region, in the growable chain starting from the passed one.*/
 } KLS_Region;
 
 static const char KOLISEO_DEFAULT_REGION_NAME[] = "No Name"; /**< Represents default Region name, used for kls_push_zero().*/
@@ -271,6 +272,21 @@ KLS_Region_List kls_rl_intersect(Koliseo *, KLS_Region_List, KLS_Region_List);
 KLS_Region_List kls_rl_diff(Koliseo *, KLS_Region_List, KLS_Region_List);
 
 #define KLS_RL_DIFF(kls,kls_list1,kls_list2) kls_rl_diff(kls,kls_list1,kls_list2)
+
+/**
+ * Defines a flat view over a set of KLS_Region pointers.
+ * Used by the kls_ra_*() functions, which allocate from a Koliseo_Temp and run in O(n log n).
+ */
+typedef struct KLS_Region_Array {
+    KLS_list_element *regs; /**< Array of region pointers.*/
+    ptrdiff_t count; /**< Number of items in regs.*/
+} KLS_Region_Array;
+
+KLS_Region_Array kls_ra_from_list(Koliseo_Temp *, KLS_Region_List);
+void kls_ra_sort(KLS_Region_Array *);
+KLS_Region_Array kls_ra_merge(Koliseo_Temp *, KLS_Region_Array, KLS_Region_Array);
+KLS_Region_Array kls_ra_intersect(Koliseo_Temp *, KLS_Region_Array, KLS_Region_Array);
+KLS_Region_Array kls_ra_diff(Koliseo_Temp *, KLS_Region_Array, KLS_Region_Array);
 double kls_usageShare(KLS_list_element, Koliseo *);
 ptrdiff_t kls_regionSize(KLS_list_element);
 ptrdiff_t kls_avg_regionSize(Koliseo *);
@@ -278,4 +294,28 @@ void kls_usageReport_toFile(Koliseo *, FILE *);
 void kls_usageReport(Koliseo *);
 ptrdiff_t kls_type_usage(int, Koliseo *);
 ptrdiff_t kls_total_padding(Koliseo *);
+
+typedef enum KLS_Region_Export_Format {
+    KLS_REGION_EXPORT_CSV = 0,
+    KLS_REGION_EXPORT_BIN,
+} KLS_Region_Export_Format;
+
+#define KLS_REGION_EXPORT_BLOCK 'B' /**< Record kind for a Koliseo in the growable chain.*/
+#define KLS_REGION_EXPORT_REGION 'R' /**< Record kind for a KLS_Region.*/
+#define KLS_REGION_EXPORT_TEMP_REGION 'T' /**< Record kind for a KLS_Region of the active Koliseo_Temp.*/
+
+#define KLS_REGION_EXPORT_BIN_MAGIC "KLSRMAP1" /**< Leading 8 bytes of a binary region map.*/
+
+/**
+ * Size of a binary region map header: magic (8), record count (4), record name size (4).
+ */
+#define KLS_REGION_EXPORT_BIN_HEADER_SIZE 16
+
+/**
+ * Size of a binary region map record: kind (1), block (4), offset (8), size (8), padding (8), type (4), name (KLS_REGION_MAX_NAME_SIZE + 1).
+ */
+#define KLS_REGION_EXPORT_BIN_RECORD_SIZE (33 + KLS_REGION_MAX_NAME_SIZE + 1)
+
+int kls_export_regions_toFile(Koliseo *, FILE *, KLS_Region_Export_Format);
+int kls_export_regions(Koliseo *, const char *, KLS_Region_Export_Format);
 int kls_get_maxRegions_KLS_BASIC(Koliseo *kls);
@@ -575,6 +575,7 @@ Koliseo *kls_new_alloc_ext_dbg(ptrdiff_t size, kls_alloc_func alloc_func, kls_fr
             }
         }
         kls->free_func = free_func;
+        kls->free_cbs = NULL;
         kls->next = NULL;
 #ifdef KLS_DEBUG_CORE
         kls_log(kls, "KLS", "API Level { %i } ->  Allocated (%s) for new KLS.",
@@ -1147,11 +1148,11 @@ KLS_Push_Result kls__advance_dbg(Koliseo* kls, ptrdiff_t size, ptrdiff_t align,
 
     KLS_ASAN_UNPOISON(p, size * count);
 
-    char h_size[200];
-    kls_formatSize(size * count, h_size, sizeof(h_size));
     //sprintf(msg,"Pushed zeroes, size (%li) for KLS.",size);
     //kls_log("KLS",msg);
 #ifdef KLS_DEBUG_CORE
+    char h_size[200];
+    kls_formatSize(size * count, h_size, sizeof(h_size));
     kls_log(current, "KLS", "Curr offset: { %p }.", current + current->offset);
     kls_log(current, "KLS", "API Level { %i } -> Pushed zeroes, size (%s) for KLS.",
             int_koliseo_version(), h_size);
@@ -1236,7 +1237,8 @@ KLS_Push_Error kls__check_available_failable_dbg(Koliseo* kls, ptrdiff_t size, p
         if (count > PTRDIFF_MAX / size) {
             return KLS_PUSH_PTRDIFF_MAX;
         } else {
-            if (current->conf.kls_growable == 1 && kls__try_grow(current, size + count + padding)) {
+            // The grown block also holds its own Koliseo header, plus any alignment padding
+            if (current->conf.kls_growable == 1 && kls__try_grow(current, size * count + align + (ptrdiff_t) sizeof(Koliseo))) {
                 return KLS_PUSH_OK;
             }
             return KLS_PUSH_OOM;
@@ -1307,11 +1309,11 @@ KLS_Push_Result kls__temp_advance_dbg(Koliseo_Temp* kls_t, ptrdiff_t size, ptrdi
 
     KLS_ASAN_UNPOISON(p, size * count);
 
-    char h_size[200];
-    kls_formatSize(size * count, h_size, sizeof(h_size));
     //sprintf(msg,"Pushed zeroes, size (%li) for KLS.",size);
     //kls_log("KLS",msg);
 #ifdef KLS_DEBUG_CORE
+    char h_size[200];
+    kls_formatSize(size * count, h_size, sizeof(h_size));
     if (current->conf.kls_collect_stats == 1) {
 #ifndef _WIN32
         clock_gettime(CLOCK_MONOTONIC, &end_time);	// %.9f
@@ -1348,7 +1350,8 @@ KLS_Push_Result kls__temp_advance_dbg(Koliseo_Temp* kls_t, ptrdiff_t size, ptrdi
 bool kls__try_grow(Koliseo* kls, ptrdiff_t needed)
 {
     ptrdiff_t new_size = KLS_MAX(kls->size * 2, needed);
-    Koliseo* new_kls = kls_new_conf_alloc_ext(new_size, kls->conf, KLS_DEFAULT_ALLOCF, KLS_DEFAULT_FREEF, kls->hooks, kls->extension_data, kls->hooks_len);
+    // Grown blocks get no hooks: push paths run the hooks of the first Koliseo in the chain, which keeps the extension data.
+    Koliseo* new_kls = kls_new_conf_alloc_ext(new_size, kls->conf, KLS_DEFAULT_ALLOCF, KLS_DEFAULT_FREEF, NULL, NULL, 0);
     kls_log(kls, "DEBUG", "%s(): growing Koliseo, new size: {%td}", __func__, new_size);
     if (!new_kls) return false;
     kls->next = new_kls;
@@ -1441,13 +1444,9 @@ void *kls_push_zero_ext_dbg(Koliseo *kls, ptrdiff_t size, ptrdiff_t align,
     //Zero new area
     memset(p, 0, size * count);
 
-    Koliseo* current = kls;
-    while (current->next != NULL) {
-        current = current->next;
-    }
-
-    for (size_t i=0; i < current->hooks_len; i++) {
-        if (current->hooks[i].on_push_handler != NULL) {
+    // Hooks live on the first Koliseo of the chain, grown blocks have none.
+    for (size_t i=0; i < kls->hooks_len; i++) {
+        if (kls->hooks[i].on_push_handler != NULL) {
             /*
             struct KLS_EXTENSION_AR_DEFAULT_ARGS {
                 const char* region_name;
@@ -1465,7 +1464,7 @@ void *kls_push_zero_ext_dbg(Koliseo *kls, ptrdiff_t size, ptrdiff_t align,
             };
             kls->hooks.on_push_handler(kls, padding, (void*)&ar_args);
             */
-            current->hooks[i].on_push_handler(current, padding, __func__, NULL);
+            kls->hooks[i].on_push_handler(kls, padding, __func__, NULL);
         }
     }
     return p;
@@ -1479,13 +1478,27 @@ char* kls_vsprintf_dbg(Koliseo* kls, Koliseo_Loc loc, const char* fmt, va_list a
 {
     va_list args_copy;
     va_copy(args_copy, args);
-    int len = vsnprintf(NULL, 0, fmt, args);
+    // Short results are formatted once, on the stack, then copied
+    char small[KLS_SPRINTF_STACK_SIZE];
+    int len = vsnprintf(small, sizeof(small), fmt, args);
+    if (len < 0) {
+        va_end(args_copy);
+        return NULL;
+    }
 #ifndef KOLISEO_HAS_LOCATE
     char* str = KLS_PUSH_ARR(kls, char, len+1);
 #else
     char* str = kls_push_zero_ext_dbg(kls, sizeof(char), KLS_ALIGNOF(char), len+1, loc);
 #endif // KOLISEO_HAS_LOCATE
-    vsnprintf(str, len+1, fmt, args_copy);
+    if (str == NULL) {
+        va_end(args_copy);
+        return NULL;
+    }
+    if ((size_t) len < sizeof(small)) {
+        memcpy(str, small, len+1);
+    } else {
+        vsnprintf(str, len+1, fmt, args_copy);
+    }
     va_end(args_copy);
     return str;
 }
@@ -1513,6 +1526,190 @@ char* kls_sprintf_dbg(Koliseo* kls, Koliseo_Loc loc, const char* fmt, ...)
     return str;
 }
 
+/**
+ * Returns the last Koliseo of the growable chain starting at the passed one.
+ */
+static Koliseo* kls__tail(Koliseo* kls)
+{
+    while (kls->next != NULL) {
+        kls = kls->next;
+    }
+    return kls;
+}
+
+/**
+ * Makes sure the passed Kls_StrBuf has at least need bytes pushed.
+ * Extends in place when data ends at the tail of the last Koliseo with enough room, and moves it to a new push otherwise.
+ */
+static bool kls__strbuf_reserve(Kls_StrBuf* sb, ptrdiff_t need)
+{
+    if (need <= sb->cap) {
+        return true;
+    }
+    Koliseo* tail = kls__tail(sb->kls);
+    ptrdiff_t room = tail->size - tail->offset;
+    if (sb->data != NULL && tail == sb->block && tail->data + tail->offset == sb->data + sb->cap && room >= need - sb->cap) {
+        ptrdiff_t grow = KLS_MAX(need - sb->cap, KLS_STRBUF_MIN_GROW);
+        grow = KLS_MIN(grow, room);
+        // Byte aligned, so the push lands right after data
+        char* p = kls_push(sb->kls, sizeof(char), KLS_ALIGNOF(char), grow);
+        if (p == NULL) {
+            return false;
+        }
+        assert(p == sb->data + sb->cap);
+        sb->cap += grow;
+        return true;
+    }
+    ptrdiff_t new_cap = KLS_MAX(need, KLS_MAX(sb->cap * 2, KLS_STRBUF_MIN_GROW));
+    char* p = kls_push(sb->kls, sizeof(char), KLS_ALIGNOF(char), new_cap);
+    if (p == NULL) {
+        return false;
+    }
+    if (sb->len > 0) {
+        memcpy(p, sb->data, sb->len);
+    }
+    sb->data = p;
+    sb->cap = new_cap;
+    sb->block = kls__tail(sb->kls);
+    return true;
+}
+
+/**
+ * Starts the passed Kls_StrBuf on the passed Koliseo, pushing cap bytes right away.
+ * @see Kls_StrBuf
+ * @param sb The Kls_StrBuf to start.
+ * @param kls The Koliseo to build the string on.
+ * @param cap Starting capacity. When less than 1, KLS_STRBUF_MIN_GROW is used.
+ * @return true on success, false if the push failed.
+ */
+bool kls_strbuf_start(Kls_StrBuf* sb, Koliseo* kls, ptrdiff_t cap)
+{
+    if (sb == NULL || kls == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed %s was NULL.\n", __func__, (sb == NULL ? "Kls_StrBuf" : "Koliseo"));
+        return false;
+    }
+    *sb = (Kls_StrBuf) {
+        .kls = kls,
+        .block = NULL,
+        .data = NULL,
+        .len = 0,
+        .cap = 0,
+    };
+    return kls__strbuf_reserve(sb, (cap > 0 ? cap : KLS_STRBUF_MIN_GROW));
+}
+
+/**
+ * Appends len bytes to the passed Kls_StrBuf.
+ * @param sb The Kls_StrBuf at hand.
+ * @param bytes The bytes to append.
+ * @param len Number of bytes to append.
+ * @return true on success, false if a push failed.
+ */
+bool kls_strbuf_append(Kls_StrBuf* sb, const char* bytes, ptrdiff_t len)
+{
+    assert(sb != NULL);
+    if (len <= 0) {
+        return true;
+    }
+    if (!kls__strbuf_reserve(sb, sb->len + len + 1)) {
+        return false;
+    }
+    memcpy(sb->data + sb->len, bytes, len);
+    sb->len += len;
+    return true;
+}
+
+/**
+ * Appends the passed cstring to the passed Kls_StrBuf.
+ * @param sb The Kls_StrBuf at hand.
+ * @param cstr The cstring to append.
+ * @return true on success, false if a push failed.
+ */
+bool kls_strbuf_append_str(Kls_StrBuf* sb, const char* cstr)
+{
+    return kls_strbuf_append(sb, cstr, strlen(cstr));
+}
+
+/**
+ * Appends formatted text to the passed Kls_StrBuf.
+ * Formats once straight into the free capacity, and formats again only if the result did not fit.
+ * @param sb The Kls_StrBuf at hand.
+ * @param fmt The format cstring.
+ * @param args The va_list for fmt.
+ * @return true on success, false if formatting or a push failed.
+ */
+bool kls_strbuf_vappendf(Kls_StrBuf* sb, const char* fmt, va_list args)
+{
+    assert(sb != NULL);
+    va_list args_copy;
+    va_copy(args_copy, args);
+    ptrdiff_t avail = sb->cap - sb->len;
+    int len = vsnprintf(sb->data + sb->len, avail, fmt, args);
+    if (len < 0) {
+        va_end(args_copy);
+        return false;
+    }
+    if (len >= avail) {
+        if (!kls__strbuf_reserve(sb, sb->len + len + 1)) {
+            va_end(args_copy);
+            return false;
+        }
+        vsnprintf(sb->data + sb->len, len + 1, fmt, args_copy);
+    }
+    va_end(args_copy);
+    sb->len += len;
+    return true;
+}
+
+/**
+ * Appends formatted text to the passed Kls_StrBuf.
+ * @see kls_strbuf_vappendf()
+ * @param sb The Kls_StrBuf at hand.
+ * @param fmt The format cstring.
+ * @return true on success, false if formatting or a push failed.
+ */
+bool kls_strbuf_appendf(Kls_StrBuf* sb, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    bool res = kls_strbuf_vappendf(sb, fmt, args);
+    va_end(args);
+    return res;
+}
+
+/**
+ * Finishes the passed Kls_StrBuf, terminating the built string where it lies.
+ * If it is still the last allocation and the Koliseo has no extensions, the unused capacity is given back.
+ * The Kls_StrBuf can be started again afterwards.
+ * @param sb The Kls_StrBuf at hand.
+ * @param len Pointer to store the length of the built string into. Can be NULL.
+ * @return The built cstring, or NULL if no capacity was ever pushed.
+ */
+char* kls_strbuf_finish(Kls_StrBuf* sb, ptrdiff_t* len)
+{
+    assert(sb != NULL);
+    if (sb->data == NULL) {
+        return NULL;
+    }
+    sb->data[sb->len] = '\0';
+    Koliseo* block = sb->block;
+    // Extensions recorded the pushes, so the offset is only rewound without them
+    if (sb->kls->hooks_len == 0 && block->data + block->offset == sb->data + sb->cap) {
+        ptrdiff_t unused = sb->cap - sb->len - 1;
+        block->offset -= unused;
+        KLS_ASAN_POISON(block->data + block->offset, unused);
+    }
+    if (len != NULL) {
+        *len = sb->len;
+    }
+    char* res = sb->data;
+    sb->data = NULL;
+    sb->block = NULL;
+    sb->len = 0;
+    sb->cap = 0;
+    return res;
+}
+
 /**
  * Takes a Koliseo_Temp, and ptrdiff_t values for size, align and count. Tries pushing the specified amount of memory to the referred Koliseo data field, or goes to exit() if the operation fails.
  * Notably, it zeroes the memory region.
@@ -1545,15 +1742,10 @@ void *kls_temp_push_zero_ext_dbg(Koliseo_Temp *t_kls, ptrdiff_t size,
     memset(res.p, 0, size * count);
 
     Koliseo* kls = t_kls->kls;
-    Koliseo* current = kls;
-    while (current->next != NULL) {
-        current = current->next;
-    }
-
-    for (size_t i=0; i < current->hooks_len; i++) {
-        if (current->hooks[i].on_temp_push_handler != NULL) {
+    for (size_t i=0; i < kls->hooks_len; i++) {
+        if (kls->hooks[i].on_temp_push_handler != NULL) {
             // Call on_temp_push extension with empty user arg
-            current->hooks[i].on_temp_push_handler(t_kls, padding, __func__, NULL);
+            kls->hooks[i].on_temp_push_handler(t_kls, padding, __func__, NULL);
         }
     }
     return res.p;
@@ -1567,13 +1759,27 @@ char* kls_temp_vsprintf_dbg(Koliseo_Temp* kls_t, Koliseo_Loc loc, const char* fm
 {
     va_list args_copy;
     va_copy(args_copy, args);
-    int len = vsnprintf(NULL, 0, fmt, args);
+    // Short results are formatted once, on the stack, then copied
+    char small[KLS_SPRINTF_STACK_SIZE];
+    int len = vsnprintf(small, sizeof(small), fmt, args);
+    if (len < 0) {
+        va_end(args_copy);
+        return NULL;
+    }
 #ifndef KOLISEO_HAS_LOCATE
     char* str = KLS_PUSH_ARR_T(kls_t, char, len+1);
 #else
     char* str = kls_temp_push_zero_ext_dbg(kls_t, sizeof(char), KLS_ALIGNOF(char), len+1, loc);
 #endif // KOLISEO_HAS_LOCATE
-    vsnprintf(str, len+1, fmt, args_copy);
+    if (str == NULL) {
+        va_end(args_copy);
+        return NULL;
+    }
+    if ((size_t) len < sizeof(small)) {
+        memcpy(str, small, len+1);
+    } else {
+        vsnprintf(str, len+1, fmt, args_copy);
+    }
     va_end(args_copy);
     return str;
 }
@@ -1899,7 +2105,7 @@ void print_temp_kls_2file(FILE *fp, const Koliseo_Temp *t_kls)
     } else if (t_kls->kls == NULL) {
         fprintf(fp, "[KLS_T] [%s()]: Referred Koliseo was NULL.\n", __func__);
     } else {
-        const Koliseo *kls = t_kls->kls;
+        const Koliseo *kls = t_kls->block;
         fprintf(fp, "\n[KLS_T] API Level: { %i }\n", int_koliseo_version());
         fprintf(fp, "\n[KLS_T] Temp Size: { %td }\n",
                 kls->size - t_kls->offset);
@@ -1956,9 +2162,26 @@ void kls_formatSize(ptrdiff_t size, char *outputBuffer, size_t bufferSize)
     snprintf(outputBuffer, bufferSize, "%.2f %s", sizeValue, units[unitIndex]);
 }
 
+/**
+ * Runs and drops the callbacks registered on the passed Koliseo after the passed one, most recent first.
+ * @param kls The Koliseo at hand.
+ * @param until The first callback to keep, or NULL to run all of them.
+ * @see kls_on_free()
+ */
+static void kls__run_free_cbs(Koliseo *kls, KLS_Free_Cb_Node *until)
+{
+    while (kls->free_cbs != NULL && kls->free_cbs != until) {
+        KLS_Free_Cb_Node* node = kls->free_cbs;
+        kls->free_cbs = node->next;
+        node->cb(node->ctx);
+        KLS_DEFAULT_FREEF(node);
+    }
+}
+
 /**
  * Resets the offset field for the passed Koliseo pointer.
  * Notably, it sets the prev_offset field to the previous offset, thus remembering where last allocation was before the clear.
+ * Runs and drops the callbacks registered with kls_on_free(), since their ctx may live in the cleared memory.
  * @param kls The Koliseo at hand.
  */
 void kls_clear(Koliseo *kls)
@@ -1967,6 +2190,7 @@ void kls_clear(Koliseo *kls)
         fprintf(stderr, "[ERROR] [%s()]: Passed Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
+    kls__run_free_cbs(kls, NULL);
     //Reset pointer
     kls->prev_offset = kls->offset;
     kls->offset = sizeof(*kls);
@@ -1992,13 +2216,8 @@ void kls_free(Koliseo *kls)
     while (current) {
         Koliseo* next = current->next;
         current->next = NULL;
-        for (size_t i=0; i < current->hooks_len; i++) {
-            if (current->hooks[i].on_free_handler != NULL) {
-                // Call on_free() extension
-                current->hooks[i].on_free_handler(current);
-            }
-        }
         if (current->has_temp == 1) {
+            // Ended before the on_free hooks, which may free the data used by on_temp_free
 #ifdef KLS_DEBUG_CORE
             kls_log(current, "KLS",
                     "API Level { %i } -> KLS had an active Koliseo_Temp.",
@@ -2006,6 +2225,13 @@ void kls_free(Koliseo *kls)
 #endif
             kls_temp_end(current->t_kls);
         }
+        for (size_t i=0; i < current->hooks_len; i++) {
+            if (current->hooks[i].on_free_handler != NULL) {
+                // Call on_free() extension
+                current->hooks[i].on_free_handler(current);
+            }
+        }
+        kls__run_free_cbs(current, NULL);
         kls_clear(current);
 #ifdef KLS_DEBUG_CORE
         kls_log(current, "KLS", "API Level { %i } -> Freeing KLS.",
@@ -2041,6 +2267,39 @@ void kls_free(Koliseo *kls)
     }
 }
 
+/**
+ * Registers a callback to be run when the passed Koliseo is freed by kls_free() or cleared by kls_clear().
+ * Callbacks registered while a Koliseo_Temp is active instead run when it ends with kls_temp_end().
+ * Callbacks run after the on_free hooks, in reverse order of registration.
+ * Useful to tie the lifetime of external resources (e.g. a file mapping) to a Koliseo.
+ * @param kls The Koliseo at hand.
+ * @param cb The callback to run.
+ * @param ctx The argument to pass to cb.
+ * @return true on success, false if the callback could not be registered.
+ * @see kls_free()
+ */
+bool kls_on_free(Koliseo *kls, KLS_free_cb *cb, void* ctx)
+{
+    if (kls == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed Koliseo was NULL.\n", __func__);
+        exit(EXIT_FAILURE);
+    }
+    if (cb == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Passed callback was NULL.\n", __func__);
+        return false;
+    }
+    KLS_Free_Cb_Node* node = KLS_DEFAULT_ALLOCF(sizeof(KLS_Free_Cb_Node));
+    if (node == NULL) {
+        fprintf(stderr, "[ERROR] [%s()]: Failed allocating callback node.\n", __func__);
+        return false;
+    }
+    node->cb = cb;
+    node->ctx = ctx;
+    node->next = kls->free_cbs;
+    kls->free_cbs = node;
+    return true;
+}
+
 /**
  * Starts a new savestate for the passed Koliseo pointer, by initialising its Koliseo_Temp pointer and returning it.
  * Notably, you should not use the original while using the copy.
@@ -2058,45 +2317,48 @@ Koliseo_Temp *kls_temp_start_dbg(Koliseo *kls, Koliseo_Loc loc)
         fprintf(stderr, "[ERROR] [%s()]: Passed Koliseo was NULL.\n", __func__);
         exit(EXIT_FAILURE);
     }
-    Koliseo* current = kls;
-    while (current->next != NULL) {
-        current = current->next;
-    }
-    if (current->has_temp != 0) {
+    if (kls->has_temp != 0) {
         fprintf(stderr,
                 "[ERROR] [%s()]: Passed Koliseo->has_temp is not 0. {%i}\n",
-                __func__, current->has_temp);
+                __func__, kls->has_temp);
 #ifdef KLS_DEBUG_CORE
-        kls_log(current, "ERROR", "[%s()]: Passed Koliseo->has_temp != 0 . {%i}",
-                __func__, current->has_temp);
+        kls_log(kls, "ERROR", "[%s()]: Passed Koliseo->has_temp != 0 . {%i}",
+                __func__, kls->has_temp);
 #endif
-        if (current->conf.kls_collect_stats == 1) {
-            current->stats.tot_hiccups += 1;
+        if (kls->conf.kls_collect_stats == 1) {
+            kls->stats.tot_hiccups += 1;
         }
         return NULL;
     }
+    // The offsets are saved on the last block, hooks and temp state stay on the first one
+    Koliseo* current = kls;
+    while (current->next != NULL) {
+        current = current->next;
+    }
     ptrdiff_t prev = current->prev_offset;
     ptrdiff_t off = current->offset;
 
     Koliseo_Temp *tmp = KLS_PUSH(current, Koliseo_Temp);
-    tmp->kls = current;
+    tmp->kls = kls;
+    tmp->block = current;
+    tmp->free_cbs = kls->free_cbs;
     tmp->prev_offset = prev;
     tmp->offset = off;
 #ifdef KLS_DEBUG_CORE
-    kls_log(current, "INFO", "Passed kls conf: " KLS_Conf_Fmt "\n",
-            KLS_Conf_Arg(current->conf));
+    kls_log(kls, "INFO", "Passed kls conf: " KLS_Conf_Fmt "\n",
+            KLS_Conf_Arg(kls->conf));
 #endif
 
-    current->has_temp = 1;
-    current->t_kls = tmp;
-    for (size_t i=0; i < current->hooks_len; i++) {
-        if (current->hooks[i].on_temp_start_handler != NULL) {
+    kls->has_temp = 1;
+    kls->t_kls = tmp;
+    for (size_t i=0; i < kls->hooks_len; i++) {
+        if (kls->hooks[i].on_temp_start_handler != NULL) {
             // Call on_temp_start extension
-            current->hooks[i].on_temp_start_handler(tmp);
+            kls->hooks[i].on_temp_start_handler(tmp);
         }
     }
 #ifdef KLS_DEBUG_CORE
-    kls_log(current, "KLS", "Prepared new Temp KLS.");
+    kls_log(kls, "KLS", "Prepared new Temp KLS.");
 #endif
     return tmp;
 }
@@ -2130,23 +2392,26 @@ void kls_temp_end(Koliseo_Temp *tmp_kls)
 #ifdef KLS_DEBUG_CORE
     kls_log(kls_ref, "KLS", "Ended Temp KLS.");
 #endif
-    tmp_kls->kls->has_temp = 0;
-    tmp_kls->kls->t_kls = NULL;
+    // Callbacks registered during the temp may point into the rewound memory
+    kls__run_free_cbs(kls_ref, tmp_kls->free_cbs);
+    kls_ref->has_temp = 0;
+    kls_ref->t_kls = NULL;
+    Koliseo* block = tmp_kls->block;
 #if defined(__SANITIZE_ADDRESS__)
-    ptrdiff_t old_offset = tmp_kls->kls->offset;
+    ptrdiff_t old_offset = block->offset;
     ptrdiff_t new_offset = tmp_kls->offset;
 #endif // __SANITIZE_ADDRESS__
-    tmp_kls->kls->prev_offset = tmp_kls->prev_offset;
-    tmp_kls->kls->offset = tmp_kls->offset;
+    block->prev_offset = tmp_kls->prev_offset;
+    block->offset = tmp_kls->offset;
 
-    // Free any Koliseo chained after the current one
-    Koliseo* to_free = tmp_kls->kls->next;
+    // Free any Koliseo chained after the saved one
+    Koliseo* to_free = block->next;
     if (to_free != NULL) {
+        block->next = NULL;
         kls_free(to_free);
-        tmp_kls->kls->next = NULL;
     }
 
-    KLS_ASAN_POISON(tmp_kls->kls->data + new_offset, old_offset - new_offset);
+    KLS_ASAN_POISON(block->data + new_offset, old_offset - new_offset);
     tmp_kls = NULL; // statement with no effect TODO: Clear tmp_kls from caller
     if (kls_ref->conf.kls_collect_stats == 1) {
         kls_ref->stats.tot_temp_pushes = 0;
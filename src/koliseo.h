@@ -34,6 +34,9 @@ extern "C" {
 
 #ifndef _WIN32
 #define _POSIX_C_SOURCE 200809L
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE // For syscall(), used by the io_uring backend in kls_gulp.h
+#endif
 #endif
 
 #include <stdio.h>
@@ -99,6 +102,8 @@ typedef void(kls_free_func)(void*); /**< Used to select a free function for the
 
 #define KLS_MAX(a, b) ((a) > (b) ? (a) : (b))
 
+#define KLS_MIN(a, b) ((a) < (b) ? (a) : (b))
+
 /**
  * Defines current API version number from KLS_MAJOR, KLS_MINOR and KLS_PATCH.
  */
@@ -329,6 +334,22 @@ extern KLS_Stats KLS_STATS_DEFAULT;
 #define KLS_DEFAULT_EXTENSIONS_LEN 0
 #endif // KLS_MAX_EXTENSIONS
 
+/**
+ * Defines the signature for a callback run by kls_free().
+ * @see kls_on_free()
+ */
+typedef void(KLS_free_cb)(void* ctx);
+
+/**
+ * Represents a callback registered with kls_on_free().
+ * @see kls_on_free()
+ */
+typedef struct KLS_Free_Cb_Node {
+    KLS_free_cb* cb; /**< The callback to run.*/
+    void* ctx; /**< The argument passed to cb.*/
+    struct KLS_Free_Cb_Node* next; /**< Points to the previously registered callback.*/
+} KLS_Free_Cb_Node;
+
 /**
  * Represents the initialised arena allocator struct.
  * @see kls_new()
@@ -350,6 +371,7 @@ typedef struct Koliseo {
     void* extension_data[KLS_MAX_EXTENSIONS]; /**< Points to data for extensions.*/
     size_t hooks_len; /**< Length for hooks and extension_data.*/
     kls_free_func* free_func; /**< Points to the free function for the arena's backing memory.*/
+    KLS_Free_Cb_Node* free_cbs; /**< Callbacks run by kls_free() and kls_clear(), most recently registered first.*/
     struct Koliseo* next; /**< Points to the next Koliseo when conf.kls_growable == 1.*/
 } Koliseo;
 
@@ -378,6 +400,8 @@ typedef struct Koliseo {
  */
 typedef struct Koliseo_Temp {
     Koliseo *kls;     /**< Reference to the actual Koliseo we're saving.*/
+    Koliseo *block;     /**< Block of kls holding the saved offsets, the last one when the savestate was taken.*/
+    KLS_Free_Cb_Node *free_cbs;     /**< Callbacks of kls when the savestate was taken, later ones run on kls_temp_end().*/
     ptrdiff_t offset;	  /**< Current position of memory pointer.*/
     ptrdiff_t prev_offset;     /**< Previous position of memory pointer.*/
 } Koliseo_Temp;
@@ -517,6 +541,10 @@ void *kls_push_zero_ext_dbg(Koliseo * kls, ptrdiff_t size, ptrdiff_t align,
 #define kls_push_zero_ext(kls, size, align, count) kls_push_zero_ext_dbg((kls), (size), (align), (count), KLS_HERE)
 #endif // KOLISEO_HAS_LOCATE
 
+#ifndef KLS_SPRINTF_STACK_SIZE
+#define KLS_SPRINTF_STACK_SIZE 256 /**< Results of kls_vsprintf() shorter than this are formatted once, on the stack.*/
+#endif
+
 #ifndef KOLISEO_HAS_LOCATE
 char* kls_vsprintf(Koliseo* kls, const char* fmt, va_list args);
 #else
@@ -531,6 +559,36 @@ char* kls_sprintf_dbg(Koliseo* kls, Koliseo_Loc loc, const char* fmt, ...);
 #define kls_sprintf(kls, fmt, ...) kls_sprintf_dbg((kls), KLS_HERE, (fmt), __VA_ARGS__)
 #endif // KOLISEO_HAS_LOCATE
 
+/**
+ * Defines the minimum number of bytes a Kls_StrBuf claims when growing.
+ * @see Kls_StrBuf
+ */
+#define KLS_STRBUF_MIN_GROW 64
+
+/**
+ * Represents a string being built at the tail of a Koliseo.
+ * While it is the last allocation, it grows in place; otherwise it is moved to the tail, doubling its capacity.
+ * Finishing it hands out the built string where it lies, without a copy.
+ * @see kls_strbuf_start()
+ * @see kls_strbuf_append()
+ * @see kls_strbuf_appendf()
+ * @see kls_strbuf_finish()
+ */
+typedef struct Kls_StrBuf {
+    Koliseo* kls; /**< The Koliseo to push to.*/
+    Koliseo* block; /**< The Koliseo of the growable chain holding data.*/
+    char* data; /**< Start of the built string.*/
+    ptrdiff_t len; /**< Length of the built string.*/
+    ptrdiff_t cap; /**< Bytes pushed for data, including room for the terminator.*/
+} Kls_StrBuf;
+
+bool kls_strbuf_start(Kls_StrBuf* sb, Koliseo* kls, ptrdiff_t cap);
+bool kls_strbuf_append(Kls_StrBuf* sb, const char* bytes, ptrdiff_t len);
+bool kls_strbuf_append_str(Kls_StrBuf* sb, const char* cstr);
+bool kls_strbuf_vappendf(Kls_StrBuf* sb, const char* fmt, va_list args);
+bool kls_strbuf_appendf(Kls_StrBuf* sb, const char* fmt, ...);
+char* kls_strbuf_finish(Kls_StrBuf* sb, ptrdiff_t* len);
+
 #ifndef KOLISEO_HAS_LOCATE
 void *kls_repush(Koliseo *kls, void* old, ptrdiff_t size, ptrdiff_t align,
                  ptrdiff_t old_count, ptrdiff_t new_count);
@@ -624,6 +682,7 @@ void *kls_temp_repush_dbg(Koliseo_Temp *t_kls, void* old, ptrdiff_t size, ptrdif
 
 void kls_clear(Koliseo * kls);
 void kls_free(Koliseo * kls);
+bool kls_on_free(Koliseo * kls, KLS_free_cb * cb, void* ctx);
 void print_kls_2file(FILE * fp, const Koliseo * kls);
 void print_dbg_kls(const Koliseo * kls);
 void kls_formatSize(ptrdiff_t size, char *outputBuffer, size_t bufferSize);
@@ -0,0 +1,45 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef KLS_BENCH_H_
+#define KLS_BENCH_H_
+
+// Timing helpers shared by the static/*_bench.c programs.
+// Include after koliseo.h, which sets _POSIX_C_SOURCE for clock_gettime().
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Returns a monotonic timestamp in milliseconds.
+ */
+static inline double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * Runs expr once and prints the passed label with the elapsed milliseconds.
+ */
+#define BENCH(label, expr) do { \
+        double start = now_ms(); \
+        expr; \
+        printf("%-36s %10.2f ms\n", (label), now_ms() - start); \
+    } while (0)
+
+#endif // KLS_BENCH_H_
@@ -0,0 +1,48 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+#define DARRAY_T int
+#include "darray.h"
+
+#define DARRAY_BENCH_COUNT (1 << 24)
+#define DARRAY_BENCH_CHUNK 256
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    Koliseo* kls = kls_new_conf_ext(512 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+    int* src = KLS_PUSH_ARR(kls, int, DARRAY_BENCH_COUNT);
+    for (int i = 0; i < DARRAY_BENCH_COUNT; i++) {
+        src[i] = i;
+    }
+    long long check = 0;
+    // Arrays live on arr_kls, cleared before each case so that its pages are already mapped
+    Koliseo* arr_kls = kls_new_conf_ext(512 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    memset(KLS_PUSH_ARR(arr_kls, char, 256 * 1024 * 1024), 1, 256 * 1024 * 1024);
+
+    darray_int* a = NULL;
+    kls_clear(arr_kls);
+    BENCH("push", a = darray_int_init(arr_kls); for (int i = 0; i < DARRAY_BENCH_COUNT; i++) darray_int_push(a, src[i]));
+    check += a->items[a->count - 1];
+    kls_clear(arr_kls);
+    BENCH("reserve + push", a = darray_int_init(arr_kls); darray_int_reserve(a, DARRAY_BENCH_COUNT); for (int i = 0; i < DARRAY_BENCH_COUNT; i++) darray_int_push(a, src[i]));
+    check += a->items[a->count - 1];
+    kls_clear(arr_kls);
+    BENCH("push_n (chunks of 256)", a = darray_int_init(arr_kls); for (int i = 0; i < DARRAY_BENCH_COUNT; i += DARRAY_BENCH_CHUNK) darray_int_push_n(a, src + i, DARRAY_BENCH_CHUNK));
+    check += a->items[a->count - 1];
+    kls_clear(arr_kls);
+    BENCH("push_n (all at once)", a = darray_int_init(arr_kls); darray_int_push_n(a, src, DARRAY_BENCH_COUNT));
+    check += a->items[a->count - 1];
+    darray_int* b = NULL;
+    BENCH("extend_from", b = darray_int_init(arr_kls); darray_int_extend_from(b, a));
+    check += b->items[b->count - 1];
+    BENCH("swap_remove (all)", while (b->count > 0) check += darray_int_swap_remove(b, 0));
+    printf("  -> check: {%lli}\n", check);
+
+    kls_free(arr_kls);
+    kls_free(kls);
+    return 0;
+}
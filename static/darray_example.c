@@ -37,6 +37,20 @@ int main(int argc, char** argv)
         printf("{#%i: %s}\n", i, ds->items[i]);
     }
 
+    // Bulk operations grow the array once
+    int more[] = { 7, 8, 9 };
+    darray_int_reserve(darray, 100);
+    assert(darray->capacity >= darray->count + 100);
+    darray_int_push_n(darray, more, 3);
+    darray_int_insert_at(darray, 0, -1);
+    assert(darray_int_swap_remove(darray, 1) == 1);
+    darray_int_truncate(darray, 6);
+    darray_int_extend_from(darray, darray);
+
+    for (int i = 0; i < darray->count; i++) {
+        printf("{#%i: %i}\n", i, darray->items[i]);
+    }
+
     Koliseo_Temp* t_kls = kls_temp_start(kls);
 
     darray_str* ds_t = darray_str_init_t(t_kls);
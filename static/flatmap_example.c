@@ -0,0 +1,56 @@
+#include <stdint.h>
+#include <stdio.h>
+#define HASHMAP_T int
+#define HASHMAP_NAME flat_map_int
+#define HASHMAP_PREFIX flatmap_int_
+#include "flatmap.h"
+
+#define HASHMAP_HASH_MURMUR2
+#define HASHMAP_T char
+#include "flatmap.h"
+
+int main(void) {
+
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE*4);
+
+    flat_map_int *map = flatmap_int_new(kls, 0);
+
+    int x = 42;
+    int y = 420;
+    flatmap_int_push(map, "answer", &x);
+    flatmap_int_push(map, "num", &y);
+    int *v = flatmap_int_get(map, "answer");
+    if (v) printf("answer: %d\n", *v);
+    flatmap_int_remove(map, "answer");
+    v = flatmap_int_get(map, "answer");
+    if (v) printf("answer: %d\n", *v);
+
+    // Grows past the starting capacity
+    char key[16];
+    for (int i = 0; i < 100; i++) {
+        snprintf(key, sizeof(key), "k%i", i);
+        flatmap_int_push(map, key, &i);
+    }
+    printf("count: %zu, cap: %zu\n", map->count, map->cap);
+
+    size_t it = 0;
+    const char* k = NULL;
+    while (flatmap_int_next(map, &it, &k, &v)) {
+        if (*v > 95) printf("%s: %i\n", k, *v);
+    }
+
+    flatmap_char *c_map = flatmap_char_new(kls, 256);
+    char c = 'w';
+    char d = 'a';
+    flatmap_char_push(c_map, "foo", &c);
+    flatmap_char_push(c_map, "bar", &d);
+
+    it = 0;
+    char* cv = NULL;
+    while (flatmap_char_next(c_map, &it, &k, &cv)) {
+        printf("%s: %c\n", k, *cv);
+    }
+
+    kls_free(kls);
+    return 0;
+}
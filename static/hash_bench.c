@@ -0,0 +1,148 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+#include "hashmap_hash.h"
+
+#define HASHMAP_HASH_FNV_1A
+#define HASHMAP_T int
+#define HASHMAP_NAME map_fnv
+#include "hashmap.h"
+
+#define HASHMAP_HASH_MURMUR2
+#define HASHMAP_T int
+#define HASHMAP_NAME map_murmur2
+#include "hashmap.h"
+
+#define HASHMAP_HASH_WYHASH
+#define HASHMAP_T int
+#define HASHMAP_NAME map_wyhash
+#include "hashmap.h"
+
+#define HASHMAP_HASH_AES
+#define HASHMAP_T int
+#define HASHMAP_NAME map_aes
+#include "hashmap.h"
+
+#define HASH_BENCH_BYTES (256 * 1024 * 1024)
+#define HASH_BENCH_KEYS (1 << 18)
+
+typedef uint64_t (hash_fn)(const char* s, size_t len);
+
+static uint64_t murmur2(const char* s, size_t len)
+{
+    return HASHMAP_murmur2_hash_str(s, len);
+}
+
+static const struct {
+    const char* name;
+    hash_fn* fn;
+} hashes[] = {
+    { "fnv_1a", HASHMAP_fnv_1a_hash_str },
+    { "murmur2", murmur2 },
+    { "wyhash", HASHMAP_wyhash_str },
+    { "aes", HASHMAP_aes_hash_str },
+};
+
+// Fills buf with printable bytes from a xorshift generator.
+static void fill(char* buf, size_t len, uint64_t* state)
+{
+    for (size_t i = 0; i < len; i++) {
+        *state ^= *state << 13;
+        *state ^= *state >> 7;
+        *state ^= *state << 17;
+        buf[i] = 'a' + (*state % 26);
+    }
+}
+
+// Sets len_out to HASH_BENCH_KEYS key lengths: a fixed length, or, for len == 0, log line lengths from 40 to 300.
+static void lengths(size_t* len_out, size_t len, uint64_t* state)
+{
+    for (size_t i = 0; i < HASH_BENCH_KEYS; i++) {
+        *state ^= *state << 13;
+        *state ^= *state >> 7;
+        *state ^= *state << 17;
+        len_out[i] = (len > 0 ? len : 40 + (*state % 261));
+    }
+}
+
+#define MAP_BENCH(map_t, prefix) do { \
+        double start = now_ms(); \
+        map_t* m = prefix##new(map_kls, 16); \
+        for (size_t i = 0; i < HASH_BENCH_KEYS; i++) prefix##push_n(m, keys + offs[i], lens[i], &vals[i]); \
+        double push = now_ms() - start; \
+        start = now_ms(); \
+        long long check = 0; \
+        for (size_t i = 0; i < HASH_BENCH_KEYS; i++) check += *prefix##get_n(m, keys + offs[i], lens[i]); \
+        printf("  %-10s push %8.2f ms  get %8.2f ms  (count: %zu, check: %lli)\n", #map_t, push, now_ms() - start, m->count, check); \
+    } while (0)
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+    Koliseo* kls = kls_new_conf_ext(HASH_BENCH_BYTES, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    // Throughput over a buffer, for fixed key lengths
+    size_t buf_len = 64 * 1024 * 1024;
+    char* buf = KLS_PUSH_ARR(kls, char, buf_len);
+    fill(buf, buf_len, &state);
+    size_t key_lens[] = { 4, 8, 16, 32, 64, 128, 256, 1024, 4096 };
+    printf("%-8s", "len");
+    for (size_t h = 0; h < sizeof(hashes) / sizeof(hashes[0]); h++) {
+        printf(" %16s", hashes[h].name);
+    }
+    printf("   (GB/s)\n");
+    uint64_t sink = 0;
+    for (size_t l = 0; l < sizeof(key_lens) / sizeof(key_lens[0]); l++) {
+        size_t len = key_lens[l];
+        printf("%-8zu", len);
+        for (size_t h = 0; h < sizeof(hashes) / sizeof(hashes[0]); h++) {
+            double start = now_ms();
+            size_t done = 0;
+            for (int pass = 0; pass < 2; pass++) {
+                for (size_t off = 0; off + len <= buf_len; off += len) {
+                    sink += hashes[h].fn(buf + off, len);
+                    done += len;
+                }
+            }
+            printf(" %16.2f", done / (now_ms() - start) / 1e6);
+        }
+        printf("\n");
+    }
+    printf("(sink: %llu)\n", (unsigned long long) sink);
+
+    // Map push and get, for key length distributions
+    size_t dists[] = { 8, 24, 64, 0 };
+    const char* dist_names[] = { "8 bytes", "24 bytes", "64 bytes", "log lines (40-300 bytes)" };
+    size_t* lens = KLS_PUSH_ARR(kls, size_t, HASH_BENCH_KEYS);
+    size_t* offs = KLS_PUSH_ARR(kls, size_t, HASH_BENCH_KEYS);
+    int* vals = KLS_PUSH_ARR(kls, int, HASH_BENCH_KEYS);
+    char* keys = KLS_PUSH_ARR(kls, char, (size_t) HASH_BENCH_KEYS * 300);
+    for (size_t i = 0; i < HASH_BENCH_KEYS; i++) {
+        vals[i] = (int) i;
+    }
+    // Maps are cleared after each distribution
+    Koliseo* map_kls = kls_new_conf_ext(HASH_BENCH_BYTES, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    map_kls->conf.kls_growable = 1;
+    for (size_t d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) {
+        printf("%s:\n", dist_names[d]);
+        lengths(lens, dists[d], &state);
+        size_t off = 0;
+        for (size_t i = 0; i < HASH_BENCH_KEYS; i++) {
+            offs[i] = off;
+            fill(keys + off, lens[i], &state);
+            off += lens[i];
+        }
+        MAP_BENCH(map_fnv, map_fnv_);
+        MAP_BENCH(map_murmur2, map_murmur2_);
+        MAP_BENCH(map_wyhash, map_wyhash_);
+        MAP_BENCH(map_aes, map_aes_);
+        kls_clear(map_kls);
+    }
+
+    kls_free(map_kls);
+    kls_free(kls);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "kls_gulp.h"
+#include "bench.h"
+#define HASHMAP_T int
+#define HASHMAP_NAME hash_map_int
+#define HASHMAP_PREFIX hashmap_int_
+#include "hashmap.h"
+
+#define HASHMAP_T int
+#define HASHMAP_NAME hash_map_inc
+#define HASHMAP_PREFIX hashmap_inc_
+#define HASHMAP_REHASH_STEP 64
+#include "hashmap.h"
+
+#define HASHMAP_T int
+#define HASHMAP_KEY_T uint64_t
+#define HASHMAP_KEY_HASH hashmap_hash_u64
+#define HASHMAP_BY_VALUE
+#define HASHMAP_NAME id_map_int
+#define HASHMAP_PREFIX idmap_int_
+#include "hashmap.h"
+
+#define HASHMAP_T int
+#define HASHMAP_NAME flat_map_int
+#define HASHMAP_PREFIX flatmap_int_
+#include "flatmap.h"
+
+#define HASHMAP_BENCH_COUNT (1 << 19)
+#define HASHMAP_BENCH_KEY 16
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    Koliseo* kls = kls_new_conf_ext(256 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+
+    char (*keys)[HASHMAP_BENCH_KEY] = (char (*)[HASHMAP_BENCH_KEY]) KLS_PUSH_ARR(kls, char, HASHMAP_BENCH_COUNT * HASHMAP_BENCH_KEY);
+    char (*misses)[HASHMAP_BENCH_KEY] = (char (*)[HASHMAP_BENCH_KEY]) KLS_PUSH_ARR(kls, char, HASHMAP_BENCH_COUNT * HASHMAP_BENCH_KEY);
+    int* vals = KLS_PUSH_ARR(kls, int, HASHMAP_BENCH_COUNT);
+    for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) {
+        snprintf(keys[i], HASHMAP_BENCH_KEY, "key_%i", i);
+        snprintf(misses[i], HASHMAP_BENCH_KEY, "miss_%i", i);
+        vals[i] = i;
+    }
+    long long check = 0;
+
+    hash_map_int* hm = NULL;
+    BENCH("hashmap new", hm = hashmap_int_new(kls, HASHMAP_BENCH_COUNT));
+    BENCH("hashmap push", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) hashmap_int_push(hm, keys[i], &vals[i]));
+    BENCH("hashmap get (hit)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += *hashmap_int_get(hm, keys[i]));
+    BENCH("hashmap get (miss)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += (hashmap_int_get(hm, misses[i]) != NULL));
+    printf("  -> check: {%lli}\n", check);
+
+    // Worst single push shows the stall of moving the whole table at once
+    double worst = 0;
+    BENCH("hashmap push (growing)", hm = hashmap_int_new(kls, 16); for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) {
+        double t = now_ms();
+        hashmap_int_push(hm, keys[i], &vals[i]);
+        t = now_ms() - t;
+        if (t > worst) worst = t;
+    });
+    printf("  -> buckets: {%zu}, worst push: {%.3f} ms\n", hm->bucket_count, worst);
+    worst = 0;
+    hash_map_inc* him = NULL;
+    BENCH("hashmap push (incremental)", him = hashmap_inc_new(kls, 16); for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) {
+        double t = now_ms();
+        hashmap_inc_push(him, keys[i], &vals[i]);
+        t = now_ms() - t;
+        if (t > worst) worst = t;
+    });
+    printf("  -> buckets: {%zu}, worst push: {%.3f} ms\n", him->bucket_count, worst);
+    check = 0;
+    BENCH("hashmap get (grown)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += *hashmap_int_get(hm, keys[i]));
+    printf("  -> check: {%lli}\n", check);
+
+    id_map_int* im = NULL;
+    BENCH("hashmap push (u64 keys)", im = idmap_int_new(kls, HASHMAP_BENCH_COUNT); for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) idmap_int_push(im, (uint64_t) i * 2654435761u, &vals[i]));
+    check = 0;
+    BENCH("hashmap get (u64 keys)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += *idmap_int_get(im, (uint64_t) i * 2654435761u));
+    printf("  -> check: {%lli}\n", check);
+
+    // Space separated keys, looked up as tokens without terminating them
+    Kls_StrBuf sb = {0};
+    kls_strbuf_start(&sb, kls, HASHMAP_BENCH_COUNT * HASHMAP_BENCH_KEY);
+    for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) {
+        kls_strbuf_append_str(&sb, keys[i]);
+        kls_strbuf_append(&sb, " ", 1);
+    }
+    Kstr text = kls_strbuf_finish_kstr(&sb);
+    check = 0;
+    BENCH("hashmap get_kstr (tokens)", for (Kstr rest = text; rest.len > 0;) check += *hashmap_int_get_kstr(hm, kstr_token(&rest, ' ')));
+    printf("  -> check: {%lli}\n", check);
+
+    check = 0;
+    flat_map_int* fm = NULL;
+    BENCH("flatmap new", fm = flatmap_int_new(kls, 0));
+    BENCH("flatmap push (growing)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) flatmap_int_push(fm, keys[i], &vals[i]));
+    BENCH("flatmap get (hit)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += *flatmap_int_get(fm, keys[i]));
+    BENCH("flatmap get (miss)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += (flatmap_int_get(fm, misses[i]) != NULL));
+    printf("  -> check: {%lli}\n", check);
+
+    BENCH("flatmap new (sized)", fm = flatmap_int_new(kls, HASHMAP_BENCH_COUNT));
+    BENCH("flatmap push (sized)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) flatmap_int_push(fm, keys[i], &vals[i]));
+    BENCH("flatmap remove (half)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i += 2) flatmap_int_remove(fm, keys[i]));
+    BENCH("flatmap get (after remove)", for (int i = 0; i < HASHMAP_BENCH_COUNT; i++) check += (flatmap_int_get(fm, keys[i]) != NULL));
+    printf("  -> check: {%lli}\n", check);
+
+    kls_free(kls);
+    return 0;
+}
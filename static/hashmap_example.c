@@ -23,6 +23,19 @@ static uint64_t my_hash_str(const char *s, size_t len) {
 #define HASHMAP_PREFIX hashmap_char_
 #include "hashmap.h"
 
+typedef struct Point {
+    int x;
+    int y;
+} Point;
+
+#define HASHMAP_T Point
+#define HASHMAP_KEY_T uint64_t
+#define HASHMAP_KEY_HASH hashmap_hash_u64
+#define HASHMAP_BY_VALUE
+#define HASHMAP_NAME id_map_point
+#define HASHMAP_PREFIX idmap_point_
+#include "hashmap.h"
+
 int main(void) {
 
     Koliseo* kls = kls_new(KLS_DEFAULT_SIZE*4);
@@ -41,7 +54,7 @@ int main(void) {
 
     for (size_t i = 0; i < map->bucket_count; i++) {
         da_hash_map_int_node* node = map->buckets[i];
-        for (size_t j = 0; j < node->count; j++) {
+        for (size_t j = 0; node && j < node->count; j++) {
             printf("%s (#%llu): %i\n", node->items[j].key, i, *(node->items[j].value));
         }
     }
@@ -54,11 +67,33 @@ int main(void) {
 
     for (size_t i = 0; i < c_map->bucket_count; i++) {
         da_hash_map_char_node* node = c_map->buckets[i];
-        for (size_t j = 0; j < node->count; j++) {
+        for (size_t j = 0; node && j < node->count; j++) {
             printf("%s (#%llu): %c\n", node->items[j].key, i, *(node->items[j].value));
         }
     }
 
+    // Integer keys, values copied in the nodes
+    id_map_point *p_map = idmap_point_new(kls, 16);
+    for (uint64_t id = 0; id < 4; id++) {
+        Point p = { .x = (int) id, .y = (int) (id * id) };
+        idmap_point_push(p_map, id * 1000, &p);
+    }
+    Point *p = idmap_point_get(p_map, 3000);
+    if (p) printf("3000: (%i, %i)\n", p->x, p->y);
+
+    // Grows past its starting bucket count, old tables go away when the Koliseo_Temp ends
+    Koliseo* temp_kls = kls_new(KLS_DEFAULT_SIZE*4);
+    Koliseo_Temp* t_kls = kls_temp_start(temp_kls);
+    hash_map_char *t_map = hashmap_char_new_t(t_kls, 4);
+    char key[16];
+    for (int i = 0; i < 100; i++) {
+        snprintf(key, sizeof(key), "k%i", i);
+        hashmap_char_push(t_map, key, &c);
+    }
+    printf("count: %zu, buckets: %zu\n", t_map->count, t_map->bucket_count);
+    kls_temp_end(t_kls);
+    kls_free(temp_kls);
+
     kls_free(kls);
     return 0;
 }
@@ -0,0 +1,129 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "kls_gulp.h"
+#include "bench.h"
+
+#define KSTR_BENCH_SIZE (64 * 1024 * 1024)
+#define KSTR_BENCH_LINE 80
+
+static const char* level_names[] = {
+    [KSTR_SIMD_SCALAR] = "scalar",
+    [KSTR_SIMD_SSE2] = "sse2",
+    [KSTR_SIMD_AVX2] = "avx2",
+    [KSTR_SIMD_AVX512] = "avx512",
+};
+
+// The sliding window search kstr_token_kstr() used before Kstr_Needle
+static size_t naive_find(Kstr k, Kstr delim)
+{
+    Kstr win = kstr_new(k.data, delim.len);
+    size_t i = 0;
+    while (i + delim.len <= k.len && !(kstr_eq(win, delim))) {
+        i++;
+        win.data++;
+    }
+    return i;
+}
+
+static void report(const char* level, const char* label, double ms, size_t bytes, long long check)
+{
+    printf("%-8s %-20s %8.3f GB/s  (check: %lld)\n", level, label, bytes / ms / 1e6, check);
+}
+
+int main(void)
+{
+    Koliseo* kls = kls_new(2 * KSTR_BENCH_SIZE + (KSTR_SIMD_AVX512 + 1) * (KSTR_BENCH_SIZE / KSTR_BENCH_LINE + 1) * (sizeof(Kstr) + sizeof(size_t)) + KLS_DEFAULT_SIZE);
+    char* a = KLS_PUSH_ARR(kls, char, KSTR_BENCH_SIZE);
+    char* b = KLS_PUSH_ARR(kls, char, KSTR_BENCH_SIZE);
+    for (size_t i = 0; i < KSTR_BENCH_SIZE; i++) {
+        a[i] = (i % KSTR_BENCH_LINE == KSTR_BENCH_LINE - 1) ? '\n' : 'a' + (i % 26);
+        b[i] = (i % 2 == 0 && a[i] != '\n') ? a[i] - 32 : a[i];
+    }
+    Kstr ka = kstr_new(a, KSTR_BENCH_SIZE);
+    Kstr kb = kstr_new(b, KSTR_BENCH_SIZE);
+
+    for (int level = KSTR_SIMD_SCALAR; level <= (int) kstr_simd_level(); level++) {
+        kstr_set_simd_level(level);
+        const char* name = level_names[level];
+
+        double start = now_ms();
+        int idx = -1;
+        kstr_indexof(ka, '#', &idx);
+        report(name, "kstr_indexof (miss)", now_ms() - start, ka.len, idx);
+
+        start = now_ms();
+        Kstr rest = ka;
+        size_t lines = 0;
+        while (rest.len > 0) {
+            kstr_token(&rest, '\n');
+            lines++;
+        }
+        report(name, "kstr_token (lines)", now_ms() - start, ka.len, lines);
+
+        start = now_ms();
+        rest = ka;
+        Kstr part = KSTR_NULL;
+        lines = 0;
+        while (kstr_try_token(&rest, '\n', &part)) {
+            lines++;
+        }
+        report(name, "kstr_try_token", now_ms() - start, ka.len, lines);
+
+        start = now_ms();
+        Kstr_Split_Iter it = kstr_split_iter(ka, '\n');
+        lines = 0;
+        while (kstr_split_next(&it, &part)) {
+            lines++;
+        }
+        report(name, "kstr_split_next", now_ms() - start, ka.len, lines);
+
+        start = now_ms();
+        size_t count = 0;
+        kstr_split_all(kls, ka, '\n', &count);
+        report(name, "kstr_split_all", now_ms() - start, ka.len, count);
+
+        start = now_ms();
+        Kstr_Line_Index* lidx = kstr_line_index_new(kls, ka, 64);
+        report(name, "kstr_line_index_new", now_ms() - start, ka.len, lidx->lines);
+
+        start = now_ms();
+        size_t tot = 0;
+        for (size_t i = 0; i < lidx->lines; i += 7) {
+            kstr_line_at(lidx, i, &part);
+            tot += part.len;
+        }
+        report(name, "kstr_line_at (1/7)", now_ms() - start, ka.len, tot);
+
+        start = now_ms();
+        size_t pos = naive_find(ka, KSTR("#boundary"));
+        report(name, "naive find (miss)", now_ms() - start, ka.len, pos);
+
+        start = now_ms();
+        Kstr_Needle needle = kstr_needle_new(KSTR("#boundary"));
+        bool found = kstr_find_needle(ka, &needle, &pos);
+        report(name, "kstr_find (miss)", now_ms() - start, ka.len, found);
+
+        start = now_ms();
+        Kstr_Needle sep = kstr_needle_new(KSTR("yz"));
+        rest = ka;
+        lines = 0;
+        while (rest.len > 0) {
+            kstr_token_needle(&rest, &sep);
+            lines++;
+        }
+        report(name, "kstr_token_needle", now_ms() - start, ka.len, lines);
+
+        start = now_ms();
+        bool eq = kstr_eq(ka, ka);
+        report(name, "kstr_eq", now_ms() - start, ka.len, eq);
+
+        start = now_ms();
+        eq = kstr_eq_ignorecase(ka, kb);
+        report(name, "kstr_eq_ignorecase", now_ms() - start, ka.len, eq);
+    }
+
+    kls_free(kls);
+    return 0;
+}
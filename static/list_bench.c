@@ -0,0 +1,90 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+
+static bool int_eq(const int* a, const int* b)
+{
+    return *a == *b;
+}
+
+static bool int_eq_walk(const int* a, const int* b)
+{
+    return *a == *b;
+}
+
+static uint64_t int_hash(const int* a)
+{
+    return (uint64_t) *a;
+}
+
+#define LIST_T int
+#define LIST_NAME IntList
+#define LIST_CMP_DEFAULT_FN &int_eq
+#define LIST_HASH_DEFAULT_FN int_hash
+#include "list.h"
+
+#define LIST_BENCH_COUNT 1000000
+#define LIST_BENCH_SMALL_COUNT 10000
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    Koliseo* kls = kls_new_conf_ext(256 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+    int* vals = KLS_PUSH_ARR(kls, int, 2 * LIST_BENCH_COUNT);
+    for (int i = 0; i < 2 * LIST_BENCH_COUNT; i++) {
+        vals[i] = i;
+    }
+    // l1 holds [0, n), l2 holds [n / 2, 3n / 2), so half of each is shared
+    IntList l1 = IntList_nullList();
+    IntList l2 = IntList_nullList();
+    BENCH("cons (2 x 10^6)", for (int i = LIST_BENCH_COUNT - 1; i >= 0; i--) {
+        l1 = IntList_cons_kls(kls, &vals[i], l1);
+        l2 = IntList_cons_kls(kls, &vals[i + LIST_BENCH_COUNT / 2], l2);
+    });
+
+    long long check = 0;
+    IntList res = NULL;
+    BENCH("append_kls", res = IntList_append_kls(kls, l1, l2));
+    check += IntList_length(res);
+    BENCH("reverse_kls", res = IntList_reverse_kls(kls, l1));
+    check += *IntList_head(res);
+    BENCH("copy_kls", res = IntList_copy_kls(kls, l1));
+    check += IntList_length(res);
+    BENCH("remove_kls (last item)", res = IntList_remove_kls(kls, &vals[LIST_BENCH_COUNT - 1], l1));
+    check += IntList_length(res);
+    BENCH("intersect_kls (hashed)", res = IntList_intersect_kls(kls, l1, l2));
+    check += IntList_length(res);
+    BENCH("diff_kls (hashed)", res = IntList_diff_kls(kls, l1, l2));
+    check += IntList_length(res);
+    BENCH("intersect_p_kls (hashed)", res = IntList_intersect_p_kls(kls, l1, l2));
+    check += IntList_length(res);
+    BENCH("append_gl", res = IntList_append_gl(l1, l2));
+    check += IntList_length(res);
+    // Only the copied nodes of l1 come from malloc()
+    for (int i = 0; i < LIST_BENCH_COUNT; i++) {
+        IntList next = res->next;
+        free(res);
+        res = next;
+    }
+
+    // Passing a comparator other than the default falls back to member() walks, which are quadratic
+    IntList s1 = IntList_nullList();
+    IntList s2 = IntList_nullList();
+    for (int i = LIST_BENCH_SMALL_COUNT - 1; i >= 0; i--) {
+        s1 = IntList_cons_kls(kls, &vals[i], s1);
+        s2 = IntList_cons_kls(kls, &vals[i + LIST_BENCH_SMALL_COUNT / 2], s2);
+    }
+    // The first scratch buffer after freeing the append_gl nodes pays for page faults
+    res = IntList_intersect_kls(kls, s1, s2);
+    BENCH("intersect_kls (hashed, 10^4)", res = IntList_intersect_kls(kls, s1, s2));
+    check += IntList_length(res);
+    BENCH("intersect_kls_fn (walks, 10^4)", res = IntList_intersect_kls_fn(kls, s1, s2, &int_eq_walk));
+    check += IntList_length(res);
+    printf("  -> check: {%lli}\n", check);
+
+    kls_free(kls);
+    return 0;
+}
@@ -0,0 +1,135 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+#include <unistd.h>
+#include <pthread.h>
+#define HASHMAP_HASH_WYHASH
+#define HASHMAP_T int
+#define HASHMAP_NAME rcu_map_int
+#define HASHMAP_PREFIX rcumap_int_
+#include "rcumap.h"
+
+#define HASHMAP_HASH_WYHASH
+#define HASHMAP_T int
+#define HASHMAP_NAME flat_map_int
+#define HASHMAP_PREFIX flatmap_int_
+#include "flatmap.h"
+
+#define RCUMAP_BENCH_COUNT (1 << 16)
+#define RCUMAP_BENCH_GETS (1 << 22)
+#define RCUMAP_BENCH_KEY 16
+#define RCUMAP_BENCH_MAX_THREADS 64
+
+static char keys[RCUMAP_BENCH_COUNT][RCUMAP_BENCH_KEY];
+static rcu_map_int* rcu_map;
+static flat_map_int* flat_map;
+static pthread_mutex_t flat_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int writer_stop;
+
+static void* rcu_reader(void* arg)
+{
+    long long* check = arg;
+    int r = rcumap_int_reader_join(rcu_map);
+    int v = 0;
+    uint64_t state = (uint64_t) (uintptr_t) arg | 1;
+    for (int i = 0; i < RCUMAP_BENCH_GETS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (rcumap_int_get(rcu_map, r, keys[state % RCUMAP_BENCH_COUNT], &v)) *check += v;
+    }
+    rcumap_int_reader_leave(rcu_map, r);
+    return NULL;
+}
+
+// The same lookups on a flatmap.h map behind a mutex
+static void* locked_reader(void* arg)
+{
+    long long* check = arg;
+    uint64_t state = (uint64_t) (uintptr_t) arg | 1;
+    for (int i = 0; i < RCUMAP_BENCH_GETS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        pthread_mutex_lock(&flat_lock);
+        int* v = flatmap_int_get(flat_map, keys[state % RCUMAP_BENCH_COUNT]);
+        if (v) *check += *v;
+        pthread_mutex_unlock(&flat_lock);
+    }
+    return NULL;
+}
+
+// Updates one key every millisecond
+static void* writer(void* arg)
+{
+    size_t* updates = arg;
+    for (int i = 0; !atomic_load(&writer_stop); i++) {
+        rcumap_int_push(rcu_map, keys[i % RCUMAP_BENCH_COUNT], &i);
+        *updates += 1;
+        nanosleep(&(struct timespec) { .tv_sec = 0, .tv_nsec = 1000 * 1000 }, NULL);
+    }
+    return NULL;
+}
+
+static double run(void* (*fn)(void*), int threads, bool with_writer, size_t* updates)
+{
+    pthread_t tids[RCUMAP_BENCH_MAX_THREADS];
+    long long checks[RCUMAP_BENCH_MAX_THREADS][8] = {0}; // Padded apart
+    pthread_t wid;
+    atomic_store(&writer_stop, 0);
+    if (with_writer) pthread_create(&wid, NULL, writer, updates);
+    double start = now_ms();
+    for (int t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, fn, checks[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double ms = now_ms() - start;
+    atomic_store(&writer_stop, 1);
+    if (with_writer) pthread_join(wid, NULL);
+    return (double) threads * RCUMAP_BENCH_GETS / ms / 1e3;
+}
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+    Koliseo* kls = kls_new_conf_ext(64 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+
+    static const char* key_ptrs[RCUMAP_BENCH_COUNT];
+    static int vals[RCUMAP_BENCH_COUNT];
+    for (int i = 0; i < RCUMAP_BENCH_COUNT; i++) {
+        snprintf(keys[i], RCUMAP_BENCH_KEY, "key_%i", i);
+        key_ptrs[i] = keys[i];
+        vals[i] = i;
+    }
+    rcu_map = rcumap_int_new(kls, RCUMAP_BENCH_MAX_THREADS + 1);
+    double start = now_ms();
+    rcumap_int_push_batch(rcu_map, key_ptrs, vals, RCUMAP_BENCH_COUNT);
+    printf("rcumap push_batch (%i keys) %10.2f ms\n", RCUMAP_BENCH_COUNT, now_ms() - start);
+    start = now_ms();
+    rcumap_int_push(rcu_map, keys[0], &vals[0]);
+    printf("rcumap push (one key)        %10.2f ms\n", now_ms() - start);
+    flat_map = flatmap_int_new(kls, RCUMAP_BENCH_COUNT);
+    for (int i = 0; i < RCUMAP_BENCH_COUNT; i++) {
+        flatmap_int_push(flat_map, keys[i], &vals[i]);
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = (cpus < 1 ? 1 : (cpus > RCUMAP_BENCH_MAX_THREADS ? RCUMAP_BENCH_MAX_THREADS : (int) cpus));
+    printf("%-8s %16s %20s %20s   (Mgets/s, %i cpus)\n", "threads", "rcumap", "rcumap + writer", "flatmap + mutex", max_threads);
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        size_t updates = 0;
+        double rcu = run(rcu_reader, threads, false, NULL);
+        double rcu_w = run(rcu_reader, threads, true, &updates);
+        double locked = run(locked_reader, threads, false, NULL);
+        printf("%-8i %16.2f %20.2f %20.2f   (updates: %zu)\n", threads, rcu, rcu_w, locked, updates);
+        if (threads < max_threads && threads * 2 > max_threads) threads = max_threads / 2;
+    }
+    printf("versions waiting: %zu\n", rcumap_int_reclaim(rcu_map));
+
+    kls_free(kls);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#define HASHMAP_T int
+#define HASHMAP_NAME rcu_map_int
+#define HASHMAP_PREFIX rcumap_int_
+#include "rcumap.h"
+#include <stdio.h>
+
+static void* reader(void* arg)
+{
+    rcu_map_int* map = arg;
+    int r = rcumap_int_reader_join(map);
+    if (r < 0) return NULL;
+    int lookups = 0;
+    int v = 0;
+    char key[16];
+    for (int round = 0; round < 1000; round++) {
+        for (int i = 0; i < 64; i++) {
+            snprintf(key, sizeof(key), "k%i", i);
+            rcumap_int_get(map, r, key, &v);
+            lookups++;
+        }
+    }
+    rcumap_int_reader_leave(map, r);
+    printf("reader: {%i} lookups\n", lookups);
+    return NULL;
+}
+
+int main(void) {
+
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+
+    rcu_map_int *map = rcumap_int_new(kls, 0);
+
+    // Many keys at once go in a single new version
+    char keys[64][16];
+    const char* key_ptrs[64];
+    int vals[64];
+    for (int i = 0; i < 64; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "k%i", i);
+        key_ptrs[i] = keys[i];
+        vals[i] = i;
+    }
+    rcumap_int_push_batch(map, key_ptrs, vals, 64);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, reader, map);
+    }
+    // Updates run while the readers look up
+    for (int i = 0; i < 64; i++) {
+        int x = i * 10;
+        rcumap_int_push(map, keys[i], &x);
+    }
+    rcumap_int_remove(map, "k0");
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    int r = rcumap_int_reader_join(map);
+    int v = 0;
+    if (rcumap_int_get(map, r, "k42", &v)) printf("k42: %i\n", v);
+    if (!rcumap_int_get(map, r, "k0", &v)) printf("k0 was removed\n");
+    rcumap_int_reader_leave(map, r);
+    printf("count: %zu, versions waiting: %zu\n", (size_t) map->count, rcumap_int_reclaim(map));
+
+    // Clearing the Koliseo frees the map, so it can be reused right away
+    kls_clear(kls);
+    memset(KLS_PUSH_ARR(kls, char, 1024), 0xff, 1024);
+    map = rcumap_int_new(kls, 0);
+    rcumap_int_push(map, "again", &v);
+    printf("count after clear: %zu\n", (size_t) map->count);
+
+    kls_free(kls);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "kls_region.h"
+#include "bench.h"
+
+#define REGION_BENCH_COUNT 1000000
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    // Use the growable reglist backend, so that the region count is not capped.
+    KLS_Autoregion_Extension_Data* data_pt = KLS_DEFAULT_ALLOCF(sizeof(KLS_Autoregion_Extension_Data));
+    *data_pt = (KLS_Autoregion_Extension_Data) {
+        .conf = (KLS_Autoregion_Extension_Conf) {
+            .kls_autoset_regions = 1,
+            .kls_reglist_alloc_backend = KLS_REGLIST_ALLOC_KLS,
+            .kls_reglist_kls_size = (REGION_BENCH_COUNT * 3) * (sizeof(KLS_Region) + sizeof(KLS_region_list_item)),
+            .kls_autoset_temp_regions = 0,
+            .tkls_reglist_alloc_backend = KLS_REGLIST_ALLOC_LIBC,
+            .tkls_reglist_kls_size = 0,
+        },
+    };
+    void* user[] = { data_pt };
+    Koliseo* kls = kls_new_conf_ext(REGION_BENCH_COUNT * 2 * sizeof(int) + KLS_DEFAULT_SIZE, KLS_DEFAULT_CONF, KLS_DEFAULT_HOOKS, user, 1);
+
+    BENCH("KLS_PUSH", for (int i = 0; i < REGION_BENCH_COUNT; i++) KLS_PUSH(kls, int));
+    KLS_Region_List all = data_pt->regs;
+    printf("regions: {%i}\n", kls_rl_length(all));
+
+    // Every third region
+    KLS_Region_List some = kls_rl_emptyList();
+    int i = 0;
+    for (KLS_Region_List it = all; !kls_rl_empty(it); it = kls_rl_tail(it), i++) {
+        if (i % 3 == 0) {
+            some = kls_rl_cons(kls, kls_rl_head(it), some);
+        }
+    }
+
+    KLS_Region_List res = NULL;
+    BENCH("kls_rl_copy", res = kls_rl_copy(kls, all));
+    BENCH("kls_rl_reverse", res = kls_rl_reverse(kls, all));
+    BENCH("kls_rl_mergeList", res = kls_rl_mergeList(kls, all, some));
+    BENCH("kls_rl_intersect", res = kls_rl_intersect(kls, all, some));
+    printf("  -> {%i}\n", kls_rl_length(res));
+    BENCH("kls_rl_diff", res = kls_rl_diff(kls, all, some));
+    printf("  -> {%i}\n", kls_rl_length(res));
+
+    Koliseo* arr_kls = kls_new_conf_ext(REGION_BENCH_COUNT * 8 * sizeof(KLS_list_element), KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    Koliseo_Temp* t_kls = kls_temp_start(arr_kls);
+    KLS_Region_Array a_all = {0};
+    KLS_Region_Array a_some = {0};
+    KLS_Region_Array a_res = {0};
+    BENCH("kls_ra_from_list", a_all = kls_ra_from_list(t_kls, all));
+    a_some = kls_ra_from_list(t_kls, some);
+    BENCH("kls_ra_sort", kls_ra_sort(&a_all));
+    kls_ra_sort(&a_some);
+    BENCH("kls_ra_merge", a_res = kls_ra_merge(t_kls, a_all, a_some));
+    printf("  -> {%td}\n", a_res.count);
+    BENCH("kls_ra_intersect", a_res = kls_ra_intersect(t_kls, a_all, a_some));
+    printf("  -> {%td}\n", a_res.count);
+    BENCH("kls_ra_diff", a_res = kls_ra_diff(t_kls, a_all, a_some));
+    printf("  -> {%td}\n", a_res.count);
+    kls_temp_end(t_kls);
+    kls_free(arr_kls);
+
+    kls_free(kls);
+    return 0;
+}
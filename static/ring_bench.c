@@ -0,0 +1,120 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#define RING_T int
+#include "ring.h"
+#include "bench.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define DARRAY_T int
+#include "darray.h"
+
+#define LIST_T int
+#define LIST_NAME IntList
+#include "dllist.h"
+
+#define RING_BENCH_OPS 10000000
+#define RING_BENCH_DEPTH 1024
+#define RING_BENCH_BATCH 64
+
+#define BENCH_ARENA(label, kls, expr) do { \
+        ptrdiff_t used = (kls)->offset; \
+        double start = now_ms(); \
+        expr; \
+        printf("%-36s %10.2f ms  (arena used: %td bytes)\n", (label), now_ms() - start, (kls)->offset - used); \
+    } while (0)
+
+static void* producer(void* arg)
+{
+    ring_int* ring = arg;
+    int batch[RING_BENCH_BATCH];
+    for (int next = 0; next < RING_BENCH_OPS; next += RING_BENCH_BATCH) {
+        for (int i = 0; i < RING_BENCH_BATCH; i++) {
+            batch[i] = next + i;
+        }
+        for (size_t done = 0; done < RING_BENCH_BATCH; ) {
+            size_t pushed = ring_int_spsc_push_n(ring, batch + done, RING_BENCH_BATCH - done);
+            if (pushed == 0) {
+                sched_yield();
+            }
+            done += pushed;
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+    Koliseo* kls = kls_new_conf_ext(512 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+    long long check = 0;
+
+    // Queues holding RING_BENCH_DEPTH items, each op pushing one at the back and popping one at the front
+    printf("steady queue, %i ops:\n", RING_BENCH_OPS);
+    ring_int* ring = ring_int_init(kls, 0);
+    BENCH_ARENA("  ring", kls, {
+        for (int i = 0; i < RING_BENCH_DEPTH; i++) ring_int_push_back(ring, i);
+        for (int i = 0; i < RING_BENCH_OPS; i++) {
+            int out = 0;
+            ring_int_push_back(ring, i);
+            ring_int_pop_front(ring, &out);
+            check += out;
+        }
+    });
+    // A darray queue pops by index, and compacts once half of it is popped
+    darray_int* arr = darray_int_init(kls);
+    BENCH_ARENA("  darray (compacting)", kls, {
+        size_t read = 0;
+        for (int i = 0; i < RING_BENCH_DEPTH; i++) darray_int_push(arr, i);
+        for (int i = 0; i < RING_BENCH_OPS; i++) {
+            darray_int_push(arr, i);
+            check += arr->items[read++];
+            if (read > arr->count / 2) {
+                memmove(arr->items, arr->items + read, (arr->count - read) * sizeof(int));
+                arr->count -= read;
+                read = 0;
+            }
+        }
+    });
+    IntList* dl = IntList_newList_kls(kls);
+    BENCH_ARENA("  dllist", kls, {
+        for (int i = 0; i < RING_BENCH_DEPTH; i++) IntList_insertEnd(dl, IntList_newNode_kls(kls, &i));
+        for (int i = 0; i < RING_BENCH_OPS; i++) {
+            IntList_insertEnd(dl, IntList_newNode_kls(kls, &i));
+            check += *dl->firstNode->data;
+            IntList_removeNode_kls(dl, dl->firstNode);
+        }
+    });
+
+    printf("batches of %i:\n", RING_BENCH_BATCH);
+    int batch[RING_BENCH_BATCH];
+    for (int i = 0; i < RING_BENCH_BATCH; i++) {
+        batch[i] = i;
+    }
+    BENCH_ARENA("  ring push_n + pop_n", kls, {
+        for (int i = 0; i < RING_BENCH_OPS; i += RING_BENCH_BATCH) {
+            ring_int_push_n(ring, batch, RING_BENCH_BATCH);
+            check += ring_int_pop_n(ring, batch, RING_BENCH_BATCH);
+        }
+    });
+    ring_int* shared = ring_int_init(kls, 4096);
+    BENCH_ARENA("  ring spsc, 2 threads", kls, {
+        pthread_t thread;
+        pthread_create(&thread, NULL, producer, shared);
+        int received = 0;
+        while (received < RING_BENCH_OPS) {
+            size_t got = ring_int_spsc_pop_n(shared, batch, RING_BENCH_BATCH);
+            if (got == 0) {
+                sched_yield();
+            }
+            for (size_t i = 0; i < got; i++) check += batch[i];
+            received += got;
+        }
+        pthread_join(thread, NULL);
+    });
+    printf("  -> check: {%lli}\n", check);
+
+    kls_free(kls);
+    return 0;
+}
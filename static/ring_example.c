@@ -0,0 +1,91 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#define RING_T int
+#include "ring.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define RING_EXAMPLE_ITEMS 100000
+
+static void* producer(void* arg)
+{
+    ring_int* ring = arg;
+    int batch[64];
+    for (int next = 0; next < RING_EXAMPLE_ITEMS; ) {
+        int n = 0;
+        for (; n < 64 && next + n < RING_EXAMPLE_ITEMS; n++) {
+            batch[n] = next + n;
+        }
+        for (size_t done = 0; done < (size_t) n; ) {
+            size_t pushed = ring_int_spsc_push_n(ring, batch + done, n - done);
+            if (pushed == 0) {
+                sched_yield();
+            }
+            done += pushed;
+        }
+        next += n;
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+
+    // As a deque
+    ring_int* ring = ring_int_init(kls, 4);
+    for (int i = 1; i <= 20; i++) {
+        ring_int_push_back(ring, i);
+    }
+    ring_int_push_front(ring, 0);
+    int out = 0;
+    ring_int_pop_back(ring, &out);
+    printf("count: {%zu}, capacity: {%zu}, popped back: {%i}, front: {%i}\n", ring_int_count(ring), ring->capacity, out, *ring_int_at(ring, 0));
+
+    // In bulk
+    int batch[8] = { 100, 101, 102, 103, 104, 105, 106, 107 };
+    ring_int_push_n(ring, batch, 8);
+    int drained[64];
+    size_t n = ring_int_pop_n(ring, drained, 64);
+    printf("drained: {%zu}, first: {%i}, last: {%i}\n", n, drained[0], drained[n - 1]);
+
+    // Mixing the spsc and plain functions on a single thread
+    ring_int* mixed = ring_int_init(kls, 16);
+    for (int i = 0; i < 16; i++) {
+        ring_int_push_back(mixed, i);
+    }
+    ring_int_pop_n(mixed, drained, 16);
+    for (int i = 0; i < 10; i++) {
+        ring_int_push_back(mixed, i);
+    }
+    size_t pushed = ring_int_spsc_push_n(mixed, batch, 8);
+    printf("spsc pushed: {%zu}, count: {%zu}, front: {%i}\n", pushed, ring_int_count(mixed), *ring_int_at(mixed, 0));
+    if (pushed != 6 || ring_int_count(mixed) != 16 || *ring_int_at(mixed, 0) != 0) {
+        fprintf(stderr, "spsc_push_n() went past a stale head.\n");
+        kls_free(kls);
+        return 1;
+    }
+
+    // Between a producer and a consumer thread
+    ring_int* shared = ring_int_init(kls, 256);
+    pthread_t thread;
+    pthread_create(&thread, NULL, producer, shared);
+    long long sum = 0;
+    int received = 0;
+    while (received < RING_EXAMPLE_ITEMS) {
+        size_t got = ring_int_spsc_pop_n(shared, drained, 64);
+        if (got == 0) {
+            sched_yield();
+        }
+        for (size_t i = 0; i < got; i++) {
+            sum += drained[i];
+        }
+        received += got;
+    }
+    pthread_join(thread, NULL);
+    printf("received: {%i}, sum: {%lli}\n", received, sum);
+
+    kls_free(kls);
+    return 0;
+}
@@ -0,0 +1,41 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+#define DARRAY_T int
+#include "darray.h"
+#define SEGARRAY_T int
+#include "segarray.h"
+
+#define SEGARRAY_BENCH_COUNT (1 << 24)
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    // Arrays live on arr_kls, cleared before each case so that its pages are already mapped
+    Koliseo* arr_kls = kls_new_conf_ext(512 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    memset(KLS_PUSH_ARR(arr_kls, char, 256 * 1024 * 1024), 1, 256 * 1024 * 1024);
+    long long check = 0;
+
+    darray_int* d = NULL;
+    kls_clear(arr_kls);
+    BENCH("darray push", d = darray_int_init(arr_kls); for (int i = 0; i < SEGARRAY_BENCH_COUNT; i++) darray_int_push(d, i));
+    printf("  -> arena used: {%td} bytes\n", arr_kls->offset);
+    BENCH("darray index", for (int i = 0; i < SEGARRAY_BENCH_COUNT; i++) check += d->items[i]);
+
+    segarray_int* s = NULL;
+    kls_clear(arr_kls);
+    BENCH("segarray push", s = segarray_int_init(arr_kls); for (int i = 0; i < SEGARRAY_BENCH_COUNT; i++) segarray_int_push(s, i));
+    printf("  -> arena used: {%td} bytes\n", arr_kls->offset);
+    BENCH("segarray index", for (int i = 0; i < SEGARRAY_BENCH_COUNT; i++) check += *segarray_int_at(s, i));
+    BENCH("segarray segment scan", for (size_t k = 0; k < s->segment_count; k++) {
+        int* items = NULL;
+        size_t len = segarray_int_segment(s, k, &items);
+        for (size_t i = 0; i < len; i++) check += items[i];
+    });
+    printf("  -> check: {%lli}\n", check);
+
+    kls_free(arr_kls);
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <assert.h>
+#include "koliseo.h"
+#define SEGARRAY_T int
+#include "segarray.h"
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE * 4);
+    segarray_int* arr = segarray_int_init(kls);
+
+    int* first = segarray_int_push(arr, 42);
+    for (int i = 1; i < 1000; i++) {
+        segarray_int_push(arr, i);
+    }
+    // Growing never moves items
+    assert(first == segarray_int_at(arr, 0) && *first == 42);
+    printf("count: %zu, capacity: %zu, segments: %zu\n", arr->count, arr->capacity, arr->segment_count);
+    printf("{#500: %i}, {#999: %i}\n", *segarray_int_at(arr, 500), *segarray_int_at(arr, 999));
+
+    int more[100];
+    for (int i = 0; i < 100; i++) {
+        more[i] = -i;
+    }
+    segarray_int_push_n(arr, more, 100);
+
+    // Sum segment by segment, over contiguous items
+    long long sum = 0;
+    for (size_t k = 0; k < arr->segment_count; k++) {
+        int* items = NULL;
+        size_t len = segarray_int_segment(arr, k, &items);
+        for (size_t i = 0; i < len; i++) {
+            sum += items[i];
+        }
+    }
+    printf("count: %zu, sum: %lli\n", arr->count, sum);
+
+    segarray_int_truncate(arr, 10);
+    printf("count: %zu, {#9: %i}\n", arr->count, *segarray_int_at(arr, 9));
+
+    Koliseo_Temp* t_kls = kls_temp_start(kls);
+    segarray_int* arr_t = segarray_int_init_t(t_kls);
+    segarray_int_reserve(arr_t, 100);
+    printf("temp capacity: %zu\n", arr_t->capacity);
+    kls_temp_end(t_kls);
+
+    kls_free(kls);
+    return 0;
+}
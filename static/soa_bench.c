@@ -0,0 +1,47 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+
+typedef struct Body {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    int id;
+    char name[32];
+} Body;
+
+#define DARRAY_T Body
+#define DARRAY_NAME darray_body
+#include "darray.h"
+
+#define SOA_NAME bodies
+#define SOA_FIELDS(X) X(float, x) X(float, y) X(float, z) X(float, vx) X(float, vy) X(float, vz) X(float, mass) X(int, id)
+#include "soa.h"
+
+#define SOA_BENCH_COUNT (1 << 22)
+#define SOA_BENCH_PASSES 16
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    Koliseo* kls = kls_new_conf_ext(1024 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+
+    darray_body* aos = darray_body_init(kls);
+    bodies* soa = bodies_init(kls);
+    BENCH("darray push", for (int i = 0; i < SOA_BENCH_COUNT; i++) darray_body_push(aos, (Body) { .x = (float) i, .vx = 1.0f, .mass = 1.0f, .id = i }));
+    BENCH("soa push", for (int i = 0; i < SOA_BENCH_COUNT; i++) bodies_push(soa, (float) i, 0, 0, 1.0f, 0, 0, 1.0f, i));
+
+    // One column read, one updated from another
+    double sum = 0;
+    BENCH("darray sum x", for (int p = 0; p < SOA_BENCH_PASSES; p++) for (size_t i = 0; i < aos->count; i++) sum += aos->items[i].x);
+    BENCH("soa sum x", for (int p = 0; p < SOA_BENCH_PASSES; p++) for (size_t i = 0; i < soa->count; i++) sum += soa->x[i]);
+    BENCH("darray x += vx", for (int p = 0; p < SOA_BENCH_PASSES; p++) for (size_t i = 0; i < aos->count; i++) aos->items[i].x += aos->items[i].vx);
+    BENCH("soa x += vx", for (int p = 0; p < SOA_BENCH_PASSES; p++) for (size_t i = 0; i < soa->count; i++) soa->x[i] += soa->vx[i]);
+    printf("  -> check: {%.0f, %.0f, %.0f}\n", sum, aos->items[SOA_BENCH_COUNT - 1].x, soa->x[SOA_BENCH_COUNT - 1]);
+
+    kls_free(kls);
+    return 0;
+}
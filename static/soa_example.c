@@ -0,0 +1,42 @@
+#include <assert.h>
+#include "koliseo.h"
+#define SOA_NAME particles
+#define SOA_FIELDS(X) X(float, x) X(float, vx) X(int, id)
+#include "soa.h"
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE * 4);
+    particles* ps = particles_init(kls);
+
+    for (int i = 0; i < 100; i++) {
+        particles_push(ps, (float) i, 0.5f, i);
+    }
+    printf("count: %zu, capacity: %zu\n", ps->count, ps->capacity);
+
+    // A loop over two columns only reads those
+    for (size_t i = 0; i < ps->count; i++) {
+        ps->x[i] += ps->vx[i];
+    }
+    particles_row r = particles_get(ps, 10);
+    printf("{x: %.1f, vx: %.1f, id: %i}\n", r.x, r.vx, r.id);
+
+    r.id = -1;
+    particles_set(ps, 10, r);
+    particles_swap_remove(ps, 0);
+    assert(ps->id[0] == 99);
+    particles_truncate(ps, 11);
+    particles_push_row(ps, (particles_row) { .x = 1.0f, .vx = 2.0f, .id = 42 });
+    for (size_t i = 8; i < ps->count; i++) {
+        printf("{#%zu: x: %.1f, id: %i}\n", i, ps->x[i], ps->id[i]);
+    }
+
+    Koliseo_Temp* t_kls = kls_temp_start(kls);
+    particles* ps_t = particles_init_t(t_kls);
+    particles_reserve(ps_t, 1000);
+    printf("temp capacity: %zu, aligned: %s\n", ps_t->capacity, ((uintptr_t) ps_t->vx % 64 == 0 ? "true" : "false"));
+    kls_temp_end(t_kls);
+
+    kls_free(kls);
+    return 0;
+}
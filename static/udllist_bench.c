@@ -0,0 +1,54 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "koliseo.h"
+#include "bench.h"
+
+#define LIST_T int
+#define LIST_NAME IntList
+#include "dllist.h"
+
+#define UDLIST_T int
+#define UDLIST_NAME IntUList
+#include "udllist.h"
+
+#define UDLLIST_BENCH_COUNT 1000000
+#define UDLLIST_BENCH_LOOKUPS 1000
+
+int main(void)
+{
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    Koliseo* kls = kls_new_conf_ext(256 * 1024 * 1024, KLS_DEFAULT_CONF, &(KLS_Hooks) {0}, NULL, 0);
+    kls->conf.kls_growable = 1;
+    long long check = 0;
+    // Positions for lookups and middle inserts, from a xorshift generator
+    size_t* pos = KLS_PUSH_ARR(kls, size_t, UDLLIST_BENCH_LOOKUPS);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < UDLLIST_BENCH_LOOKUPS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        pos[i] = state % UDLLIST_BENCH_COUNT;
+    }
+
+    printf("dllist:\n");
+    IntList* dl = IntList_newList_kls(kls);
+    BENCH("  insertEnd (10^6)", for (int i = 0; i < UDLLIST_BENCH_COUNT; i++) IntList_insertEnd(dl, IntList_newNode_kls(kls, &i)));
+    BENCH("  iterate", for (int_item* n = dl->firstNode; n != NULL; n = n->next) check += *n->data);
+    BENCH("  getNodeAt (10^3)", for (size_t i = 0; i < UDLLIST_BENCH_LOOKUPS; i++) check += *IntList_getNodeAt(dl, (int) pos[i])->data);
+    BENCH("  insertAfter getNodeAt (10^3)", for (int i = 0; i < UDLLIST_BENCH_LOOKUPS; i++) IntList_insertAfter(dl, IntList_getNodeAt(dl, (int) pos[i]), IntList_newNode_kls(kls, &i)));
+    printf("  -> arena used: {%td} bytes\n", kls->offset);
+
+    printf("udllist:\n");
+    ptrdiff_t before = kls->offset;
+    IntUList* ul = IntUList_newList_kls(kls);
+    BENCH("  insertEnd (10^6)", for (int i = 0; i < UDLLIST_BENCH_COUNT; i++) IntUList_insertEnd(ul, i));
+    BENCH("  iterate", for (IntUList_node* n = ul->firstNode; n != NULL; n = n->next) for (size_t i = 0; i < n->count; i++) check += n->items[n->start + i]);
+    BENCH("  getAt (10^3)", for (size_t i = 0; i < UDLLIST_BENCH_LOOKUPS; i++) check += *IntUList_getAt(ul, pos[i]));
+    BENCH("  insertAt (10^3)", for (int i = 0; i < UDLLIST_BENCH_LOOKUPS; i++) IntUList_insertAt(ul, pos[i] + 1, i));
+    printf("  -> arena used: {%td} bytes\n", kls->offset - before);
+    printf("  -> check: {%lli}\n", check);
+
+    kls_free(kls);
+    return 0;
+}
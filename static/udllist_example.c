@@ -0,0 +1,48 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include <koliseo.h>
+
+#define UDLIST_T int
+#define UDLIST_NAME IntUList
+#include "../templates/udllist.h"
+
+int main(void) {
+    printf("KLS API: v%s\n", string_koliseo_version());
+
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+
+    IntUList* il = IntUList_newList_kls(kls);
+    for (int i = 1; i <= 100; i++) {
+        IntUList_insertEnd(il, i);
+    }
+    IntUList_insertBeginning(il, 0);
+    IntUList_insertAt(il, 50, -1);
+    printf("len: {%zu}, #0: {%i}, #50: {%i}, #101: {%i}\n", il->len, *IntUList_getAt(il, 0), *IntUList_getAt(il, 50), *IntUList_getAt(il, 101));
+
+    int out = 0;
+    IntUList_removeAt(il, 50, &out);
+    printf("Removed #50: {%i}\n", out);
+    IntUList_popEnd(il, &out);
+    printf("Popped end: {%i}\n", out);
+
+    // Values are contiguous inside each node
+    long sum = 0;
+    int nodes = 0;
+    for (IntUList_node* node = il->firstNode; node != NULL; node = node->next) {
+        for (size_t i = 0; i < node->count; i++) {
+            sum += node->items[node->start + i];
+        }
+        nodes++;
+    }
+    printf("len: {%zu}, sum: {%li}, nodes: {%i}\n", il->len, sum, nodes);
+
+    Koliseo_Temp* t_kls = kls_temp_start(kls);
+    IntUList* il_t = IntUList_newList_t(t_kls);
+    IntUList_insertEnd(il_t, 42);
+    IntUList_popBeginning(il_t, &out);
+    printf("Temp list popped: {%i}, len: {%zu}\n", out, il_t->len);
+    kls_temp_end(t_kls);
+
+    kls_free(kls);
+    return 0;
+}
@@ -25,6 +25,10 @@
 | See DARRAY_NAME, DARRAY_PREFIX and DARRAY_LINKAGE for                           |
 | other customization points.                                                     |
 |                                                                                 |
+| Capacity doubles when full. Bulk functions grow once to fit                     |
+| all their items, and work for arrays on a Koliseo or on a                       |
+| Koliseo_Temp.                                                                   |
+|                                                                                 |
 | If you define DARRAY_DECLS_ONLY, only the declarations                          |
 | of the type and its function will be declared.                                  |
 \*********************************************************************************/
@@ -35,6 +39,7 @@
 // needed for all instantiations can go up here.
 #include <stdlib.h> // realloc, size_t
 #include <stdio.h> // fprintf, stderr
+#include <string.h> // memcpy, memmove
 
 #define DARRAY_IMPL(word) DARRAY_COMB1(DARRAY_PREFIX,word)
 #define DARRAY_COMB1(pre, word) DARRAY_COMB2(pre, word)
@@ -86,6 +91,13 @@ struct DARRAY_NAME {
 #define DARRAY_init DARRAY_IMPL(init)
 #define DARRAY_push_t DARRAY_IMPL(push_t)
 #define DARRAY_init_t DARRAY_IMPL(init_t)
+#define DARRAY_reserve DARRAY_IMPL(reserve)
+#define DARRAY_push_n DARRAY_IMPL(push_n)
+#define DARRAY_extend_from DARRAY_IMPL(extend_from)
+#define DARRAY_insert_at DARRAY_IMPL(insert_at)
+#define DARRAY_swap_remove DARRAY_IMPL(swap_remove)
+#define DARRAY_truncate DARRAY_IMPL(truncate)
+#define DARRAY_grow DARRAY_IMPL(grow_)
 
 #ifdef DARRAY_DECLS_ONLY
 
@@ -105,8 +117,52 @@ DARRAY_LINKAGE
 DARRAY_NAME
 DARRAY_init_t(Koliseo_Temp* t_kls);
 
+DARRAY_LINKAGE
+void
+DARRAY_reserve(DARRAY_NAME* array, size_t n);
+
+DARRAY_LINKAGE
+void
+DARRAY_push_n(DARRAY_NAME* array, DARRAY_T const* items, size_t n);
+
+DARRAY_LINKAGE
+void
+DARRAY_extend_from(DARRAY_NAME* array, const DARRAY_NAME* other);
+
+DARRAY_LINKAGE
+void
+DARRAY_insert_at(DARRAY_NAME* array, size_t index, DARRAY_T item);
+
+DARRAY_LINKAGE
+DARRAY_T
+DARRAY_swap_remove(DARRAY_NAME* array, size_t index);
+
+DARRAY_LINKAGE
+void
+DARRAY_truncate(DARRAY_NAME* array, size_t count);
+
 #else
 
+// Moves the items to a new push holding at least min_cap of them, doubling the capacity as needed.
+static inline void DARRAY_grow(DARRAY_NAME* array, size_t min_cap)
+{
+    size_t old_cap = array->capacity;
+    size_t new_cap = old_cap?old_cap*2:DARRAY_STARTING_CAPACITY;
+    while (new_cap < min_cap) {
+        new_cap *= 2;
+    }
+    if (array->use_temp) {
+        array->items = KLS_REPUSH_T(array->allocator.t_kls, array->items, DARRAY_T, old_cap, new_cap);
+    } else {
+        array->items = KLS_REPUSH(array->allocator.kls, array->items, DARRAY_T, old_cap, new_cap);
+    }
+    if (!array->items) {
+        fprintf(stderr, "In %s, at %i: %s(): failed KLS_REPUSH()\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    array->capacity = new_cap;
+}
+
 DARRAY_LINKAGE
 void
 DARRAY_push(DARRAY_NAME* array, DARRAY_T item)
@@ -116,15 +172,7 @@ DARRAY_push(DARRAY_NAME* array, DARRAY_T item)
         exit(EXIT_FAILURE);
     }
     if(array->count >= array->capacity) {
-        size_t old_cap = array->capacity;
-        size_t new_cap = old_cap?old_cap*2:4;
-        // size_t new_size = new_cap * sizeof(DARRAY_T);
-        array->items = KLS_REPUSH(array->allocator.kls, array->items, DARRAY_T, old_cap, new_cap);
-        if (!array->items) {
-            fprintf(stderr, "In %s, at %i: %s(): failed KLS_REPUSH()\n", __FILE__, __LINE__, __func__);
-            exit(EXIT_FAILURE);
-        }
-        array->capacity = new_cap;
+        DARRAY_grow(array, array->count + 1);
     }
     array->items[array->count++] = item;
 }
@@ -159,15 +207,7 @@ DARRAY_push_t(DARRAY_NAME* array, DARRAY_T item)
         exit(EXIT_FAILURE);
     }
     if(array->count >= array->capacity) {
-        size_t old_cap = array->capacity;
-        size_t new_cap = old_cap?old_cap*2:4;
-        // size_t new_size = new_cap * sizeof(DARRAY_T);
-        array->items = KLS_REPUSH_T(array->allocator.t_kls, array->items, DARRAY_T, old_cap, new_cap);
-        if (!array->items) {
-            fprintf(stderr, "In %s, at %i: %s(): failed KLS_REPUSH()\n", __FILE__, __LINE__, __func__);
-            exit(EXIT_FAILURE);
-        }
-        array->capacity = new_cap;
+        DARRAY_grow(array, array->count + 1);
     }
     array->items[array->count++] = item;
 }
@@ -194,6 +234,74 @@ DARRAY_init_t(Koliseo_Temp* t_kls)
     return res;
 }
 
+DARRAY_LINKAGE
+void
+DARRAY_reserve(DARRAY_NAME* array, size_t n)
+{
+    // Makes room for at least n more items, so that the next n pushes do not move the array.
+    if (array->count + n > array->capacity) {
+        DARRAY_grow(array, array->count + n);
+    }
+}
+
+DARRAY_LINKAGE
+void
+DARRAY_push_n(DARRAY_NAME* array, DARRAY_T const* items, size_t n)
+{
+    // Appends n items with a single copy. items may point into the array itself.
+    if (n == 0) return;
+    DARRAY_reserve(array, n);
+    // Old items stay readable after a move, as the Koliseo keeps them
+    memcpy(array->items + array->count, items, n * sizeof(DARRAY_T));
+    array->count += n;
+}
+
+DARRAY_LINKAGE
+void
+DARRAY_extend_from(DARRAY_NAME* array, const DARRAY_NAME* other)
+{
+    DARRAY_push_n(array, other->items, other->count);
+}
+
+DARRAY_LINKAGE
+void
+DARRAY_insert_at(DARRAY_NAME* array, size_t index, DARRAY_T item)
+{
+    // Shifts the items from index on by one, keeping their order.
+    if (index > array->count) {
+        fprintf(stderr, "In %s, at %i: %s(): index {%zu} is past count {%zu}\n", __FILE__, __LINE__, __func__, index, array->count);
+        exit(EXIT_FAILURE);
+    }
+    DARRAY_reserve(array, 1);
+    memmove(array->items + index + 1, array->items + index, (array->count - index) * sizeof(DARRAY_T));
+    array->items[index] = item;
+    array->count++;
+}
+
+DARRAY_LINKAGE
+DARRAY_T
+DARRAY_swap_remove(DARRAY_NAME* array, size_t index)
+{
+    // Removes and returns the item at index in O(1), moving the last item in its place.
+    if (index >= array->count) {
+        fprintf(stderr, "In %s, at %i: %s(): index {%zu} is not below count {%zu}\n", __FILE__, __LINE__, __func__, index, array->count);
+        exit(EXIT_FAILURE);
+    }
+    DARRAY_T item = array->items[index];
+    array->items[index] = array->items[--array->count];
+    return item;
+}
+
+DARRAY_LINKAGE
+void
+DARRAY_truncate(DARRAY_NAME* array, size_t count)
+{
+    // Drops the items from count on. The capacity is kept for later pushes.
+    if (count < array->count) {
+        array->count = count;
+    }
+}
+
 #endif // DARRAY_DECLS_ONLY
 
 // Cleanup
@@ -208,6 +316,13 @@ DARRAY_init_t(Koliseo_Temp* t_kls)
 #undef DARRAY_init
 #undef DARRAY_push_t
 #undef DARRAY_init_t
+#undef DARRAY_reserve
+#undef DARRAY_push_n
+#undef DARRAY_extend_from
+#undef DARRAY_insert_at
+#undef DARRAY_swap_remove
+#undef DARRAY_truncate
+#undef DARRAY_grow
 #ifdef DARRAY_DECLS_ONLY
 #undef DARRAY_DECLS_ONLY
 #endif // DARRAY_DECLS_ONLY
@@ -174,7 +174,7 @@ LIST_newNode_gl(LIST_T* data)
         *(new_node->data) = *data;
         return new_node;
     }
-};
+}
 
 LIST_LINKAGE
 LIST_ITEM_NAME*
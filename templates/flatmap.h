@@ -0,0 +1,414 @@
+#ifdef HASHMAP_T //This ensures the library never causes any trouble if this macro was not defined.
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/*********************************************************************************\
+| flatmap.h                                                                       |
+| This code is based on an idea from https://www.davidpriver.com/ctemplates.html. |
+| Include this header multiple times to implement an                              |
+| open addressing hashmap, with the same customization points                     |
+| as hashmap.h. Before inclusion define at least HASHMAP_T to                     |
+| the type of values the hashmap can hold.                                        |
+| See HASHMAP_NAME, HASHMAP_PREFIX and HASHMAP_LINKAGE for                        |
+| other customization points.                                                     |
+|                                                                                 |
+| Slots hold the key, its hash and the value inline, and are                      |
+| found by probing groups of FLATMAP_GROUP control bytes: each                    |
+| holds 7 bits of the hash of a full slot, or marks it empty or                   |
+| deleted. Groups are matched with SSE2 when available.                           |
+| Tables live on the passed Koliseo, and are moved to a new push                  |
+| when more than 7/8 of the slots are taken.                                      |
+|                                                                                 |
+| Not a drop-in for hashmap.h: push() copies *value into the                      |
+| slot, where hashmap.h keeps the caller's HASHMAP_T pointer.                     |
+| Changing the passed value after push() does not change the                      |
+| map, and pointers from get() or next() are only valid until                     |
+| the next push(), which may move the table.                                      |
+|                                                                                 |
+| If you define HASHMAP_DECLS_ONLY, only the declarations                          |
+| of the type and its function will be declared.                                  |
+\*********************************************************************************/
+
+#ifndef FLATMAP_HEADER_H
+#define FLATMAP_HEADER_H
+// Inline functions, #defines and includes that will be
+// needed for all instantiations can go up here.
+#include <stdlib.h> // size_t
+#include <stdio.h> // fprintf, stderr
+#include <stdint.h> // uint8_t, uint64_t
+#include <string.h> // memcmp, memcpy, memset
+#if defined(__SSE2__) && !defined(FLATMAP_NO_SIMD)
+#define FLATMAP_HAS_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__ && !FLATMAP_NO_SIMD
+
+#define FLATMAP_IMPL(word) FLATMAP_COMB1(HASHMAP_PREFIX,word)
+#define FLATMAP_COMB1(pre, word) FLATMAP_COMB2(pre, word)
+#define FLATMAP_COMB2(pre, word) pre##word
+
+#define FLATMAP_GROUP 16 /**< Number of control bytes matched at once.*/
+#define FLATMAP_EMPTY 0x80 /**< Control byte for a never used slot.*/
+#define FLATMAP_DELETED 0xFE /**< Control byte for a removed slot.*/
+#define FLATMAP_H2(hash) ((uint8_t)((hash) >> 57)) /**< Hash bits kept in the control byte of a full slot.*/
+
+// Returns a bitmask of the bytes in the group starting at ctrl equal to c.
+static inline uint32_t flatmap__match(const uint8_t* ctrl, uint8_t c)
+{
+#ifdef FLATMAP_HAS_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*) ctrl);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) c)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < FLATMAP_GROUP; i++) {
+        mask |= (uint32_t)(ctrl[i] == c) << i;
+    }
+    return mask;
+#endif // FLATMAP_HAS_SSE2
+}
+
+// Returns a bitmask of the empty or deleted bytes in the group starting at ctrl.
+static inline uint32_t flatmap__match_free(const uint8_t* ctrl)
+{
+#ifdef FLATMAP_HAS_SSE2
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) ctrl));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < FLATMAP_GROUP; i++) {
+        mask |= (uint32_t)(ctrl[i] >> 7) << i;
+    }
+    return mask;
+#endif // FLATMAP_HAS_SSE2
+}
+
+static inline int flatmap__ctz(uint32_t mask)
+{
+    return __builtin_ctz(mask);
+}
+
+// Returns the smallest power of two slot count holding count entries under 7/8 load.
+static inline size_t flatmap__cap_for(size_t count)
+{
+    size_t cap = FLATMAP_GROUP;
+    while (cap - cap / 8 < count) {
+        cap *= 2;
+    }
+    return cap;
+}
+
+#include "hashmap_hash.h" // HASHMAP_fnv_1a_hash_str, HASHMAP_wyhash_str, ...
+
+#endif // FLATMAP_HEADER_H
+
+// NOTE: this section is *not* guarded as it is intended
+// to be included multiple times.
+
+#ifndef HASHMAP_T
+#error "HASHMAP_T must be defined"
+#endif
+
+// The name of the data type to be generated.
+// If not given, will expand to something like
+// `flatmap_int` for an `int`.
+#ifndef HASHMAP_NAME
+#define HASHMAP_NAME FLATMAP_COMB1(FLATMAP_COMB1(flatmap,_), HASHMAP_T)
+#endif
+
+// Prefix for generated functions.
+#ifndef HASHMAP_PREFIX
+#define HASHMAP_PREFIX FLATMAP_COMB1(HASHMAP_NAME, _)
+#endif
+
+// Customize the linkage of the function.
+#ifndef HASHMAP_LINKAGE
+#define HASHMAP_LINKAGE static inline
+#endif
+#include "koliseo.h"
+
+#ifndef HASHMAP_SLOT_NAME
+#define HASHMAP_SLOT_NAME FLATMAP_COMB1(HASHMAP_NAME, _slot)
+#endif
+
+typedef struct HASHMAP_SLOT_NAME {
+    uint64_t hash;
+    const char* key;
+    size_t key_len;
+    HASHMAP_T value;
+} HASHMAP_SLOT_NAME;
+
+typedef struct HASHMAP_NAME {
+    Koliseo* kls;
+    uint8_t* ctrl; // One control byte per slot
+    HASHMAP_SLOT_NAME* slots;
+    size_t cap; // Number of slots, a power of two multiple of FLATMAP_GROUP
+    size_t count; // Number of full slots
+    size_t used; // Number of full or deleted slots
+} HASHMAP_NAME;
+
+#if defined(HASHMAP_HASH)
+#define FLATMAP_hash_str HASHMAP_HASH
+#elif defined(HASHMAP_HASH_FNV_1A)
+#define FLATMAP_hash_str HASHMAP_fnv_1a_hash_str
+#elif defined(HASHMAP_HASH_MURMUR2)
+#define FLATMAP_hash_str HASHMAP_murmur2_hash_str
+#elif defined(HASHMAP_HASH_WYHASH)
+#define FLATMAP_hash_str HASHMAP_wyhash_str
+#elif defined(HASHMAP_HASH_AES)
+#define FLATMAP_hash_str HASHMAP_aes_hash_str
+#else
+#define FLATMAP_hash_str HASHMAP_fnv_1a_hash_str
+#endif // HASHMAP_HASH
+#define FLATMAP_new FLATMAP_IMPL(new)
+#define FLATMAP_push FLATMAP_IMPL(push)
+#define FLATMAP_get FLATMAP_IMPL(get)
+#define FLATMAP_remove FLATMAP_IMPL(remove)
+#define FLATMAP_next FLATMAP_IMPL(next)
+#define FLATMAP_find FLATMAP_IMPL(find_)
+#define FLATMAP_find_free FLATMAP_IMPL(find_free_)
+#define FLATMAP_alloc FLATMAP_IMPL(alloc_)
+#define FLATMAP_rehash FLATMAP_IMPL(rehash_)
+
+#ifdef HASHMAP_DECLS_ONLY
+
+HASHMAP_LINKAGE
+HASHMAP_NAME*
+FLATMAP_new(Koliseo* kls, size_t bucket_count);
+
+HASHMAP_LINKAGE
+bool
+FLATMAP_push(HASHMAP_NAME* map, const char* key, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+HASHMAP_T*
+FLATMAP_get(HASHMAP_NAME* map, const char* key);
+
+HASHMAP_LINKAGE
+bool
+FLATMAP_remove(HASHMAP_NAME *map, const char *key);
+
+HASHMAP_LINKAGE
+bool
+FLATMAP_next(HASHMAP_NAME *map, size_t* it, const char** key, HASHMAP_T** value);
+#else
+
+// Returns the index of the slot holding key, or map->cap if it is missing.
+static inline size_t FLATMAP_find(HASHMAP_NAME* map, const char* key, size_t len, uint64_t h)
+{
+    size_t groups_mask = map->cap / FLATMAP_GROUP - 1;
+    size_t g = (size_t) h & groups_mask;
+    uint8_t h2 = FLATMAP_H2(h);
+    for (size_t step = 1; ; step++) {
+        const uint8_t* ctrl = map->ctrl + g * FLATMAP_GROUP;
+        uint32_t m = flatmap__match(ctrl, h2);
+        while (m != 0) {
+            size_t i = g * FLATMAP_GROUP + flatmap__ctz(m);
+            HASHMAP_SLOT_NAME* slot = &map->slots[i];
+            if (slot->hash == h && slot->key_len == len && memcmp(slot->key, key, len) == 0) {
+                return i;
+            }
+            m &= m - 1;
+        }
+        // Keys are never placed past a group with an empty slot
+        if (flatmap__match(ctrl, FLATMAP_EMPTY) != 0 || step > groups_mask) {
+            return map->cap;
+        }
+        // Triangular steps visit every group when their number is a power of two
+        g = (g + step) & groups_mask;
+    }
+}
+
+// Returns the index of the first empty or deleted slot on the probe sequence for h.
+static inline size_t FLATMAP_find_free(const uint8_t* ctrl, size_t cap, uint64_t h)
+{
+    size_t groups_mask = cap / FLATMAP_GROUP - 1;
+    size_t g = (size_t) h & groups_mask;
+    for (size_t step = 1; ; step++) {
+        uint32_t m = flatmap__match_free(ctrl + g * FLATMAP_GROUP);
+        if (m != 0) {
+            return g * FLATMAP_GROUP + flatmap__ctz(m);
+        }
+        g = (g + step) & groups_mask;
+    }
+}
+
+static inline bool FLATMAP_alloc(HASHMAP_NAME* map, size_t cap)
+{
+    uint8_t* ctrl = KLS_PUSH_ARR(map->kls, uint8_t, cap);
+    HASHMAP_SLOT_NAME* slots = KLS_PUSH_ARR(map->kls, HASHMAP_SLOT_NAME, cap);
+    if (!ctrl || !slots) {
+        fprintf(stderr, "In %s, at %i: %s(): failed pushing a table of {%zu} slots.\n", __FILE__, __LINE__, __func__, cap);
+        return false;
+    }
+    memset(ctrl, FLATMAP_EMPTY, cap);
+    map->ctrl = ctrl;
+    map->slots = slots;
+    map->cap = cap;
+    map->used = 0;
+    return true;
+}
+
+// Moves every full slot to a new table of cap slots, dropping deleted ones.
+// The old table is left on the Koliseo.
+static inline bool FLATMAP_rehash(HASHMAP_NAME* map, size_t cap)
+{
+    uint8_t* old_ctrl = map->ctrl;
+    HASHMAP_SLOT_NAME* old_slots = map->slots;
+    size_t old_cap = map->cap;
+    if (!FLATMAP_alloc(map, cap)) {
+        map->ctrl = old_ctrl;
+        map->slots = old_slots;
+        map->cap = old_cap;
+        return false;
+    }
+    for (size_t i = 0; i < old_cap; i++) {
+        if (old_ctrl[i] & FLATMAP_EMPTY) continue;
+        size_t j = FLATMAP_find_free(map->ctrl, map->cap, old_slots[i].hash);
+        map->ctrl[j] = old_ctrl[i];
+        map->slots[j] = old_slots[i];
+    }
+    map->used = map->count;
+    return true;
+}
+
+HASHMAP_LINKAGE
+HASHMAP_NAME *FLATMAP_new(Koliseo* kls, size_t bucket_count)
+{
+    HASHMAP_NAME *map = KLS_PUSH(kls, HASHMAP_NAME);
+    if (!map) return NULL;
+    map->kls = kls;
+    map->count = 0;
+    if (!FLATMAP_alloc(map, flatmap__cap_for(bucket_count))) {
+        return NULL;
+    }
+    return map;
+}
+
+HASHMAP_LINKAGE
+bool FLATMAP_push(HASHMAP_NAME *map, const char *key, HASHMAP_T *value)
+{
+    size_t len = strlen(key);
+    uint64_t h = FLATMAP_hash_str(key, len);
+    size_t i = FLATMAP_find(map, key, len, h);
+    if (i != map->cap) {
+        map->slots[i].value = *value; // Replace
+        return false;
+    }
+    if (map->used + 1 > map->cap - map->cap / 8) {
+        // Only grow when deleted slots are not enough to make room
+        size_t cap = (map->count + 1 > map->cap / 2 ? map->cap * 2 : map->cap);
+        if (!FLATMAP_rehash(map, cap)) {
+            return false;
+        }
+    }
+    char* key_dup = KLS_PUSH_ARR(map->kls, char, len + 1);
+    if (!key_dup) return false;
+    memcpy(key_dup, key, len);
+    i = FLATMAP_find_free(map->ctrl, map->cap, h);
+    if (map->ctrl[i] == FLATMAP_EMPTY) {
+        map->used += 1;
+    }
+    map->ctrl[i] = FLATMAP_H2(h);
+    map->slots[i] = (HASHMAP_SLOT_NAME) {
+        .hash = h,
+        .key = key_dup,
+        .key_len = len,
+        .value = *value,
+    };
+    map->count += 1;
+    return true;
+}
+
+HASHMAP_LINKAGE
+HASHMAP_T *FLATMAP_get(HASHMAP_NAME *map, const char *key)
+{
+    size_t len = strlen(key);
+    size_t i = FLATMAP_find(map, key, len, FLATMAP_hash_str(key, len));
+    return (i == map->cap ? NULL : &map->slots[i].value);
+}
+
+HASHMAP_LINKAGE
+bool FLATMAP_remove(HASHMAP_NAME *map, const char *key)
+{
+    size_t len = strlen(key);
+    size_t i = FLATMAP_find(map, key, len, FLATMAP_hash_str(key, len));
+    if (i == map->cap) {
+        return false;
+    }
+    // Probes stop at a group with an empty slot anyway, so no tombstone is needed there
+    const uint8_t* group = map->ctrl + (i / FLATMAP_GROUP) * FLATMAP_GROUP;
+    if (flatmap__match(group, FLATMAP_EMPTY) != 0) {
+        map->ctrl[i] = FLATMAP_EMPTY;
+        map->used -= 1;
+    } else {
+        map->ctrl[i] = FLATMAP_DELETED;
+    }
+    map->count -= 1;
+    return true;
+}
+
+HASHMAP_LINKAGE
+bool FLATMAP_next(HASHMAP_NAME *map, size_t* it, const char** key, HASHMAP_T** value)
+{
+    // Walks full slots in table order, starting from *it. Start with *it == 0.
+    for (size_t i = *it; i < map->cap; i++) {
+        if (map->ctrl[i] & FLATMAP_EMPTY) continue;
+        if (key) *key = map->slots[i].key;
+        if (value) *value = &map->slots[i].value;
+        *it = i + 1;
+        return true;
+    }
+    *it = map->cap;
+    return false;
+}
+#endif // HASHMAP_DECLS_ONLY
+
+// Cleanup
+// These need to be undef'ed so they can be redefined the
+// next time you need to instantiate this template.
+#undef HASHMAP_T
+#undef HASHMAP_PREFIX
+#undef HASHMAP_NAME
+#undef HASHMAP_SLOT_NAME
+#undef HASHMAP_LINKAGE
+#undef FLATMAP_hash_str
+#ifdef HASHMAP_HASH
+#undef HASHMAP_HASH
+#endif // HASHMAP_HASH
+#ifdef HASHMAP_HASH_FNV_1A
+#undef HASHMAP_HASH_FNV_1A
+#endif // HASHMAP_HASH_FNV_1A
+#ifdef HASHMAP_HASH_MURMUR2
+#undef HASHMAP_HASH_MURMUR2
+#endif // HASHMAP_HASH_MURMUR2
+#ifdef HASHMAP_HASH_WYHASH
+#undef HASHMAP_HASH_WYHASH
+#endif // HASHMAP_HASH_WYHASH
+#ifdef HASHMAP_HASH_AES
+#undef HASHMAP_HASH_AES
+#endif // HASHMAP_HASH_AES
+#undef FLATMAP_new
+#undef FLATMAP_push
+#undef FLATMAP_get
+#undef FLATMAP_remove
+#undef FLATMAP_next
+#undef FLATMAP_find
+#undef FLATMAP_find_free
+#undef FLATMAP_alloc
+#undef FLATMAP_rehash
+#ifdef HASHMAP_DECLS_ONLY
+#undef HASHMAP_DECLS_ONLY
+#endif // HASHMAP_DECLS_ONLY
+#endif // HASHMAP_T
@@ -25,6 +25,21 @@
 | See HASHMAP_NAME, HASHMAP_PREFIX and HASHMAP_LINKAGE for                           |
 | other customization points.                                                     |
 |                                                                                 |
+| Buckets are NULL until a key lands in them. Nodes keep the hash                 |
+| and length of their key, so keys need no terminator: see the                    |
+| _n functions, and the Kstr ones when kls_gulp.h was included first.             |
+| Once the map holds more than HASHMAP_MAX_LOAD percent of its                    |
+| bucket count, it starts moving to a table with twice the buckets,               |
+| pushed on the same Koliseo or Koliseo_Temp. With HASHMAP_REHASH_STEP             |
+| left at 0 it moves all at once, otherwise that many buckets are                 |
+| moved on each push or remove.                                                   |
+|                                                                                 |
+| Define HASHMAP_KEY_T to use keys of another type, stored by value,              |
+| with HASHMAP_KEY_HASH and HASHMAP_KEY_EQ to hash and compare them.              |
+| See hashmap_hash.h for the HASHMAP_HASH* macros picking the hash.               |
+| Define HASHMAP_BY_VALUE to store values inline instead of                       |
+| pointers: push copies the passed value, get points into the node.               |
+|                                                                                 |
 | If you define HASHMAP_DECLS_ONLY, only the declarations                          |
 | of the type and its function will be declared.                                  |
 \*********************************************************************************/
@@ -35,11 +50,15 @@
 // needed for all instantiations can go up here.
 #include <stdlib.h> // realloc, size_t
 #include <stdio.h> // fprintf, stderr
+#include <stdint.h> // uint8_t, uint64_t
+#include <string.h> // memcpy, strcmp
 
 #define HASHMAP_IMPL(word) HASHMAP_COMB1(HASHMAP_PREFIX,word)
 #define HASHMAP_COMB1(pre, word) HASHMAP_COMB2(pre, word)
 #define HASHMAP_COMB2(pre, word) pre##word
 
+#include "hashmap_hash.h" // HASHMAP_fnv_1a_hash_str, HASHMAP_wyhash_str, ...
+
 #endif // HASHMAP_HEADER_H
 
 // NOTE: this section is *not* guarded as it is intended
@@ -72,11 +91,42 @@
 #define HASHMAP_NODE_NAME HASHMAP_COMB1(HASHMAP_NAME, _node)
 #endif
 
+#ifdef HASHMAP_KEY_T
+#ifndef HASHMAP_KEY_HASH
+#error "HASHMAP_KEY_HASH must be defined when HASHMAP_KEY_T is"
+#endif // HASHMAP_KEY_HASH
+// Compares two keys, defaults to ==.
+#ifndef HASHMAP_KEY_EQ
+#define HASHMAP_KEY_EQ(a, b) ((a) == (b))
+#endif // HASHMAP_KEY_EQ
+#define HASHMAP_KEY_PARAMS HASHMAP_KEY_T key
+#else
+#define HASHMAP_KEY_PARAMS const char* key, size_t len
+#endif // HASHMAP_KEY_T
+
 typedef struct HASHMAP_NODE_NAME {
-    char* key;
+#ifdef HASHMAP_KEY_T
+    HASHMAP_KEY_T key;
+#else
+    char* key; // Null-terminated copy of the key
+    size_t key_len;
+#endif // HASHMAP_KEY_T
+    uint64_t hash;
+#ifdef HASHMAP_BY_VALUE
+    HASHMAP_T value;
+#else
     HASHMAP_T* value;
+#endif // HASHMAP_BY_VALUE
 } HASHMAP_NODE_NAME;
 
+#ifdef HASHMAP_BY_VALUE
+#define HASHMAP_VALUE_IN(v) (*(v))
+#define HASHMAP_VALUE_OUT(node) (&(node).value)
+#else
+#define HASHMAP_VALUE_IN(v) (v)
+#define HASHMAP_VALUE_OUT(node) ((node).value)
+#endif // HASHMAP_BY_VALUE
+
 #define DARRAY_T HASHMAP_NODE_NAME
 #define DARRAY_NAME HASHMAP_COMB1(da_, HASHMAP_NODE_NAME)
 #define DARRAY_LINKAGE static inline
@@ -86,46 +136,91 @@ typedef struct HASHMAP_NODE_NAME {
 #define DARRAY_NAME HASHMAP_COMB1(da_, HASHMAP_NODE_NAME)
 #define HASHMAP_DA_IMPL(word) HASHMAP_COMB1(HASHMAP_COMB1(DARRAY_NAME, _), word)
 
+// Percent of bucket_count the map can hold before growing.
+#ifndef HASHMAP_MAX_LOAD
+#define HASHMAP_MAX_LOAD 100
+#endif // HASHMAP_MAX_LOAD
+
+// Number of old buckets moved on each push or remove while growing. 0 moves them all at once.
+#ifndef HASHMAP_REHASH_STEP
+#define HASHMAP_REHASH_STEP 0
+#endif // HASHMAP_REHASH_STEP
+
 typedef struct HASHMAP_NAME {
     size_t bucket_count;
     DARRAY_NAME** buckets;
     Koliseo* kls;
+    Koliseo_Temp* t_kls; // Set when the map lives in a Koliseo_Temp
+    size_t count; // Number of keys
+    DARRAY_NAME** old_buckets; // Table being moved from while growing, or NULL
+    size_t old_bucket_count;
+    size_t rehash_pos; // Old buckets before this one were moved
 } HASHMAP_NAME;
 
-#ifndef HASHMAP_HASH
-#ifdef HASHMAP_HASH_FNV_1A
+#if defined(HASHMAP_HASH)
+#define HASHMAP_hash_str HASHMAP_HASH
+#elif defined(HASHMAP_HASH_FNV_1A)
 #define HASHMAP_hash_str HASHMAP_fnv_1a_hash_str
-#else
-#ifdef HASHMAP_HASH_MURMUR2
+#elif defined(HASHMAP_HASH_MURMUR2)
 #define HASHMAP_hash_str HASHMAP_murmur2_hash_str
+#elif defined(HASHMAP_HASH_WYHASH)
+#define HASHMAP_hash_str HASHMAP_wyhash_str
+#elif defined(HASHMAP_HASH_AES)
+#define HASHMAP_hash_str HASHMAP_aes_hash_str
 #else
 #define HASHMAP_hash_str HASHMAP_fnv_1a_hash_str
-#endif // HASHMAP_HASH_MURMUR2
-#endif // HASHMAP_HASH_FNV_1A
-#else
-#define HASHMAP_hash_str HASHMAP_HASH
 #endif // HASHMAP_HASH
 #define HASHMAP_new HASHMAP_IMPL(new)
+#define HASHMAP_new_t HASHMAP_IMPL(new_t)
+#define HASHMAP_alloc_table HASHMAP_IMPL(alloc_table_)
+#define HASHMAP_rehash_step HASHMAP_IMPL(rehash_step_)
+#define HASHMAP_bucket_push HASHMAP_IMPL(bucket_push_)
+#define HASHMAP_hash_key HASHMAP_IMPL(hash_key_)
+#define HASHMAP_key_eq HASHMAP_IMPL(key_eq_)
+#define HASHMAP_find HASHMAP_IMPL(find_)
 #define HASHMAP_push HASHMAP_IMPL(push)
 #define HASHMAP_get HASHMAP_IMPL(get)
 #define HASHMAP_remove HASHMAP_IMPL(remove)
+#ifdef HASHMAP_KEY_T
+// Keys of HASHMAP_KEY_T go straight to push, get and remove
+#define HASHMAP_insert HASHMAP_push
+#define HASHMAP_lookup HASHMAP_get
+#define HASHMAP_erase HASHMAP_remove
+#else
+#define HASHMAP_push_n HASHMAP_IMPL(push_n)
+#define HASHMAP_get_n HASHMAP_IMPL(get_n)
+#define HASHMAP_remove_n HASHMAP_IMPL(remove_n)
+#define HASHMAP_push_kstr HASHMAP_IMPL(push_kstr)
+#define HASHMAP_get_kstr HASHMAP_IMPL(get_kstr)
+#define HASHMAP_remove_kstr HASHMAP_IMPL(remove_kstr)
+#define HASHMAP_insert HASHMAP_push_n
+#define HASHMAP_lookup HASHMAP_get_n
+#define HASHMAP_erase HASHMAP_remove_n
+#endif // HASHMAP_KEY_T
 
 #ifdef HASHMAP_DECLS_ONLY
 
-#ifndef HASHMAP_HASH
-static
-uint64_t
-HASHMAP_fnv_1a_hash_str(const char* s, size_t len);
-
-static
-uint64_t
-HASHMAP_murmur2_hash_str(const char* s, size_t len);
-#endif // HASHMAP_HASH
-
 HASHMAP_LINKAGE
 HASHMAP_NAME*
 HASHMAP_new(Koliseo* kls, size_t bucket_count);
 
+HASHMAP_LINKAGE
+HASHMAP_NAME*
+HASHMAP_new_t(Koliseo_Temp* t_kls, size_t bucket_count);
+
+HASHMAP_LINKAGE
+bool
+HASHMAP_insert(HASHMAP_NAME* map, HASHMAP_KEY_PARAMS, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+HASHMAP_T*
+HASHMAP_lookup(HASHMAP_NAME* map, HASHMAP_KEY_PARAMS);
+
+HASHMAP_LINKAGE
+bool
+HASHMAP_erase(HASHMAP_NAME *map, HASHMAP_KEY_PARAMS);
+
+#ifndef HASHMAP_KEY_T
 HASHMAP_LINKAGE
 bool
 HASHMAP_push(HASHMAP_NAME* map, const char* key, HASHMAP_T* value);
@@ -137,72 +232,112 @@ HASHMAP_get(HASHMAP_NAME* map, const char* key);
 HASHMAP_LINKAGE
 bool
 HASHMAP_remove(HASHMAP_NAME *map, const char *key);
+
+#ifdef KLS_GULP_H_
+HASHMAP_LINKAGE
+bool
+HASHMAP_push_kstr(HASHMAP_NAME* map, Kstr key, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+HASHMAP_T*
+HASHMAP_get_kstr(HASHMAP_NAME* map, Kstr key);
+
+HASHMAP_LINKAGE
+bool
+HASHMAP_remove_kstr(HASHMAP_NAME *map, Kstr key);
+#endif // KLS_GULP_H_
+#endif // HASHMAP_KEY_T
 #else
 
-#ifndef HASHMAP_HASH
-/* FNV-1a hash */
-static uint64_t HASHMAP_fnv_1a_hash_str(const char *s, size_t len)
+// Pushes a table of bucket_count buckets, on the Koliseo_Temp of the map if it has one.
+// Buckets stay NULL until a key lands in them.
+static inline DARRAY_NAME** HASHMAP_alloc_table(HASHMAP_NAME* map, size_t bucket_count)
 {
-    const uint8_t *p = (const uint8_t *)s;
-    uint64_t h = 14695981039346656037ULL;
-    for (size_t i = 0; i < len; i++) {
-        h ^= (uint64_t)p[i];
-        h *= 1099511628211ULL;
+    if (map->t_kls) {
+        return KLS_PUSH_ARR_T(map->t_kls, DARRAY_NAME*, bucket_count);
     }
-    return h;
+    return KLS_PUSH_ARR(map->kls, DARRAY_NAME*, bucket_count);
 }
 
-/* Murmur2 hash */
-static uint64_t HASHMAP_murmur2_hash_str(const void *key, size_t len)
+// Appends item to the bucket at index of the current table, starting the bucket if needed.
+static inline void HASHMAP_bucket_push(HASHMAP_NAME* map, size_t index, HASHMAP_NODE_NAME item)
 {
-    const uint64_t m = 0xc6a4a7935bd1e995ULL;
-    const int r = 47;
-
-    uint64_t h = len * m;
+    DARRAY_NAME* node = map->buckets[index];
+    if (map->t_kls) {
+        if (!node) node = map->buckets[index] = HASHMAP_DA_IMPL(init_t)(map->t_kls);
+        HASHMAP_DA_IMPL(push_t)(node, item);
+    } else {
+        if (!node) node = map->buckets[index] = HASHMAP_DA_IMPL(init)(map->kls);
+        HASHMAP_DA_IMPL(push)(node, item);
+    }
+}
 
-    const uint8_t *p = key;
-    const uint8_t *end = p + (len & ~7ULL);
+// Moves up to steps old buckets to the current table, dropping the old table once empty.
+static inline void HASHMAP_rehash_step(HASHMAP_NAME* map, size_t steps)
+{
+    while (map->old_buckets && steps-- > 0) {
+        DARRAY_NAME* old = map->old_buckets[map->rehash_pos];
+        for (size_t i = 0; old && i < old->count; i++) {
+            HASHMAP_bucket_push(map, old->items[i].hash % map->bucket_count, old->items[i]);
+        }
+        map->rehash_pos += 1;
+        if (map->rehash_pos == map->old_bucket_count) {
+            // The old table stays on the arena until it is freed, or the Koliseo_Temp ends
+            map->old_buckets = NULL;
+            map->old_bucket_count = 0;
+            map->rehash_pos = 0;
+        }
+    }
+}
 
-    while (p < end) {
-        uint64_t k;
-        memcpy(&k, p, 8);
-        p += 8;
+static inline uint64_t HASHMAP_hash_key(HASHMAP_KEY_PARAMS)
+{
+#ifdef HASHMAP_KEY_T
+    return HASHMAP_KEY_HASH(key);
+#else
+    return HASHMAP_hash_str(key, len);
+#endif // HASHMAP_KEY_T
+}
 
-        k *= m;
-        k ^= k >> r;
-        k *= m;
+// Stored hashes, and lengths for string keys, are compared before the keys.
+static inline bool HASHMAP_key_eq(const HASHMAP_NODE_NAME* it, uint64_t h, HASHMAP_KEY_PARAMS)
+{
+#ifdef HASHMAP_KEY_T
+    return it->hash == h && HASHMAP_KEY_EQ(it->key, key);
+#else
+    return it->hash == h && it->key_len == len && memcmp(it->key, key, len) == 0;
+#endif // HASHMAP_KEY_T
+}
 
-        h ^= k;
-        h *= m;
+// Returns the bucket holding key and sets *idx to its position, or returns NULL if key is missing.
+#ifdef HASHMAP_KEY_T
+#define HASHMAP_KEY_ARGS key
+#else
+#define HASHMAP_KEY_ARGS key, len
+#endif // HASHMAP_KEY_T
+static inline DARRAY_NAME* HASHMAP_find(HASHMAP_NAME* map, uint64_t h, int* idx, HASHMAP_KEY_PARAMS)
+{
+    DARRAY_NAME* node = map->buckets[h % map->bucket_count];
+    for (int i = 0; node && i < node->count; i++) {
+        if (HASHMAP_key_eq(&node->items[i], h, HASHMAP_KEY_ARGS)) {
+            *idx = i;
+            return node;
+        }
     }
-
-    uint64_t tail = 0;
-    switch (len & 7) {
-    case 7:
-        tail ^= (uint64_t)p[6] << 48;
-    case 6:
-        tail ^= (uint64_t)p[5] << 40;
-    case 5:
-        tail ^= (uint64_t)p[4] << 32;
-    case 4:
-        tail ^= (uint64_t)p[3] << 24;
-    case 3:
-        tail ^= (uint64_t)p[2] << 16;
-    case 2:
-        tail ^= (uint64_t)p[1] << 8;
-    case 1:
-        tail ^= (uint64_t)p[0];
-        h ^= tail;
-        h *= m;
+    if (map->old_buckets) {
+        size_t old_index = h % map->old_bucket_count;
+        if (old_index >= map->rehash_pos) {
+            node = map->old_buckets[old_index];
+            for (int i = 0; node && i < node->count; i++) {
+                if (HASHMAP_key_eq(&node->items[i], h, HASHMAP_KEY_ARGS)) {
+                    *idx = i;
+                    return node;
+                }
+            }
+        }
     }
-
-    h ^= h >> r;
-    h *= m;
-    h ^= h >> r;
-
-    return h;
+    return NULL;
 }
-#endif // HASHMAP_HASH
 
 HASHMAP_NAME *HASHMAP_new(Koliseo* kls, size_t bucket_count)
 {
@@ -210,75 +345,133 @@ HASHMAP_NAME *HASHMAP_new(Koliseo* kls, size_t bucket_count)
     if (!map) return NULL;
     map->kls = kls;
 
-    map->bucket_count = bucket_count;
-    map->buckets = KLS_PUSH_ARR(kls, DARRAY_NAME*, bucket_count);
+    map->bucket_count = (bucket_count > 0 ? bucket_count : 1);
+    map->buckets = HASHMAP_alloc_table(map, map->bucket_count);
     if (!map->buckets) {
         return NULL;
     }
-    for (size_t i = 0; i < bucket_count; i++) {
-        map->buckets[i] = HASHMAP_DA_IMPL(init)(kls);
-    }
 
     return map;
 }
 
-bool HASHMAP_push(HASHMAP_NAME *map, const char *key, HASHMAP_T *value)
+HASHMAP_NAME *HASHMAP_new_t(Koliseo_Temp* t_kls, size_t bucket_count)
 {
-    uint64_t h = HASHMAP_hash_str(key, strlen(key));
-    size_t index = h % map->bucket_count;
+    HASHMAP_NAME *map = KLS_PUSH_ARR_T(t_kls, HASHMAP_NAME, 1);
+    if (!map) return NULL;
+    map->kls = t_kls->kls;
+    map->t_kls = t_kls;
+
+    map->bucket_count = (bucket_count > 0 ? bucket_count : 1);
+    map->buckets = HASHMAP_alloc_table(map, map->bucket_count);
+    if (!map->buckets) {
+        return NULL;
+    }
+
+    return map;
+}
 
-    DARRAY_NAME *node = map->buckets[index];
-    for (int i = 0; i < node->count; i++) {
+bool HASHMAP_insert(HASHMAP_NAME *map, HASHMAP_KEY_PARAMS, HASHMAP_T *value)
+{
+    HASHMAP_rehash_step(map, HASHMAP_REHASH_STEP);
+    uint64_t h = HASHMAP_hash_key(HASHMAP_KEY_ARGS);
+    int i = 0;
+    DARRAY_NAME *node = HASHMAP_find(map, h, &i, HASHMAP_KEY_ARGS);
+    if (node) {
         // Collision
-        if (strcmp(node->items[i].key, key) == 0) {
-            node->items[i].value = value; // Replace
-            return false;
-        }
+        node->items[i].value = HASHMAP_VALUE_IN(value); // Replace
+        return false;
     }
-    Koliseo* kls = node->allocator.kls;
-    char* key_dup = KLS_PUSH_STR(kls, key);
-    memcpy(key_dup, key, strlen(key));
+#ifdef HASHMAP_KEY_T
+    HASHMAP_NODE_NAME new = {
+        .key = key,
+        .hash = h,
+        .value = HASHMAP_VALUE_IN(value),
+    };
+#else
+    char* key_dup = (map->t_kls ? KLS_PUSH_ARR_T(map->t_kls, char, len + 1) : KLS_PUSH_ARR(map->kls, char, len + 1));
+    memcpy(key_dup, key, len);
     HASHMAP_NODE_NAME new = {
         .key = key_dup,
-        .value = value,
+        .key_len = len,
+        .hash = h,
+        .value = HASHMAP_VALUE_IN(value),
     };
-    HASHMAP_DA_IMPL(push)(node, new);
-    map->buckets[index] = node;
+#endif // HASHMAP_KEY_T
+    HASHMAP_bucket_push(map, h % map->bucket_count, new);
+    map->count += 1;
+
+    if (!map->old_buckets && map->count * 100 > map->bucket_count * HASHMAP_MAX_LOAD) {
+        DARRAY_NAME** buckets = HASHMAP_alloc_table(map, map->bucket_count * 2);
+        if (buckets) {
+            map->old_buckets = map->buckets;
+            map->old_bucket_count = map->bucket_count;
+            map->rehash_pos = 0;
+            map->buckets = buckets;
+            map->bucket_count *= 2;
+            HASHMAP_rehash_step(map, (HASHMAP_REHASH_STEP > 0 ? HASHMAP_REHASH_STEP : map->old_bucket_count));
+        }
+    }
     return true;
 }
 
-HASHMAP_T *HASHMAP_get(HASHMAP_NAME *map, const char *key)
+HASHMAP_T *HASHMAP_lookup(HASHMAP_NAME *map, HASHMAP_KEY_PARAMS)
 {
-    uint64_t h = HASHMAP_hash_str(key, strlen(key));
-    size_t index = h % map->bucket_count;
+    int i = 0;
+    DARRAY_NAME *node = HASHMAP_find(map, HASHMAP_hash_key(HASHMAP_KEY_ARGS), &i, HASHMAP_KEY_ARGS);
+    return (node ? HASHMAP_VALUE_OUT(node->items[i]) : NULL);
+}
 
-    DARRAY_NAME *node = map->buckets[index];
-    for (int i = 0; i < node->count; i++) {
-        if (strcmp(node->items[i].key, key) == 0) {
-            return node->items[i].value;
-        }
+bool HASHMAP_erase(HASHMAP_NAME *map, HASHMAP_KEY_PARAMS)
+{
+    HASHMAP_rehash_step(map, HASHMAP_REHASH_STEP);
+    int i = 0;
+    DARRAY_NAME *node = HASHMAP_find(map, HASHMAP_hash_key(HASHMAP_KEY_ARGS), &i, HASHMAP_KEY_ARGS);
+    if (!node) {
+        return false;
     }
-    return NULL;
+    for (int j = i; j < node->count -1; j++) {
+        node->items[j] = node->items[j+1];
+    }
+    node->count -= 1;
+    map->count -= 1;
+    return true;
+}
+
+#ifndef HASHMAP_KEY_T
+bool HASHMAP_push(HASHMAP_NAME *map, const char *key, HASHMAP_T *value)
+{
+    return HASHMAP_push_n(map, key, strlen(key), value);
+}
+
+HASHMAP_T *HASHMAP_get(HASHMAP_NAME *map, const char *key)
+{
+    return HASHMAP_get_n(map, key, strlen(key));
 }
 
 bool HASHMAP_remove(HASHMAP_NAME *map, const char *key)
 {
-    uint64_t h = HASHMAP_hash_str(key, strlen(key));
-    size_t index = h % map->bucket_count;
-
-    DARRAY_NAME **prev = &map->buckets[index];
-    DARRAY_NAME *node = *prev;
-    for (int i = 0; i < node->count; i++) {
-        if (strcmp(node->items[i].key, key) == 0) {
-            for (int j = i; j < node->count -1; j++) {
-                (*prev)->items[j] = (*prev)->items[j+1];
-            }
-            (*prev)->count -= 1;
-            return true;
-        }
-    }
-    return false;
+    return HASHMAP_remove_n(map, key, strlen(key));
+}
+
+#ifdef KLS_GULP_H_
+// Kstr keys need no terminator, so tokens can be looked up in place.
+bool HASHMAP_push_kstr(HASHMAP_NAME *map, Kstr key, HASHMAP_T *value)
+{
+    return HASHMAP_push_n(map, key.data, key.len, value);
+}
+
+HASHMAP_T *HASHMAP_get_kstr(HASHMAP_NAME *map, Kstr key)
+{
+    return HASHMAP_get_n(map, key.data, key.len);
+}
+
+bool HASHMAP_remove_kstr(HASHMAP_NAME *map, Kstr key)
+{
+    return HASHMAP_remove_n(map, key.data, key.len);
 }
+#endif // KLS_GULP_H_
+#endif // HASHMAP_KEY_T
+#undef HASHMAP_KEY_ARGS
 #endif // HASHMAP_DECLS_ONLY
 
 // Cleanup
@@ -302,10 +495,45 @@ bool HASHMAP_remove(HASHMAP_NAME *map, const char *key)
 #ifdef HASHMAP_HASH_MURMUR2
 #undef HASHMAP_HASH_MURMUR2
 #endif // HASHMAP_HASH_MURMUR2
+#ifdef HASHMAP_HASH_WYHASH
+#undef HASHMAP_HASH_WYHASH
+#endif // HASHMAP_HASH_WYHASH
+#ifdef HASHMAP_HASH_AES
+#undef HASHMAP_HASH_AES
+#endif // HASHMAP_HASH_AES
+#ifdef HASHMAP_KEY_T
+#undef HASHMAP_KEY_T
+#undef HASHMAP_KEY_HASH
+#undef HASHMAP_KEY_EQ
+#endif // HASHMAP_KEY_T
+#ifdef HASHMAP_BY_VALUE
+#undef HASHMAP_BY_VALUE
+#endif // HASHMAP_BY_VALUE
+#undef HASHMAP_KEY_PARAMS
+#undef HASHMAP_VALUE_IN
+#undef HASHMAP_VALUE_OUT
 #undef HASHMAP_new
+#undef HASHMAP_new_t
+#undef HASHMAP_alloc_table
+#undef HASHMAP_rehash_step
+#undef HASHMAP_bucket_push
+#undef HASHMAP_hash_key
+#undef HASHMAP_key_eq
+#undef HASHMAP_find
+#undef HASHMAP_MAX_LOAD
+#undef HASHMAP_REHASH_STEP
 #undef HASHMAP_push
 #undef HASHMAP_get
 #undef HASHMAP_remove
+#undef HASHMAP_insert
+#undef HASHMAP_lookup
+#undef HASHMAP_erase
+#undef HASHMAP_push_n
+#undef HASHMAP_get_n
+#undef HASHMAP_remove_n
+#undef HASHMAP_push_kstr
+#undef HASHMAP_get_kstr
+#undef HASHMAP_remove_kstr
 #ifdef HASHMAP_DECLS_ONLY
 #undef HASHMAP_DECLS_ONLY
 #endif // HASHMAP_DECLS_ONLY
@@ -0,0 +1,250 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/*********************************************************************************\
+| hashmap_hash.h                                                                  |
+| Hash functions shared by hashmap.h and flatmap.h.                               |
+| Pick one for a map by defining, before including the map template:              |
+|   HASHMAP_HASH_FNV_1A  byte at a time FNV-1a (the default)                      |
+|   HASHMAP_HASH_MURMUR2 8 bytes at a time Murmur2                                |
+|   HASHMAP_HASH_WYHASH  wyhash, 16 to 48 bytes at a time                         |
+|   HASHMAP_HASH_AES     AES-NI rounds over 32 bytes at a time for keys longer    |
+|                        than 16 bytes, wyhash otherwise or without AES-NI        |
+| or define HASHMAP_HASH to a function with the same signature.                   |
+|                                                                                 |
+| HASHMAP_HASH_AES results depend on the running CPU: do not store them.          |
+| Define HASHMAP_NO_AES to never use AES-NI.                                      |
+\*********************************************************************************/
+
+#ifndef HASHMAP_HASH_HEADER_H
+#define HASHMAP_HASH_HEADER_H
+#include <stdint.h> // uint8_t, uint64_t
+#include <string.h> // memcpy
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(HASHMAP_NO_AES)
+#define HASHMAP_HAS_X86_AES
+#include <immintrin.h>
+#endif
+
+/* FNV-1a hash */
+static inline uint64_t HASHMAP_fnv_1a_hash_str(const char *s, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)s;
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint64_t)p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/* Murmur2 hash */
+static inline uint64_t HASHMAP_murmur2_hash_str(const void *key, size_t len)
+{
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+
+    uint64_t h = len * m;
+
+    const uint8_t *p = key;
+    const uint8_t *end = p + (len & ~7ULL);
+
+    while (p < end) {
+        uint64_t k;
+        memcpy(&k, p, 8);
+        p += 8;
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+    }
+
+    uint64_t tail = 0;
+    switch (len & 7) {
+    case 7:
+        tail ^= (uint64_t)p[6] << 48;
+    case 6:
+        tail ^= (uint64_t)p[5] << 40;
+    case 5:
+        tail ^= (uint64_t)p[4] << 32;
+    case 4:
+        tail ^= (uint64_t)p[3] << 24;
+    case 3:
+        tail ^= (uint64_t)p[2] << 16;
+    case 2:
+        tail ^= (uint64_t)p[1] << 8;
+    case 1:
+        tail ^= (uint64_t)p[0];
+        h ^= tail;
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+
+    return h;
+}
+
+/* splitmix64 finalizer, for integer keys */
+static inline uint64_t hashmap_hash_u64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Multiplies a and b, leaving the low half of the product in a and the high half in b.
+static inline void hashmap__mum(uint64_t* a, uint64_t* b)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 hashmap__u128;
+    hashmap__u128 r = (hashmap__u128) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif // __SIZEOF_INT128__
+}
+
+static inline uint64_t hashmap__mix(uint64_t a, uint64_t b)
+{
+    hashmap__mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t hashmap__r8(const uint8_t* p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t hashmap__r4(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static const uint64_t hashmap__wyp[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL,
+};
+
+/* wyhash, after the public domain final4 version by Wang Yi, with seed 0 */
+static inline uint64_t HASHMAP_wyhash_str(const char *s, size_t len)
+{
+    const uint8_t* p = (const uint8_t*) s;
+    const uint64_t* secret = hashmap__wyp;
+    uint64_t seed = hashmap__mix(secret[0], secret[1]);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (hashmap__r4(p) << 32) | hashmap__r4(p + ((len >> 3) << 2));
+            b = (hashmap__r4(p + len - 4) << 32) | hashmap__r4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i >= 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = hashmap__mix(hashmap__r8(p) ^ secret[1], hashmap__r8(p + 8) ^ seed);
+                see1 = hashmap__mix(hashmap__r8(p + 16) ^ secret[2], hashmap__r8(p + 24) ^ see1);
+                see2 = hashmap__mix(hashmap__r8(p + 32) ^ secret[3], hashmap__r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = hashmap__mix(hashmap__r8(p) ^ secret[1], hashmap__r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = hashmap__r8(p + i - 16);
+        b = hashmap__r8(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    hashmap__mum(&a, &b);
+    return hashmap__mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+#ifdef HASHMAP_HAS_X86_AES
+static inline int hashmap__has_aes(void)
+{
+    static int has_aes = -1;
+    if (has_aes < 0) {
+        has_aes = __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse2");
+    }
+    return has_aes;
+}
+
+// Two lanes take one AES round per 16 bytes, with the data as round key. Needs len > 16.
+__attribute__((target("aes,sse2")))
+static inline uint64_t hashmap__aes_hash_long(const uint8_t* p, size_t len)
+{
+    const __m128i k0 = _mm_set_epi64x((long long) hashmap__wyp[0], (long long) hashmap__wyp[1]);
+    const __m128i k1 = _mm_set_epi64x((long long) hashmap__wyp[2], (long long) (hashmap__wyp[3] ^ len));
+    __m128i acc0 = k0;
+    __m128i acc1 = k1;
+    const uint8_t* start = p;
+    const uint8_t* end = p + len;
+    while (end - p > 32) {
+        acc0 = _mm_aesenc_si128(acc0, _mm_loadu_si128((const __m128i*) p));
+        acc1 = _mm_aesenc_si128(acc1, _mm_loadu_si128((const __m128i*) (p + 16)));
+        p += 32;
+    }
+    // The last 32 bytes, or the first and last 16 for shorter keys, overlapping what was read
+    acc0 = _mm_aesenc_si128(acc0, _mm_loadu_si128((const __m128i*) (end - 16)));
+    acc1 = _mm_aesenc_si128(acc1, _mm_loadu_si128((const __m128i*) (len > 32 ? end - 32 : start)));
+    __m128i h = _mm_aesenc_si128(acc0, acc1);
+    h = _mm_aesenc_si128(h, k1);
+    h = _mm_aesenc_si128(h, k0);
+    return (uint64_t) _mm_cvtsi128_si64(h) ^ (uint64_t) _mm_cvtsi128_si64(_mm_unpackhi_epi64(h, h));
+}
+#endif // HASHMAP_HAS_X86_AES
+
+/* AES-NI hash for keys longer than 16 bytes, wyhash otherwise */
+static inline uint64_t HASHMAP_aes_hash_str(const char *s, size_t len)
+{
+#ifdef HASHMAP_HAS_X86_AES
+    if (len > 16 && hashmap__has_aes()) {
+        return hashmap__aes_hash_long((const uint8_t*) s, len);
+    }
+#endif // HASHMAP_HAS_X86_AES
+    return HASHMAP_wyhash_str(s, len);
+}
+
+#endif // HASHMAP_HASH_HEADER_H
@@ -30,9 +30,18 @@
 //
 // Functions ending with _gl use malloc() for the nodes.
 // Functions ending with _kls expect a Koliseo arg to use for allocating nodes.
+// They push all the new nodes of a call in a single run.
+// If you define LIST_HASH_DEFAULT_FN, taking a const LIST_T* and returning an
+// uint64_t consistent with LIST_CMP_DEFAULT_FN, intersect and diff using the
+// default comparator build temporary hash sets instead of doing member() walks.
+// Their _p variants always hash the pointers.
 //
 // CHANGELOG
 //
+// 0.2.0 - All functions are iterative, and work on lists of any length
+//         _kls functions push their nodes in a single run
+//         Hash assisted intersect and diff, LIST_HASH_DEFAULT_FN
+//         intersect keeps the items of l1 found in l2, dropping repeated ones like diff
 // 0.1.2 - LIST_CMP_DEFAULT_FN customization
 //         LIST_CMP_FN, typedef bool(LIST_cmp)(LIST_T*, LIST_T*)
 //         New API with _fn suffix taking a comparator, LIST_CMP_DEFAULT_FN
@@ -46,12 +55,23 @@
 // needed for all instantiations can go up here.
 #include <stdbool.h> // bool
 #include <stdlib.h> // malloc, size_t
+#include <stdint.h> // uint64_t, uintptr_t
+#include <string.h> // memset
 
 #define LIST_IMPL(word) LIST_COMB1(LIST_PREFIX,word)
 #define LIST_COMB1(pre, word) LIST_COMB2(pre, word)
 #define LIST_COMB2(pre, word) pre##word
 
-#define LIST_HEADER_VERSION "0.1.2"
+#define LIST_HEADER_VERSION "0.2.0"
+
+static inline uint64_t list__mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
 
 #endif // LIST_HEADER_H
 
@@ -137,6 +157,14 @@ typedef LIST_ITEM_NAME* LIST_NAME;
 #define LIST_diff_kls_fn LIST_IMPL(diff_kls_fn)
 #define LIST_diff_kls LIST_IMPL(diff_kls)
 #define LIST_diff_p_kls LIST_IMPL(diff_p_kls)
+#define LIST_copy_prefix LIST_IMPL(copy_prefix_)
+#define LIST_from_values LIST_IMPL(from_values_)
+#define LIST_set_insert LIST_IMPL(set_insert_)
+#define LIST_filter LIST_IMPL(filter_)
+
+#ifndef LIST_CMP_DEFAULT_FN
+#define LIST_CMP_DEFAULT_FN &LIST_dumb_cmp
+#endif // LIST_CMP_DEFAULT_FN
 
 #ifdef LIST_DECLS_ONLY
 
@@ -175,10 +203,6 @@ LIST_LINKAGE
 bool
 LIST_dumb_cmp(const LIST_T* a, const LIST_T* b);
 
-#ifndef LIST_CMP_DEFAULT_FN
-#define LIST_CMP_DEFAULT_FN &LIST_dumb_cmp
-#endif // LIST_CMP_DEFAULT_FN
-
 LIST_LINKAGE
 bool
 LIST_member_fn(LIST_T* element, LIST_NAME list, LIST_cmp* comparator );
@@ -366,12 +390,11 @@ LIST_LINKAGE
 void
 LIST_free_gl(LIST_NAME list)
 {
-    if (LIST_isEmpty(list)) {
-        return;
-    } else {
-        LIST_free_gl(LIST_tail(list));
+    while (!LIST_isEmpty(list)) {
+        LIST_NAME next = LIST_tail(list);
         free(list->value);
         free(list);
+        list = next;
     }
     return;
 }
@@ -389,29 +412,25 @@ LIST_dumb_cmp(const LIST_T* a, const LIST_T* b)
     return a == b;
 }
 
+// True when intersect and diff can use a hash set in place of comparator.
+#ifdef LIST_HASH_DEFAULT_FN
+#define LIST_hashes_cmp(comparator) ((comparator) == NULL || (comparator) == (LIST_CMP_DEFAULT_FN))
+#else
+#define LIST_hashes_cmp(comparator) false
+#endif // LIST_HASH_DEFAULT_FN
+
 LIST_LINKAGE
 bool
 LIST_member_fn(LIST_T* element, LIST_NAME list, LIST_cmp* comparator)
 {
-    if (LIST_isEmpty(list)) {
-        return false;
-    } else {
-        if (comparator) {
-            if (comparator(element, LIST_head(list))) {
-                return true;
-            } else {
-                return LIST_member_fn(element, LIST_tail(list), comparator);
-            }
-        } else {
-            // Fallback to default comparator
-            LIST_cmp* cmp = LIST_CMP_DEFAULT_FN;
-            if (cmp(element, LIST_head(list))) {
-                return true;
-            } else {
-                return LIST_member_fn(element, LIST_tail(list), cmp);
-            }
+    // Fallback to default comparator
+    LIST_cmp* cmp = (comparator ? comparator : LIST_CMP_DEFAULT_FN);
+    for (LIST_NAME p = list; !LIST_isEmpty(p); p = p->next) {
+        if (cmp(element, p->value)) {
+            return true;
         }
     }
+    return false;
 }
 
 LIST_LINKAGE
@@ -425,37 +444,183 @@ LIST_LINKAGE
 bool
 LIST_member_p(LIST_T* element, LIST_NAME list)
 {
-    if (LIST_isEmpty(list)) {
-        return false;
-    } else {
-        if (element == LIST_head(list)) {
+    for (LIST_NAME p = list; !LIST_isEmpty(p); p = p->next) {
+        if (element == p->value) {
             return true;
-        } else {
-            return LIST_member_p(element, LIST_tail(list));
         }
     }
+    return false;
 }
 
 LIST_LINKAGE
 int
 LIST_length(LIST_NAME list)
 {
-    if (LIST_isEmpty(list)) {
-        return 0;
+    int res = 0;
+    for (LIST_NAME p = list; !LIST_isEmpty(p); p = p->next) {
+        res++;
+    }
+    return res;
+}
+
+// Returns new nodes holding the first n values of list, in order or reversed, followed by tail.
+// Nodes are pushed on kls in a single run, or come from malloc() when kls is NULL.
+static inline LIST_NAME LIST_copy_prefix(Koliseo* kls, LIST_NAME list, size_t n, LIST_NAME tail, bool reversed)
+{
+    if (n == 0) {
+        return tail;
+    }
+    if (kls == NULL) {
+        LIST_NAME res = tail;
+        LIST_NAME* link = &res;
+        for (size_t i = 0; i < n; i++, list = list->next) {
+            if (reversed) {
+                res = LIST_cons_gl(list->value, res);
+            } else {
+                *link = LIST_cons_gl(list->value, tail);
+                link = &(*link)->next;
+            }
+        }
+        return res;
+    }
+    LIST_NAME nodes = KLS_PUSH_ARR_NAMED(kls, LIST_ITEM_NAME, n, "List nodes", "List node run");
+    if (nodes == NULL) {
+        fprintf(stderr, "%s at %i: %s(): Failed KLS_PUSH_ARR_NAMED() call.\n", __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++, list = list->next) {
+        size_t at = (reversed ? n - 1 - i : i);
+        nodes[at].value = list->value;
+        nodes[at].next = (at + 1 < n ? &nodes[at + 1] : tail);
+    }
+    return nodes;
+}
+
+// Returns a new list of the n values, pushed on kls in a single run, or from malloc() when kls is NULL.
+static inline LIST_NAME LIST_from_values(Koliseo* kls, LIST_T** vals, size_t n)
+{
+    if (n == 0) {
+        return LIST_nullList();
+    }
+    if (kls == NULL) {
+        LIST_NAME res = LIST_nullList();
+        for (size_t i = n; i > 0; i--) {
+            res = LIST_cons_gl(vals[i - 1], res);
+        }
+        return res;
+    }
+    LIST_NAME nodes = KLS_PUSH_ARR_NAMED(kls, LIST_ITEM_NAME, n, "List nodes", "List node run");
+    if (nodes == NULL) {
+        fprintf(stderr, "%s at %i: %s(): Failed KLS_PUSH_ARR_NAMED() call.\n", __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        nodes[i].value = vals[i];
+        nodes[i].next = (i + 1 < n ? &nodes[i + 1] : NULL);
+    }
+    return nodes;
+}
+
+// Looks up v in the open addressing set at slots, adding it when add is true.
+// Returns true if v was already in the set.
+static inline bool LIST_set_insert(LIST_T** slots, size_t mask, LIST_T* v, bool by_ptr, bool add)
+{
+#ifdef LIST_HASH_DEFAULT_FN
+    uint64_t key_hash = (by_ptr ? (uint64_t) (uintptr_t) v : (uint64_t) LIST_HASH_DEFAULT_FN(v));
+#else
+    uint64_t key_hash = (uint64_t) (uintptr_t) v;
+#endif // LIST_HASH_DEFAULT_FN
+    LIST_cmp* cmp = LIST_CMP_DEFAULT_FN;
+    for (size_t i = list__mix(key_hash) & mask; ; i = (i + 1) & mask) {
+        if (slots[i] == NULL) {
+            if (add) {
+                slots[i] = v;
+            }
+            return false;
+        }
+        if (slots[i] == v || (!by_ptr && cmp(slots[i], v))) {
+            return true;
+        }
+    }
+}
+
+// Returns a new list with the items of l1 that are in l2 (or are not, if keep_members is false).
+// Of repeated items, only the last one is kept.
+// When hashed is true, uses temporary sets of l1 and l2 items instead of member() walks,
+// comparing pointers if by_ptr is true or LIST_CMP_DEFAULT_FN otherwise.
+// Scratch memory comes from KLS_DEFAULT_ALLOCF, nodes are made by LIST_from_values().
+static inline LIST_NAME LIST_filter(Koliseo* kls, LIST_NAME l1, LIST_NAME l2, bool keep_members, LIST_cmp* comparator, bool by_ptr, bool hashed)
+{
+    size_t n1 = (size_t) LIST_length(l1);
+    size_t cap1 = 0;
+    size_t cap2 = 0;
+    if (hashed) {
+        size_t n2 = (size_t) LIST_length(l2);
+        for (cap1 = 16; cap1 < 2 * n1; cap1 <<= 1);
+        for (cap2 = 16; cap2 < 2 * n2; cap2 <<= 1);
+    }
+    LIST_T** vals = KLS_DEFAULT_ALLOCF((n1 + cap1 + cap2) * sizeof(LIST_T*));
+    if (vals == NULL) {
+        fprintf(stderr, "%s at %i: %s(): Failed allocating scratch buffer.\n", __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+    size_t kept = 0;
+    if (hashed) {
+        LIST_T** seen = vals + n1;
+        LIST_T** others = seen + cap1;
+        memset(seen, 0, (cap1 + cap2) * sizeof(LIST_T*));
+        bool null_seen = false;
+        bool null_in_l2 = false;
+        for (LIST_NAME p = l2; p != NULL; p = p->next) {
+            if (p->value == NULL) {
+                null_in_l2 = true;
+            } else {
+                LIST_set_insert(others, cap2 - 1, p->value, by_ptr, true);
+            }
+        }
+        // Walking l1 from its end, the first of repeated items met is the one to keep
+        size_t i = n1;
+        for (LIST_NAME p = l1; p != NULL; p = p->next) {
+            vals[--i] = p->value;
+        }
+        for (i = 0; i < n1; i++) {
+            LIST_T* v = vals[i];
+            bool repeated = false;
+            bool member = false;
+            if (v == NULL) {
+                repeated = null_seen;
+                null_seen = true;
+                member = null_in_l2;
+            } else {
+                repeated = LIST_set_insert(seen, cap1 - 1, v, by_ptr, true);
+                member = LIST_set_insert(others, cap2 - 1, v, by_ptr, false);
+            }
+            if (!repeated && member == keep_members) {
+                vals[kept++] = v;
+            }
+        }
+        for (size_t a = 0, b = kept; a + 1 < b; a++, b--) {
+            LIST_T* tmp = vals[a];
+            vals[a] = vals[b - 1];
+            vals[b - 1] = tmp;
+        }
     } else {
-        return 1 + LIST_length(LIST_tail(list));
+        for (LIST_NAME p = l1; p != NULL; p = p->next) {
+            if (LIST_member_fn(p->value, l2, comparator) == keep_members && !LIST_member_fn(p->value, p->next, comparator)) {
+                vals[kept++] = p->value;
+            }
+        }
     }
+    LIST_NAME res = LIST_from_values(kls, vals, kept);
+    KLS_DEFAULT_FREEF(vals);
+    return res;
 }
 
 LIST_LINKAGE
 LIST_NAME
 LIST_append_gl(LIST_NAME l1, LIST_NAME l2)
 {
-    if (LIST_isEmpty(l1)) {
-        return l2;
-    } else {
-        return LIST_cons_gl(LIST_head(l1), LIST_append_gl(LIST_tail(l1), l2));
-    }
+    return LIST_copy_prefix(NULL, l1, (size_t) LIST_length(l1), l2, false);
 }
 
 LIST_LINKAGE
@@ -466,22 +631,14 @@ LIST_append_kls(Koliseo* kls, LIST_NAME l1, LIST_NAME l2)
         fprintf(stderr, "%s at %i: %s(): Koliseo is NULL.\n", __FILE__, __LINE__, __func__);
         return NULL;
     }
-    if (LIST_isEmpty(l1)) {
-        return l2;
-    } else {
-        return LIST_cons_kls(kls, LIST_head(l1), LIST_append_kls(kls, LIST_tail(l1), l2));
-    }
+    return LIST_copy_prefix(kls, l1, (size_t) LIST_length(l1), l2, false);
 }
 
 LIST_LINKAGE
 LIST_NAME
 LIST_reverse_gl(LIST_NAME list)
 {
-    if (LIST_isEmpty(list)) {
-        return LIST_nullList();
-    } else {
-        return LIST_append_gl(LIST_reverse_gl(LIST_tail(list)), LIST_cons_gl(LIST_head(list), LIST_nullList()));
-    }
+    return LIST_copy_prefix(NULL, list, (size_t) LIST_length(list), LIST_nullList(), true);
 }
 
 LIST_LINKAGE
@@ -492,22 +649,14 @@ LIST_reverse_kls(Koliseo* kls, LIST_NAME list)
         fprintf(stderr, "%s at %i: %s(): Koliseo is NULL.\n", __FILE__, __LINE__, __func__);
         return NULL;
     }
-    if (LIST_isEmpty(list)) {
-        return LIST_nullList();
-    } else {
-        return LIST_append_kls(kls, LIST_reverse_kls(kls, LIST_tail(list)), LIST_cons_kls(kls, LIST_head(list), LIST_nullList()));
-    }
+    return LIST_copy_prefix(kls, list, (size_t) LIST_length(list), LIST_nullList(), true);
 }
 
 LIST_LINKAGE
 LIST_NAME
 LIST_copy_gl(LIST_NAME list)
 {
-    if (LIST_isEmpty(list)) {
-        return list;
-    } else {
-        return LIST_cons_gl(LIST_head(list), LIST_copy_gl(LIST_tail(list)));
-    }
+    return LIST_copy_prefix(NULL, list, (size_t) LIST_length(list), LIST_nullList(), false);
 }
 
 LIST_LINKAGE
@@ -518,37 +667,22 @@ LIST_copy_kls(Koliseo* kls, LIST_NAME list)
         fprintf(stderr, "%s at %i: %s(): Koliseo is NULL.\n", __FILE__, __LINE__, __func__);
         return NULL;
     }
-    if (LIST_isEmpty(list)) {
-        return list;
-    } else {
-        return LIST_cons_kls(kls, LIST_head(list), LIST_copy_kls(kls, LIST_tail(list)));
-    }
-
+    return LIST_copy_prefix(kls, list, (size_t) LIST_length(list), LIST_nullList(), false);
 }
 
 LIST_LINKAGE
 LIST_NAME
 LIST_remove_gl_fn(LIST_T* element, LIST_NAME list, LIST_cmp* comparator)
 {
-    if (LIST_isEmpty(list)) {
-        return LIST_nullList();
-    } else {
-        if (comparator) {
-            if (comparator(element, LIST_head(list))) {
-                return LIST_tail(list);
-            } else {
-                return LIST_cons_gl(LIST_head(list), LIST_remove_gl_fn(element, LIST_tail(list), comparator));
-            }
-        } else {
-            // Fallback to default comparator
-            LIST_cmp* cmp = LIST_CMP_DEFAULT_FN;
-            if (cmp(element, LIST_head(list))) {
-                return LIST_tail(list);
-            } else {
-                return LIST_cons_gl(LIST_head(list), LIST_remove_gl_fn(element, LIST_tail(list), cmp));
-            }
-        }
+    // Fallback to default comparator
+    LIST_cmp* cmp = (comparator ? comparator : LIST_CMP_DEFAULT_FN);
+    size_t n = 0;
+    LIST_NAME p = list;
+    for (; !LIST_isEmpty(p) && !cmp(element, p->value); p = p->next) {
+        n++;
     }
+    // Items before the first match are copied, the ones after it are shared
+    return LIST_copy_prefix(NULL, list, n, (p ? p->next : LIST_nullList()), false);
 }
 
 LIST_LINKAGE
@@ -562,15 +696,12 @@ LIST_LINKAGE
 LIST_NAME
 LIST_remove_p_gl(LIST_T* element, LIST_NAME list)
 {
-    if (LIST_isEmpty(list)) {
-        return LIST_nullList();
-    } else {
-        if (element == LIST_head(list)) {
-            return LIST_tail(list);
-        } else {
-            return LIST_cons_gl(LIST_head(list), LIST_remove_p_gl(element, LIST_tail(list)));
-        }
+    size_t n = 0;
+    LIST_NAME p = list;
+    for (; !LIST_isEmpty(p) && element != p->value; p = p->next) {
+        n++;
     }
+    return LIST_copy_prefix(NULL, list, n, (p ? p->next : LIST_nullList()), false);
 }
 
 LIST_LINKAGE
@@ -581,25 +712,15 @@ LIST_remove_kls_fn(Koliseo* kls, LIST_T* element, LIST_NAME list, LIST_cmp* comp
         fprintf(stderr, "%s at %i: %s(): Koliseo is NULL.\n", __FILE__, __LINE__, __func__);
         return NULL;
     }
-    if (LIST_isEmpty(list)) {
-        return LIST_nullList();
-    } else {
-        if (comparator) {
-            if (comparator(element, LIST_head(list))) {
-                return LIST_tail(list);
-            } else {
-                return LIST_cons_kls(kls, LIST_head(list), LIST_remove_kls_fn(kls, element, LIST_tail(list), comparator));
-            }
-        } else {
-            // Fallback to default comparator
-            LIST_cmp* cmp = LIST_CMP_DEFAULT_FN;
-            if (cmp(element, LIST_head(list))) {
-                return LIST_tail(list);
-            } else {
-                return LIST_cons_kls(kls, LIST_head(list), LIST_remove_kls_fn(kls, element, LIST_tail(list), cmp));
-            }
-        }
+    // Fallback to default comparator
+    LIST_cmp* cmp = (comparator ? comparator : LIST_CMP_DEFAULT_FN);
+    size_t n = 0;
+    LIST_NAME p = list;
+    for (; !LIST_isEmpty(p) && !cmp(element, p->value); p = p->next) {
+        n++;
     }
+    // Items before the first match are copied, the ones after it are shared
+    return LIST_copy_prefix(kls, list, n, (p ? p->next : LIST_nullList()), false);
 }
 
 LIST_LINKAGE
@@ -617,15 +738,12 @@ LIST_remove_p_kls(Koliseo* kls, LIST_T* element, LIST_NAME list)
         fprintf(stderr, "%s at %i: %s(): Koliseo is NULL.\n", __FILE__, __LINE__, __func__);
         return NULL;
     }
-    if (LIST_isEmpty(list)) {
-        return LIST_nullList();
-    } else {
-        if (element == LIST_head(list)) {
-            return LIST_tail(list);
-        } else {
-            return LIST_cons_kls(kls, LIST_head(list), LIST_remove_p_kls(kls, element, LIST_tail(list)));
-        }
+    size_t n = 0;
+    LIST_NAME p = list;
+    for (; !LIST_isEmpty(p) && element != p->value; p = p->next) {
+        n++;
     }
+    return LIST_copy_prefix(kls, list, n, (p ? p->next : LIST_nullList()), false);
 }
 
 LIST_LINKAGE
@@ -635,11 +753,7 @@ LIST_intersect_gl_fn(LIST_NAME l1, LIST_NAME l2, LIST_cmp* comparator)
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return LIST_nullList();
     }
-    if (LIST_member_fn(LIST_head(l1), l2, comparator) && !(LIST_member_fn(LIST_head(l1), LIST_tail(l2), comparator))) {
-        return LIST_cons_gl(LIST_head(l1), LIST_intersect_gl_fn(LIST_tail(l1), l2, comparator));
-    } else {
-        return LIST_intersect_gl_fn(LIST_tail(l1), l2, comparator);
-    }
+    return LIST_filter(NULL, l1, l2, true, comparator, false, LIST_hashes_cmp(comparator));
 }
 
 LIST_LINKAGE
@@ -656,11 +770,7 @@ LIST_intersect_p_gl(LIST_NAME l1, LIST_NAME l2)
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return LIST_nullList();
     }
-    if (LIST_member_p(LIST_head(l1), l2) && !(LIST_member_p(LIST_head(l1), LIST_tail(l2)))) {
-        return LIST_cons_gl(LIST_head(l1), LIST_intersect_p_gl(LIST_tail(l1), l2));
-    } else {
-        return LIST_intersect_p_gl(LIST_tail(l1), l2);
-    }
+    return LIST_filter(NULL, l1, l2, true, NULL, true, true);
 }
 
 LIST_LINKAGE
@@ -674,11 +784,7 @@ LIST_intersect_kls_fn(Koliseo* kls, LIST_NAME l1, LIST_NAME l2, LIST_cmp* compar
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return LIST_nullList();
     }
-    if (LIST_member_fn(LIST_head(l1), l2, comparator) && !(LIST_member_fn(LIST_head(l1), LIST_tail(l2), comparator))) {
-        return LIST_cons_kls(kls, LIST_head(l1), LIST_intersect_kls_fn(kls, LIST_tail(l1), l2, comparator));
-    } else {
-        return LIST_intersect_kls_fn(kls, LIST_tail(l1), l2, comparator);
-    }
+    return LIST_filter(kls, l1, l2, true, comparator, false, LIST_hashes_cmp(comparator));
 }
 
 LIST_LINKAGE
@@ -699,11 +805,7 @@ LIST_intersect_p_kls(Koliseo* kls, LIST_NAME l1, LIST_NAME l2)
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return LIST_nullList();
     }
-    if (LIST_member_p(LIST_head(l1), l2) && !(LIST_member_p(LIST_head(l1), LIST_tail(l2)))) {
-        return LIST_cons_kls(kls, LIST_head(l1), LIST_intersect_p_kls(kls, LIST_tail(l1), l2));
-    } else {
-        return LIST_intersect_p_kls(kls, LIST_tail(l1), l2);
-    }
+    return LIST_filter(kls, l1, l2, true, NULL, true, true);
 }
 
 LIST_LINKAGE
@@ -712,13 +814,8 @@ LIST_diff_gl_fn(LIST_NAME l1, LIST_NAME l2, LIST_cmp* comparator)
 {
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return l1;
-    } else {
-        if (!LIST_member_fn(LIST_head(l1), l2, comparator) && !LIST_member_fn(LIST_head(l1), LIST_tail(l1), comparator)) {
-            return LIST_cons_gl(LIST_head(l1), LIST_diff_gl_fn(LIST_tail(l1), l2, comparator));
-        } else {
-            return LIST_diff_gl_fn(LIST_tail(l1), l2, comparator);
-        }
     }
+    return LIST_filter(NULL, l1, l2, false, comparator, false, LIST_hashes_cmp(comparator));
 }
 
 LIST_LINKAGE
@@ -734,13 +831,8 @@ LIST_diff_p_gl(LIST_NAME l1, LIST_NAME l2)
 {
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return l1;
-    } else {
-        if (!LIST_member_p(LIST_head(l1), l2) && !LIST_member_p(LIST_head(l1), LIST_tail(l1))) {
-            return LIST_cons_gl(LIST_head(l1), LIST_diff_p_gl(LIST_tail(l1), l2));
-        } else {
-            return LIST_diff_p_gl(LIST_tail(l1), l2);
-        }
     }
+    return LIST_filter(NULL, l1, l2, false, NULL, true, true);
 }
 
 LIST_LINKAGE
@@ -753,21 +845,15 @@ LIST_diff_kls_fn(Koliseo* kls, LIST_NAME l1, LIST_NAME l2, LIST_cmp* comparator)
     }
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return l1;
-    } else {
-        if (!LIST_member_fn(LIST_head(l1), l2, comparator) && !LIST_member_fn(LIST_head(l1), LIST_tail(l1), comparator)) {
-            return LIST_cons_kls(kls, LIST_head(l1), LIST_diff_kls_fn(kls, LIST_tail(l1), l2, comparator));
-        } else {
-            return LIST_diff_kls_fn(kls, LIST_tail(l1), l2, comparator);
-        }
     }
+    return LIST_filter(kls, l1, l2, false, comparator, false, LIST_hashes_cmp(comparator));
 }
 
 LIST_LINKAGE
 LIST_NAME
 LIST_diff_kls(Koliseo* kls, LIST_NAME l1, LIST_NAME l2)
 {
-    //TODO: add macro to define default comparator
-    return LIST_diff_kls_fn(kls, l1, l2, NULL);
+    return LIST_diff_kls_fn(kls, l1, l2, LIST_CMP_DEFAULT_FN);
 }
 
 LIST_LINKAGE
@@ -780,13 +866,8 @@ LIST_diff_p_kls(Koliseo* kls, LIST_NAME l1, LIST_NAME l2)
     }
     if (LIST_isEmpty(l1) || LIST_isEmpty(l2)) {
         return l1;
-    } else {
-        if (!LIST_member_p(LIST_head(l1), l2) && !LIST_member_p(LIST_head(l1), LIST_tail(l1))) {
-            return LIST_cons_kls(kls, LIST_head(l1), LIST_diff_p_kls(kls, LIST_tail(l1), l2));
-        } else {
-            return LIST_diff_p_kls(kls, LIST_tail(l1), l2);
-        }
     }
+    return LIST_filter(kls, l1, l2, false, NULL, true, true);
 }
 #endif // LIST_DECLS_ONLY
 
@@ -837,6 +918,12 @@ LIST_diff_p_kls(Koliseo* kls, LIST_NAME l1, LIST_NAME l2)
 #undef LIST_diff_kls_fn
 #undef LIST_diff_kls
 #undef LIST_diff_p_kls
+#undef LIST_copy_prefix
+#undef LIST_from_values
+#undef LIST_set_insert
+#undef LIST_filter
+#undef LIST_hashes_cmp
+#undef LIST_HASH_DEFAULT_FN
 #ifdef LIST_DECLS_ONLY
 #undef LIST_DECLS_ONLY
 #endif // LIST_HEADER_H
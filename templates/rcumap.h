@@ -0,0 +1,560 @@
+#ifdef HASHMAP_T //This ensures the library never causes any trouble if this macro was not defined.
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/*********************************************************************************\
+| rcumap.h                                                                        |
+| This code is based on an idea from https://www.davidpriver.com/ctemplates.html. |
+| Include this header multiple times to implement a                               |
+| read-mostly hashmap, safe to query from many threads while                      |
+| another one updates it. Before inclusion define at least                        |
+| HASHMAP_T to the type of values the hashmap can hold.                           |
+| See HASHMAP_NAME, HASHMAP_PREFIX and HASHMAP_LINKAGE for                        |
+| other customization points, and hashmap_hash.h for the hashes.                  |
+|                                                                                 |
+| Lookups read an immutable table version and never lock.                         |
+| Writers are serialized by a mutex: each update copies the                       |
+| current version to a new one, in its own Koliseo, and                           |
+| publishes it. A replaced version is retired with the epoch                      |
+| of its replacement, and its Koliseo is freed once every                         |
+| reader inside a lookup entered at that epoch or later.                          |
+| Readers only write their own cache line, so lookups scale                       |
+| with the number of threads. Updates cost a copy of the table:                   |
+| use push_batch() to apply many at once.                                         |
+|                                                                                 |
+| Needs C11 atomics and pthreads: link with -pthread.                             |
+| The map and its versions live outside of the Koliseo passed                     |
+| to new(), and are freed when it is freed or cleared.                            |
+|                                                                                 |
+| If you define HASHMAP_DECLS_ONLY, only the declarations                          |
+| of the type and its function will be declared.                                  |
+\*********************************************************************************/
+
+#ifndef RCUMAP_HEADER_H
+#define RCUMAP_HEADER_H
+// Inline functions, #defines and includes that will be
+// needed for all instantiations can go up here.
+#include "koliseo.h" // Before the system headers, for _POSIX_C_SOURCE
+#include <stdlib.h> // size_t
+#include <stdio.h> // fprintf, stderr
+#include <stdint.h> // uint64_t
+#include <string.h> // memcmp, memcpy, strlen
+#include <stdatomic.h> // atomic_load, atomic_store, atomic_fetch_add
+#include <pthread.h> // pthread_mutex_t
+
+#define RCUMAP_IMPL(word) RCUMAP_COMB1(HASHMAP_PREFIX,word)
+#define RCUMAP_COMB1(pre, word) RCUMAP_COMB2(pre, word)
+#define RCUMAP_COMB2(pre, word) pre##word
+
+#ifndef RCUMAP_DEFAULT_READERS
+#define RCUMAP_DEFAULT_READERS 64 /**< Number of reader slots when 0 is passed to new().*/
+#endif // RCUMAP_DEFAULT_READERS
+
+#ifndef RCUMAP_VERSION_SLACK
+#define RCUMAP_VERSION_SLACK 256 /**< Extra bytes for the Koliseo of each version, over its header, slots and keys.*/
+#endif // RCUMAP_VERSION_SLACK
+
+/**
+ * Reader slot of a rcumap.h map, on its own cache line.
+ * Holds the epoch its reader entered the current lookup at, or 0 outside of lookups.
+ */
+typedef struct Rcumap_Reader {
+    _Alignas(64) _Atomic uint64_t epoch;
+    _Atomic int taken; /**< Set while a thread owns the slot.*/
+} Rcumap_Reader;
+
+// Returns the smallest power of two slot count holding count entries under 1/2 load.
+static inline size_t rcumap__cap_for(size_t count)
+{
+    size_t cap = 16;
+    while (cap / 2 < count) {
+        cap *= 2;
+    }
+    return cap;
+}
+
+// Returns the lowest epoch a reader is inside a lookup at, or UINT64_MAX.
+static inline uint64_t rcumap__min_epoch(Rcumap_Reader* readers, size_t count)
+{
+    uint64_t min = UINT64_MAX;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t e = atomic_load(&readers[i].epoch);
+        if (e != 0 && e < min) {
+            min = e;
+        }
+    }
+    return min;
+}
+
+#include "hashmap_hash.h" // HASHMAP_fnv_1a_hash_str, HASHMAP_wyhash_str, ...
+
+#endif // RCUMAP_HEADER_H
+
+// NOTE: this section is *not* guarded as it is intended
+// to be included multiple times.
+
+#ifndef HASHMAP_T
+#error "HASHMAP_T must be defined"
+#endif
+
+// The name of the data type to be generated.
+// If not given, will expand to something like
+// `rcumap_int` for an `int`.
+#ifndef HASHMAP_NAME
+#define HASHMAP_NAME RCUMAP_COMB1(RCUMAP_COMB1(rcumap,_), HASHMAP_T)
+#endif
+
+// Prefix for generated functions.
+#ifndef HASHMAP_PREFIX
+#define HASHMAP_PREFIX RCUMAP_COMB1(HASHMAP_NAME, _)
+#endif
+
+// Customize the linkage of the function.
+#ifndef HASHMAP_LINKAGE
+#define HASHMAP_LINKAGE static inline
+#endif
+#include "koliseo.h"
+
+#ifndef HASHMAP_SLOT_NAME
+#define HASHMAP_SLOT_NAME RCUMAP_COMB1(HASHMAP_NAME, _slot)
+#endif
+
+#ifndef HASHMAP_VERSION_NAME
+#define HASHMAP_VERSION_NAME RCUMAP_COMB1(HASHMAP_NAME, _version)
+#endif
+
+typedef struct HASHMAP_SLOT_NAME {
+    uint64_t hash;
+    const char* key; // NULL for an empty slot
+    size_t key_len;
+    HASHMAP_T value;
+} HASHMAP_SLOT_NAME;
+
+// A table version. Never changed once published.
+typedef struct HASHMAP_VERSION_NAME {
+    Koliseo* kls; // Holds this header, the slots and the keys
+    HASHMAP_SLOT_NAME* slots;
+    size_t cap; // Number of slots, a power of two
+    size_t count; // Number of full slots
+    size_t key_bytes; // Bytes taken by the keys, with their terminators
+    uint64_t retire_epoch; // Epoch of the version replacing this one
+    struct HASHMAP_VERSION_NAME* next_retired;
+} HASHMAP_VERSION_NAME;
+
+typedef struct HASHMAP_NAME {
+    _Atomic(HASHMAP_VERSION_NAME*) current;
+    _Atomic uint64_t epoch; // Starts at 1, bumped on each publish
+    _Atomic size_t count;
+    pthread_mutex_t write_lock;
+    HASHMAP_VERSION_NAME* retired; // Replaced versions not yet freed, newest first
+    Rcumap_Reader* readers;
+    size_t max_readers;
+} HASHMAP_NAME;
+
+#if defined(HASHMAP_HASH)
+#define RCUMAP_hash_str HASHMAP_HASH
+#elif defined(HASHMAP_HASH_FNV_1A)
+#define RCUMAP_hash_str HASHMAP_fnv_1a_hash_str
+#elif defined(HASHMAP_HASH_MURMUR2)
+#define RCUMAP_hash_str HASHMAP_murmur2_hash_str
+#elif defined(HASHMAP_HASH_WYHASH)
+#define RCUMAP_hash_str HASHMAP_wyhash_str
+#elif defined(HASHMAP_HASH_AES)
+#define RCUMAP_hash_str HASHMAP_aes_hash_str
+#else
+#define RCUMAP_hash_str HASHMAP_fnv_1a_hash_str
+#endif // HASHMAP_HASH
+#define RCUMAP_new RCUMAP_IMPL(new)
+#define RCUMAP_reader_join RCUMAP_IMPL(reader_join)
+#define RCUMAP_reader_leave RCUMAP_IMPL(reader_leave)
+#define RCUMAP_get RCUMAP_IMPL(get)
+#define RCUMAP_get_n RCUMAP_IMPL(get_n)
+#define RCUMAP_push RCUMAP_IMPL(push)
+#define RCUMAP_push_n RCUMAP_IMPL(push_n)
+#define RCUMAP_push_batch RCUMAP_IMPL(push_batch)
+#define RCUMAP_remove RCUMAP_IMPL(remove)
+#define RCUMAP_reclaim RCUMAP_IMPL(reclaim)
+#define RCUMAP_find RCUMAP_IMPL(find_)
+#define RCUMAP_put RCUMAP_IMPL(put_)
+#define RCUMAP_copy RCUMAP_IMPL(copy_)
+#define RCUMAP_publish RCUMAP_IMPL(publish_)
+#define RCUMAP_reclaim_locked RCUMAP_IMPL(reclaim_locked_)
+#define RCUMAP_destroy RCUMAP_IMPL(destroy_)
+
+#ifdef HASHMAP_DECLS_ONLY
+
+HASHMAP_LINKAGE
+HASHMAP_NAME*
+RCUMAP_new(Koliseo* kls, size_t max_readers);
+
+HASHMAP_LINKAGE
+int
+RCUMAP_reader_join(HASHMAP_NAME* map);
+
+HASHMAP_LINKAGE
+void
+RCUMAP_reader_leave(HASHMAP_NAME* map, int reader);
+
+HASHMAP_LINKAGE
+bool
+RCUMAP_get_n(HASHMAP_NAME* map, int reader, const char* key, size_t len, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+bool
+RCUMAP_get(HASHMAP_NAME* map, int reader, const char* key, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+bool
+RCUMAP_push_n(HASHMAP_NAME* map, const char* key, size_t len, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+bool
+RCUMAP_push(HASHMAP_NAME* map, const char* key, HASHMAP_T* value);
+
+HASHMAP_LINKAGE
+bool
+RCUMAP_push_batch(HASHMAP_NAME* map, const char* const* keys, const HASHMAP_T* values, size_t n);
+
+HASHMAP_LINKAGE
+bool
+RCUMAP_remove(HASHMAP_NAME* map, const char* key);
+
+HASHMAP_LINKAGE
+size_t
+RCUMAP_reclaim(HASHMAP_NAME* map);
+#else
+
+// Returns the index of the slot holding key, or of the empty slot ending its probe sequence.
+static inline size_t RCUMAP_find(const HASHMAP_VERSION_NAME* v, const char* key, size_t len, uint64_t h)
+{
+    size_t mask = v->cap - 1;
+    size_t i = (size_t) h & mask;
+    while (v->slots[i].key != NULL) {
+        const HASHMAP_SLOT_NAME* slot = &v->slots[i];
+        if (slot->hash == h && slot->key_len == len && memcmp(slot->key, key, len) == 0) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Sets key to value in a version not yet published, copying the key to its Koliseo.
+static inline bool RCUMAP_put(HASHMAP_VERSION_NAME* v, const char* key, size_t len, uint64_t h, const HASHMAP_T* value)
+{
+    size_t i = RCUMAP_find(v, key, len, h);
+    HASHMAP_SLOT_NAME* slot = &v->slots[i];
+    if (slot->key == NULL) {
+        char* key_dup = KLS_PUSH_ARR(v->kls, char, len + 1);
+        if (!key_dup) return false;
+        memcpy(key_dup, key, len);
+        slot->hash = h;
+        slot->key = key_dup;
+        slot->key_len = len;
+        v->count += 1;
+        v->key_bytes += len + 1;
+    }
+    slot->value = *value;
+    return true;
+}
+
+// Returns a new version with the entries of old, but skip_key, and room for extra more.
+// extra_key_bytes is the size of the keys that will be added.
+static inline HASHMAP_VERSION_NAME* RCUMAP_copy(const HASHMAP_VERSION_NAME* old, size_t extra, size_t extra_key_bytes, const char* skip_key, size_t skip_len)
+{
+    size_t count = (old ? old->count : 0) + extra;
+    size_t cap = rcumap__cap_for(count);
+    size_t size = sizeof(Koliseo) + sizeof(HASHMAP_VERSION_NAME) + cap * sizeof(HASHMAP_SLOT_NAME)
+                  + (old ? old->key_bytes : 0) + extra_key_bytes + RCUMAP_VERSION_SLACK;
+    KLS_Conf conf = KLS_DEFAULT_CONF;
+    conf.kls_growable = 1;
+    Koliseo* kls = kls_new_conf_alloc_ext(size, conf, KLS_DEFAULT_ALLOCF, KLS_DEFAULT_FREEF, NULL, NULL, 0);
+    if (!kls) return NULL;
+    HASHMAP_VERSION_NAME* v = KLS_PUSH(kls, HASHMAP_VERSION_NAME);
+    HASHMAP_SLOT_NAME* slots = KLS_PUSH_ARR(kls, HASHMAP_SLOT_NAME, cap);
+    if (!v || !slots) {
+        fprintf(stderr, "In %s, at %i: %s(): failed pushing a version of {%zu} slots.\n", __FILE__, __LINE__, __func__, cap);
+        kls_free(kls);
+        return NULL;
+    }
+    v->kls = kls;
+    v->slots = slots;
+    v->cap = cap;
+    if (!old) return v;
+    for (size_t i = 0; i < old->cap; i++) {
+        const HASHMAP_SLOT_NAME* slot = &old->slots[i];
+        if (slot->key == NULL) continue;
+        if (skip_key && slot->key_len == skip_len && memcmp(slot->key, skip_key, skip_len) == 0) continue;
+        if (!RCUMAP_put(v, slot->key, slot->key_len, slot->hash, &slot->value)) {
+            kls_free(kls);
+            return NULL;
+        }
+    }
+    return v;
+}
+
+// Frees the retired versions no reader can still be looking at. Returns how many are left.
+// Needs the write lock.
+static inline size_t RCUMAP_reclaim_locked(HASHMAP_NAME* map)
+{
+    uint64_t min = rcumap__min_epoch(map->readers, map->max_readers);
+    size_t left = 0;
+    HASHMAP_VERSION_NAME** link = &map->retired;
+    while (*link != NULL) {
+        HASHMAP_VERSION_NAME* v = *link;
+        if (v->retire_epoch <= min) {
+            *link = v->next_retired;
+            kls_free(v->kls);
+        } else {
+            link = &v->next_retired;
+            left += 1;
+        }
+    }
+    return left;
+}
+
+// Makes v the current version and retires the one it replaces. Needs the write lock.
+static inline void RCUMAP_publish(HASHMAP_NAME* map, HASHMAP_VERSION_NAME* v)
+{
+    HASHMAP_VERSION_NAME* old = atomic_load_explicit(&map->current, memory_order_relaxed);
+    atomic_store(&map->current, v);
+    atomic_store_explicit(&map->count, v->count, memory_order_relaxed);
+    // Readers entering at the new epoch or later loaded the current version after the store above
+    old->retire_epoch = atomic_fetch_add(&map->epoch, 1) + 1;
+    old->next_retired = map->retired;
+    map->retired = old;
+    RCUMAP_reclaim_locked(map);
+}
+
+// Frees every version of the map, and the map itself. Registered with kls_on_free() by new().
+static inline void RCUMAP_destroy(void* ctx)
+{
+    HASHMAP_NAME* map = ctx;
+    HASHMAP_VERSION_NAME* v = map->retired;
+    while (v != NULL) {
+        HASHMAP_VERSION_NAME* next = v->next_retired;
+        kls_free(v->kls);
+        v = next;
+    }
+    map->retired = NULL;
+    v = atomic_load(&map->current);
+    if (v != NULL) {
+        kls_free(v->kls);
+        atomic_store(&map->current, NULL);
+    }
+    pthread_mutex_destroy(&map->write_lock);
+    KLS_DEFAULT_FREEF(map);
+}
+
+HASHMAP_LINKAGE
+HASHMAP_NAME *RCUMAP_new(Koliseo* kls, size_t max_readers)
+{
+    if (max_readers == 0) {
+        max_readers = RCUMAP_DEFAULT_READERS;
+    }
+    // The map holds the versions and the write lock, so it must outlive any rewind of kls until RCUMAP_destroy() runs
+    Rcumap_Reader* readers = KLS_PUSH_ARR(kls, Rcumap_Reader, max_readers);
+    if (!readers) return NULL;
+    HASHMAP_NAME *map = KLS_DEFAULT_ALLOCF(sizeof(HASHMAP_NAME));
+    if (!map) return NULL;
+    HASHMAP_VERSION_NAME* v = RCUMAP_copy(NULL, 0, 0, NULL, 0);
+    if (!v) {
+        KLS_DEFAULT_FREEF(map);
+        return NULL;
+    }
+    for (size_t i = 0; i < max_readers; i++) {
+        atomic_init(&readers[i].epoch, 0);
+        atomic_init(&readers[i].taken, 0);
+    }
+    atomic_init(&map->current, v);
+    atomic_init(&map->epoch, 1);
+    atomic_init(&map->count, 0);
+    pthread_mutex_init(&map->write_lock, NULL);
+    map->retired = NULL;
+    map->readers = readers;
+    map->max_readers = max_readers;
+    if (!kls_on_free(kls, RCUMAP_destroy, map)) {
+        RCUMAP_destroy(map);
+        return NULL;
+    }
+    return map;
+}
+
+HASHMAP_LINKAGE
+int RCUMAP_reader_join(HASHMAP_NAME* map)
+{
+    // Returns a reader slot for the calling thread, or -1 if they are all taken.
+    for (size_t i = 0; i < map->max_readers; i++) {
+        int free_slot = 0;
+        if (atomic_compare_exchange_strong(&map->readers[i].taken, &free_slot, 1)) {
+            return (int) i;
+        }
+    }
+    fprintf(stderr, "In %s, at %i: %s(): all {%zu} reader slots are taken.\n", __FILE__, __LINE__, __func__, map->max_readers);
+    return -1;
+}
+
+HASHMAP_LINKAGE
+void RCUMAP_reader_leave(HASHMAP_NAME* map, int reader)
+{
+    atomic_store_explicit(&map->readers[reader].taken, 0, memory_order_release);
+}
+
+HASHMAP_LINKAGE
+bool RCUMAP_get_n(HASHMAP_NAME* map, int reader, const char* key, size_t len, HASHMAP_T* value)
+{
+    // Copies the value for key to *value. The reader must have been joined by the calling thread.
+    uint64_t h = RCUMAP_hash_str(key, len);
+    Rcumap_Reader* r = &map->readers[reader];
+    atomic_store(&r->epoch, atomic_load(&map->epoch));
+    const HASHMAP_VERSION_NAME* v = atomic_load(&map->current);
+    size_t i = RCUMAP_find(v, key, len, h);
+    bool found = (v->slots[i].key != NULL);
+    if (found && value) {
+        *value = v->slots[i].value;
+    }
+    atomic_store_explicit(&r->epoch, 0, memory_order_release);
+    return found;
+}
+
+HASHMAP_LINKAGE
+bool RCUMAP_get(HASHMAP_NAME* map, int reader, const char* key, HASHMAP_T* value)
+{
+    return RCUMAP_get_n(map, reader, key, strlen(key), value);
+}
+
+HASHMAP_LINKAGE
+bool RCUMAP_push_batch(HASHMAP_NAME* map, const char* const* keys, const HASHMAP_T* values, size_t n)
+{
+    // Sets keys[i] to values[i] for each i < n, publishing a single new version.
+    size_t key_bytes = 0;
+    for (size_t i = 0; i < n; i++) {
+        key_bytes += strlen(keys[i]) + 1;
+    }
+    pthread_mutex_lock(&map->write_lock);
+    HASHMAP_VERSION_NAME* v = RCUMAP_copy(atomic_load_explicit(&map->current, memory_order_relaxed), n, key_bytes, NULL, 0);
+    bool res = (v != NULL);
+    for (size_t i = 0; res && i < n; i++) {
+        size_t len = strlen(keys[i]);
+        res = RCUMAP_put(v, keys[i], len, RCUMAP_hash_str(keys[i], len), &values[i]);
+    }
+    if (res) {
+        RCUMAP_publish(map, v);
+    } else if (v != NULL) {
+        kls_free(v->kls);
+    }
+    pthread_mutex_unlock(&map->write_lock);
+    return res;
+}
+
+HASHMAP_LINKAGE
+bool RCUMAP_push_n(HASHMAP_NAME* map, const char* key, size_t len, HASHMAP_T* value)
+{
+    pthread_mutex_lock(&map->write_lock);
+    HASHMAP_VERSION_NAME* v = RCUMAP_copy(atomic_load_explicit(&map->current, memory_order_relaxed), 1, len + 1, NULL, 0);
+    bool res = (v != NULL && RCUMAP_put(v, key, len, RCUMAP_hash_str(key, len), value));
+    if (res) {
+        RCUMAP_publish(map, v);
+    } else if (v != NULL) {
+        kls_free(v->kls);
+    }
+    pthread_mutex_unlock(&map->write_lock);
+    return res;
+}
+
+HASHMAP_LINKAGE
+bool RCUMAP_push(HASHMAP_NAME* map, const char* key, HASHMAP_T* value)
+{
+    return RCUMAP_push_n(map, key, strlen(key), value);
+}
+
+HASHMAP_LINKAGE
+bool RCUMAP_remove(HASHMAP_NAME* map, const char* key)
+{
+    size_t len = strlen(key);
+    uint64_t h = RCUMAP_hash_str(key, len);
+    pthread_mutex_lock(&map->write_lock);
+    HASHMAP_VERSION_NAME* old = atomic_load_explicit(&map->current, memory_order_relaxed);
+    bool res = (old->slots[RCUMAP_find(old, key, len, h)].key != NULL);
+    if (res) {
+        HASHMAP_VERSION_NAME* v = RCUMAP_copy(old, 0, 0, key, len);
+        res = (v != NULL);
+        if (res) {
+            RCUMAP_publish(map, v);
+        }
+    }
+    pthread_mutex_unlock(&map->write_lock);
+    return res;
+}
+
+HASHMAP_LINKAGE
+size_t RCUMAP_reclaim(HASHMAP_NAME* map)
+{
+    // Frees the retired versions no reader can still be looking at, as updates already do.
+    // Returns the number of versions still waiting for readers.
+    pthread_mutex_lock(&map->write_lock);
+    size_t left = RCUMAP_reclaim_locked(map);
+    pthread_mutex_unlock(&map->write_lock);
+    return left;
+}
+#endif // HASHMAP_DECLS_ONLY
+
+// Cleanup
+// These need to be undef'ed so they can be redefined the
+// next time you need to instantiate this template.
+#undef HASHMAP_T
+#undef HASHMAP_PREFIX
+#undef HASHMAP_NAME
+#undef HASHMAP_SLOT_NAME
+#undef HASHMAP_VERSION_NAME
+#undef HASHMAP_LINKAGE
+#undef RCUMAP_hash_str
+#ifdef HASHMAP_HASH
+#undef HASHMAP_HASH
+#endif // HASHMAP_HASH
+#ifdef HASHMAP_HASH_FNV_1A
+#undef HASHMAP_HASH_FNV_1A
+#endif // HASHMAP_HASH_FNV_1A
+#ifdef HASHMAP_HASH_MURMUR2
+#undef HASHMAP_HASH_MURMUR2
+#endif // HASHMAP_HASH_MURMUR2
+#ifdef HASHMAP_HASH_WYHASH
+#undef HASHMAP_HASH_WYHASH
+#endif // HASHMAP_HASH_WYHASH
+#ifdef HASHMAP_HASH_AES
+#undef HASHMAP_HASH_AES
+#endif // HASHMAP_HASH_AES
+#undef RCUMAP_new
+#undef RCUMAP_reader_join
+#undef RCUMAP_reader_leave
+#undef RCUMAP_get
+#undef RCUMAP_get_n
+#undef RCUMAP_push
+#undef RCUMAP_push_n
+#undef RCUMAP_push_batch
+#undef RCUMAP_remove
+#undef RCUMAP_reclaim
+#undef RCUMAP_find
+#undef RCUMAP_put
+#undef RCUMAP_copy
+#undef RCUMAP_publish
+#undef RCUMAP_reclaim_locked
+#undef RCUMAP_destroy
+#ifdef HASHMAP_DECLS_ONLY
+#undef HASHMAP_DECLS_ONLY
+#endif // HASHMAP_DECLS_ONLY
+#endif // HASHMAP_T
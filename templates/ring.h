@@ -0,0 +1,472 @@
+#ifdef RING_T //This ensures the library never causes any trouble if this macro was not defined.
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/*********************************************************************************\
+| ring.h                                                                          |
+| This code is based on an idea from https://www.davidpriver.com/ctemplates.html. |
+| Include this header multiple times to implement a                               |
+| ring buffer, usable as a deque. Before inclusion define at least                |
+| RING_T to the type the ring can hold.                                           |
+| See RING_NAME, RING_PREFIX and RING_LINKAGE for                                 |
+| other customization points.                                                     |
+|                                                                                 |
+| Capacity is a power of two, and head and tail are free running                  |
+| counters masked on access. A full ring grows with KLS_REPUSH(),                 |
+| moving the wrapped items after the old end.                                     |
+|                                                                                 |
+| spsc_push_n() and spsc_pop_n() let one producer thread and one                  |
+| consumer thread share a ring without locks. They never grow it,                 |
+| and must not be mixed with the other functions while both threads               |
+| are running.                                                                    |
+|                                                                                 |
+| If you define RING_DECLS_ONLY, only the declarations                            |
+| of the type and its function will be declared.                                  |
+\*********************************************************************************/
+
+#ifndef RING_HEADER_H
+#define RING_HEADER_H
+// Inline functions, #defines and includes that will be
+// needed for all instantiations can go up here.
+#include "koliseo.h" // Before the system headers, for _POSIX_C_SOURCE
+#include <stdlib.h> // size_t
+#include <stdio.h> // fprintf, stderr
+#include <string.h> // memcpy
+#include <stdatomic.h> // atomic_load_explicit, atomic_store_explicit
+
+#define RING_IMPL(word) RING_COMB1(RING_PREFIX,word)
+#define RING_COMB1(pre, word) RING_COMB2(pre, word)
+#define RING_COMB2(pre, word) pre##word
+
+#ifndef RING_STARTING_CAPACITY
+#define RING_STARTING_CAPACITY 16 /**< Smallest capacity of a ring, must be a power of two.*/
+#endif // RING_STARTING_CAPACITY
+
+// Owner side accesses of head and tail, which need no ordering.
+#define RING_LOAD(x) atomic_load_explicit(&(x), memory_order_relaxed)
+#define RING_STORE(x, v) atomic_store_explicit(&(x), (v), memory_order_relaxed)
+
+#endif // RING_HEADER_H
+
+// NOTE: this section is *not* guarded as it is intended
+// to be included multiple times.
+
+#ifndef RING_T
+#error "RING_T must be defined"
+#endif
+
+// The name of the data type to be generated.
+// If not given, will expand to something like
+// `ring_int` for an `int`.
+#ifndef RING_NAME
+#define RING_NAME RING_COMB1(RING_COMB1(ring,_), RING_T)
+#endif
+
+// Prefix for generated functions.
+#ifndef RING_PREFIX
+#define RING_PREFIX RING_COMB1(RING_NAME, _)
+#endif
+
+// Customize the linkage of the function.
+#ifndef RING_LINKAGE
+#define RING_LINKAGE static inline
+#endif
+
+typedef struct RING_NAME RING_NAME;
+struct RING_NAME {
+    bool use_temp;
+    union {
+        Koliseo* kls;
+        Koliseo_Temp* t_kls;
+    } allocator;
+    RING_T* items;
+    size_t capacity;
+    _Alignas(64) _Atomic size_t head; // Counter of the first item, written by the consumer
+    size_t tail_cache; // Last tail seen by spsc_pop_n(), never past tail
+    _Alignas(64) _Atomic size_t tail; // Counter past the last item, written by the producer
+    size_t head_cache; // Last head seen by spsc_push_n(), never past head
+};
+
+#define RING_init RING_IMPL(init)
+#define RING_init_t RING_IMPL(init_t)
+#define RING_count RING_IMPL(count)
+#define RING_reserve RING_IMPL(reserve)
+#define RING_push_back RING_IMPL(push_back)
+#define RING_push_front RING_IMPL(push_front)
+#define RING_pop_front RING_IMPL(pop_front)
+#define RING_pop_back RING_IMPL(pop_back)
+#define RING_at RING_IMPL(at)
+#define RING_push_n RING_IMPL(push_n)
+#define RING_pop_n RING_IMPL(pop_n)
+#define RING_spsc_push_n RING_IMPL(spsc_push_n)
+#define RING_spsc_pop_n RING_IMPL(spsc_pop_n)
+#define RING_grow RING_IMPL(grow_)
+#define RING_copy_in RING_IMPL(copy_in_)
+#define RING_copy_out RING_IMPL(copy_out_)
+
+#ifdef RING_DECLS_ONLY
+
+RING_LINKAGE
+RING_NAME*
+RING_init(Koliseo* kls, size_t capacity);
+
+RING_LINKAGE
+RING_NAME*
+RING_init_t(Koliseo_Temp* t_kls, size_t capacity);
+
+RING_LINKAGE
+size_t
+RING_count(RING_NAME* ring);
+
+RING_LINKAGE
+void
+RING_reserve(RING_NAME* ring, size_t n);
+
+RING_LINKAGE
+void
+RING_push_back(RING_NAME* ring, RING_T item);
+
+RING_LINKAGE
+void
+RING_push_front(RING_NAME* ring, RING_T item);
+
+RING_LINKAGE
+bool
+RING_pop_front(RING_NAME* ring, RING_T* out);
+
+RING_LINKAGE
+bool
+RING_pop_back(RING_NAME* ring, RING_T* out);
+
+RING_LINKAGE
+RING_T*
+RING_at(RING_NAME* ring, size_t index);
+
+RING_LINKAGE
+void
+RING_push_n(RING_NAME* ring, RING_T const* items, size_t n);
+
+RING_LINKAGE
+size_t
+RING_pop_n(RING_NAME* ring, RING_T* out, size_t n);
+
+RING_LINKAGE
+size_t
+RING_spsc_push_n(RING_NAME* ring, RING_T const* items, size_t n);
+
+RING_LINKAGE
+size_t
+RING_spsc_pop_n(RING_NAME* ring, RING_T* out, size_t n);
+
+#else
+
+// Doubles the capacity until it is at least min_cap, with one KLS_REPUSH().
+// Items wrapped around the old end are moved right after it, so that masking with the new capacity finds them.
+static inline void RING_grow(RING_NAME* ring, size_t min_cap)
+{
+    size_t old_cap = ring->capacity;
+    size_t new_cap = old_cap;
+    while (new_cap < min_cap) {
+        new_cap *= 2;
+    }
+    if (new_cap == old_cap) {
+        return;
+    }
+    if (ring->use_temp) {
+        ring->items = KLS_REPUSH_T(ring->allocator.t_kls, ring->items, RING_T, old_cap, new_cap);
+    } else {
+        ring->items = KLS_REPUSH(ring->allocator.kls, ring->items, RING_T, old_cap, new_cap);
+    }
+    if (!ring->items) {
+        fprintf(stderr, "In %s, at %i: %s(): failed KLS_REPUSH()\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    size_t count = RING_LOAD(ring->tail) - RING_LOAD(ring->head);
+    size_t first = RING_LOAD(ring->head) & (old_cap - 1);
+    if (first + count > old_cap) {
+        memcpy(ring->items + old_cap, ring->items, (first + count - old_cap) * sizeof(RING_T));
+    }
+    RING_STORE(ring->head, first);
+    RING_STORE(ring->tail, first + count);
+    ring->head_cache = first;
+    ring->tail_cache = first + count;
+    ring->capacity = new_cap;
+}
+
+// Copies n items in from counter pos, in up to two runs.
+static inline void RING_copy_in(RING_NAME* ring, size_t pos, RING_T const* items, size_t n)
+{
+    size_t at = pos & (ring->capacity - 1);
+    size_t run = (n < ring->capacity - at ? n : ring->capacity - at);
+    memcpy(ring->items + at, items, run * sizeof(RING_T));
+    memcpy(ring->items, items + run, (n - run) * sizeof(RING_T));
+}
+
+// Copies n items out from counter pos, in up to two runs.
+static inline void RING_copy_out(RING_NAME* ring, size_t pos, RING_T* out, size_t n)
+{
+    size_t at = pos & (ring->capacity - 1);
+    size_t run = (n < ring->capacity - at ? n : ring->capacity - at);
+    memcpy(out, ring->items + at, run * sizeof(RING_T));
+    memcpy(out + run, ring->items, (n - run) * sizeof(RING_T));
+}
+
+RING_LINKAGE
+RING_NAME*
+RING_init(Koliseo* kls, size_t capacity)
+{
+    // This functions sets the passed Koliseo as the backing memory for the ring, and returns a pointer to it.
+    // Capacity is rounded up to a power of two.
+    if(kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    size_t cap = RING_STARTING_CAPACITY;
+    while (cap < capacity) {
+        cap *= 2;
+    }
+    RING_NAME* res = KLS_PUSH(kls, RING_NAME);
+    RING_T* items = (res ? KLS_PUSH_ARR(kls, RING_T, cap) : NULL);
+    if (items == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): failed pushing ring.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    res->use_temp = false;
+    res->allocator.kls = kls;
+    res->items = items;
+    res->capacity = cap;
+    return res;
+}
+
+RING_LINKAGE
+RING_NAME*
+RING_init_t(Koliseo_Temp* t_kls, size_t capacity)
+{
+    // This functions sets the passed Koliseo_Temp as the backing memory for the ring, and returns a pointer to it.
+    // Capacity is rounded up to a power of two.
+    if(t_kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): t_kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    size_t cap = RING_STARTING_CAPACITY;
+    while (cap < capacity) {
+        cap *= 2;
+    }
+    RING_NAME* res = KLS_PUSH_T(t_kls, RING_NAME);
+    RING_T* items = (res ? KLS_PUSH_ARR_T(t_kls, RING_T, cap) : NULL);
+    if (items == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): failed pushing ring.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    res->use_temp = true;
+    res->allocator.t_kls = t_kls;
+    res->items = items;
+    res->capacity = cap;
+    return res;
+}
+
+RING_LINKAGE
+size_t
+RING_count(RING_NAME* ring)
+{
+    return RING_LOAD(ring->tail) - RING_LOAD(ring->head);
+}
+
+RING_LINKAGE
+void
+RING_reserve(RING_NAME* ring, size_t n)
+{
+    // Grows the ring so that n more items fit.
+    RING_grow(ring, RING_count(ring) + n);
+}
+
+RING_LINKAGE
+void
+RING_push_back(RING_NAME* ring, RING_T item)
+{
+    size_t tail = RING_LOAD(ring->tail);
+    if (tail - RING_LOAD(ring->head) == ring->capacity) {
+        RING_grow(ring, ring->capacity + 1);
+        tail = RING_LOAD(ring->tail);
+    }
+    ring->items[tail & (ring->capacity - 1)] = item;
+    RING_STORE(ring->tail, tail + 1);
+}
+
+RING_LINKAGE
+void
+RING_push_front(RING_NAME* ring, RING_T item)
+{
+    if (RING_count(ring) == ring->capacity) {
+        RING_grow(ring, ring->capacity + 1);
+    }
+    size_t head = RING_LOAD(ring->head) - 1;
+    ring->items[head & (ring->capacity - 1)] = item;
+    RING_STORE(ring->head, head);
+    ring->head_cache = head;
+}
+
+RING_LINKAGE
+bool
+RING_pop_front(RING_NAME* ring, RING_T* out)
+{
+    // Sets *out to the first item, if out is not NULL, and removes it. Returns false if the ring was empty.
+    size_t head = RING_LOAD(ring->head);
+    if (head == RING_LOAD(ring->tail)) {
+        return false;
+    }
+    if (out != NULL) {
+        *out = ring->items[head & (ring->capacity - 1)];
+    }
+    RING_STORE(ring->head, head + 1);
+    ring->head_cache = head + 1;
+    return true;
+}
+
+RING_LINKAGE
+bool
+RING_pop_back(RING_NAME* ring, RING_T* out)
+{
+    // Sets *out to the last item, if out is not NULL, and removes it. Returns false if the ring was empty.
+    size_t tail = RING_LOAD(ring->tail);
+    if (tail == RING_LOAD(ring->head)) {
+        return false;
+    }
+    tail--;
+    if (out != NULL) {
+        *out = ring->items[tail & (ring->capacity - 1)];
+    }
+    RING_STORE(ring->tail, tail);
+    ring->tail_cache = tail;
+    return true;
+}
+
+RING_LINKAGE
+RING_T*
+RING_at(RING_NAME* ring, size_t index)
+{
+    // Returns a pointer to the item at index from the front, or NULL if there is none.
+    if (index >= RING_count(ring)) {
+        return NULL;
+    }
+    return &ring->items[(RING_LOAD(ring->head) + index) & (ring->capacity - 1)];
+}
+
+RING_LINKAGE
+void
+RING_push_n(RING_NAME* ring, RING_T const* items, size_t n)
+{
+    // Appends n items, growing the ring at most once.
+    RING_reserve(ring, n);
+    size_t tail = RING_LOAD(ring->tail);
+    RING_copy_in(ring, tail, items, n);
+    RING_STORE(ring->tail, tail + n);
+}
+
+RING_LINKAGE
+size_t
+RING_pop_n(RING_NAME* ring, RING_T* out, size_t n)
+{
+    // Moves up to n items from the front to out, and returns how many were moved.
+    size_t head = RING_LOAD(ring->head);
+    size_t count = RING_LOAD(ring->tail) - head;
+    if (n > count) {
+        n = count;
+    }
+    RING_copy_out(ring, head, out, n);
+    RING_STORE(ring->head, head + n);
+    ring->head_cache = head + n;
+    return n;
+}
+
+RING_LINKAGE
+size_t
+RING_spsc_push_n(RING_NAME* ring, RING_T const* items, size_t n)
+{
+    // Producer side: appends up to n items without growing, and returns how many were appended.
+    // The items are published to the consumer by the release store of tail.
+    size_t tail = RING_LOAD(ring->tail);
+    size_t room = ring->capacity - (tail - ring->head_cache);
+    // After push_back() or push_n(), tail may have gone past the cached head by more than capacity
+    if (room < n || tail - ring->head_cache > ring->capacity) {
+        ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        room = ring->capacity - (tail - ring->head_cache);
+        if (n > room) {
+            n = room;
+        }
+    }
+    if (n == 0) {
+        return 0;
+    }
+    RING_copy_in(ring, tail, items, n);
+    atomic_store_explicit(&ring->tail, tail + n, memory_order_release);
+    return n;
+}
+
+RING_LINKAGE
+size_t
+RING_spsc_pop_n(RING_NAME* ring, RING_T* out, size_t n)
+{
+    // Consumer side: moves up to n items to out, and returns how many were moved.
+    // The slots are handed back to the producer by the release store of head.
+    size_t head = RING_LOAD(ring->head);
+    size_t count = ring->tail_cache - head;
+    // After pop_front() or pop_n(), head may have gone past the cached tail
+    if (count < n || count > ring->capacity) {
+        ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        count = ring->tail_cache - head;
+        if (n > count) {
+            n = count;
+        }
+    }
+    if (n == 0) {
+        return 0;
+    }
+    RING_copy_out(ring, head, out, n);
+    atomic_store_explicit(&ring->head, head + n, memory_order_release);
+    return n;
+}
+
+#endif // RING_DECLS_ONLY
+
+// Cleanup
+// These need to be undef'ed so they can be redefined the
+// next time you need to instantiate this template.
+#undef RING_T
+#undef RING_PREFIX
+#undef RING_NAME
+#undef RING_LINKAGE
+#undef RING_init
+#undef RING_init_t
+#undef RING_count
+#undef RING_reserve
+#undef RING_push_back
+#undef RING_push_front
+#undef RING_pop_front
+#undef RING_pop_back
+#undef RING_at
+#undef RING_push_n
+#undef RING_pop_n
+#undef RING_spsc_push_n
+#undef RING_spsc_pop_n
+#undef RING_grow
+#undef RING_copy_in
+#undef RING_copy_out
+#ifdef RING_DECLS_ONLY
+#undef RING_DECLS_ONLY
+#endif // RING_DECLS_ONLY
+#endif // RING_T
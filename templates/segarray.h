@@ -0,0 +1,319 @@
+#ifdef SEGARRAY_T //This ensures the library never causes any trouble if this macro was not defined.
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/*********************************************************************************\
+| segarray.h                                                                      |
+| This code is based on an idea from https://www.davidpriver.com/ctemplates.html. |
+| Include this header multiple times to implement a                               |
+| segmented array. Before inclusion define at least                               |
+| SEGARRAY_T to the type the array can hold.                                      |
+| See SEGARRAY_NAME, SEGARRAY_PREFIX and SEGARRAY_LINKAGE for                     |
+| other customization points.                                                     |
+|                                                                                 |
+| Items live in segments pushed on the Koliseo, each twice as                     |
+| big as the one before, starting from 1 << SEGARRAY_FIRST_SHIFT.                 |
+| Growing pushes a new segment and never moves items, so their                    |
+| addresses stay valid. Index i is found in O(1) from the                         |
+| position of the highest set bit of i + first segment size.                      |
+|                                                                                 |
+| If you define SEGARRAY_DECLS_ONLY, only the declarations                        |
+| of the type and its function will be declared.                                  |
+\*********************************************************************************/
+
+#ifndef SEGARRAY_HEADER_H
+#define SEGARRAY_HEADER_H
+// Inline functions, #defines and includes that will be
+// needed for all instantiations can go up here.
+#include <stdlib.h> // size_t
+#include <stdio.h> // fprintf, stderr
+#include <string.h> // memcpy
+
+#define SEGARRAY_IMPL(word) SEGARRAY_COMB1(SEGARRAY_PREFIX,word)
+#define SEGARRAY_COMB1(pre, word) SEGARRAY_COMB2(pre, word)
+#define SEGARRAY_COMB2(pre, word) pre##word
+
+#ifndef SEGARRAY_MAX_SEGMENTS
+#define SEGARRAY_MAX_SEGMENTS 40 /**< Size of the segment table.*/
+#endif // SEGARRAY_MAX_SEGMENTS
+
+static inline int segarray__log2(uint64_t x)
+{
+    return 63 - __builtin_clzll(x);
+}
+
+#endif // SEGARRAY_HEADER_H
+
+// NOTE: this section is *not* guarded as it is intended
+// to be included multiple times.
+
+#ifndef SEGARRAY_T
+#error "SEGARRAY_T must be defined"
+#endif
+
+// The name of the data type to be generated.
+// If not given, will expand to something like
+// `segarray_int` for an `int`.
+#ifndef SEGARRAY_NAME
+#define SEGARRAY_NAME SEGARRAY_COMB1(SEGARRAY_COMB1(segarray,_), SEGARRAY_T)
+#endif
+
+// Prefix for generated functions.
+#ifndef SEGARRAY_PREFIX
+#define SEGARRAY_PREFIX SEGARRAY_COMB1(SEGARRAY_NAME, _)
+#endif
+
+// Customize the linkage of the function.
+#ifndef SEGARRAY_LINKAGE
+#define SEGARRAY_LINKAGE static inline
+#endif
+
+// The first segment holds 1 << SEGARRAY_FIRST_SHIFT items.
+#ifndef SEGARRAY_FIRST_SHIFT
+#define SEGARRAY_FIRST_SHIFT 4
+#endif // SEGARRAY_FIRST_SHIFT
+
+typedef struct SEGARRAY_NAME SEGARRAY_NAME;
+struct SEGARRAY_NAME {
+    bool use_temp;
+    union {
+        Koliseo* kls;
+        Koliseo_Temp* t_kls;
+    } allocator;
+    size_t count;
+    size_t capacity;
+    size_t segment_count;
+    SEGARRAY_T* segments[SEGARRAY_MAX_SEGMENTS]; // Segment k holds 1 << (k + SEGARRAY_FIRST_SHIFT) items
+};
+
+#define SEGARRAY_init SEGARRAY_IMPL(init)
+#define SEGARRAY_init_t SEGARRAY_IMPL(init_t)
+#define SEGARRAY_reserve SEGARRAY_IMPL(reserve)
+#define SEGARRAY_push SEGARRAY_IMPL(push)
+#define SEGARRAY_push_n SEGARRAY_IMPL(push_n)
+#define SEGARRAY_at SEGARRAY_IMPL(at)
+#define SEGARRAY_segment SEGARRAY_IMPL(segment)
+#define SEGARRAY_truncate SEGARRAY_IMPL(truncate)
+#define SEGARRAY_add_segment SEGARRAY_IMPL(add_segment_)
+
+#ifdef SEGARRAY_DECLS_ONLY
+
+SEGARRAY_LINKAGE
+SEGARRAY_NAME*
+SEGARRAY_init(Koliseo* kls);
+
+SEGARRAY_LINKAGE
+SEGARRAY_NAME*
+SEGARRAY_init_t(Koliseo_Temp* t_kls);
+
+SEGARRAY_LINKAGE
+void
+SEGARRAY_reserve(SEGARRAY_NAME* array, size_t n);
+
+SEGARRAY_LINKAGE
+SEGARRAY_T*
+SEGARRAY_push(SEGARRAY_NAME* array, SEGARRAY_T item);
+
+SEGARRAY_LINKAGE
+void
+SEGARRAY_push_n(SEGARRAY_NAME* array, SEGARRAY_T const* items, size_t n);
+
+SEGARRAY_LINKAGE
+SEGARRAY_T*
+SEGARRAY_at(SEGARRAY_NAME* array, size_t index);
+
+SEGARRAY_LINKAGE
+size_t
+SEGARRAY_segment(SEGARRAY_NAME* array, size_t k, SEGARRAY_T** items);
+
+SEGARRAY_LINKAGE
+void
+SEGARRAY_truncate(SEGARRAY_NAME* array, size_t count);
+
+#else
+
+// Pushes the next segment, leaving the others where they are.
+static inline void SEGARRAY_add_segment(SEGARRAY_NAME* array)
+{
+    size_t k = array->segment_count;
+    if (k >= SEGARRAY_MAX_SEGMENTS) {
+        fprintf(stderr, "In %s, at %i: %s(): all {%i} segments are in use\n", __FILE__, __LINE__, __func__, SEGARRAY_MAX_SEGMENTS);
+        exit(EXIT_FAILURE);
+    }
+    size_t len = (size_t) 1 << (k + SEGARRAY_FIRST_SHIFT);
+    SEGARRAY_T* segment = NULL;
+    if (array->use_temp) {
+        segment = KLS_PUSH_ARR_T(array->allocator.t_kls, SEGARRAY_T, len);
+    } else {
+        segment = KLS_PUSH_ARR(array->allocator.kls, SEGARRAY_T, len);
+    }
+    if (!segment) {
+        fprintf(stderr, "In %s, at %i: %s(): failed pushing segment of {%zu} items\n", __FILE__, __LINE__, __func__, len);
+        exit(EXIT_FAILURE);
+    }
+    array->segments[k] = segment;
+    array->segment_count++;
+    array->capacity += len;
+}
+
+SEGARRAY_LINKAGE
+SEGARRAY_NAME*
+SEGARRAY_init(Koliseo* kls)
+{
+    // This functions sets the passed Koliseo as the backing memory for the array, and returns a pointer to it.
+    if(kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    SEGARRAY_NAME* res = KLS_PUSH(kls, SEGARRAY_NAME);
+    if (res == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): res was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    res->use_temp = false;
+    res->allocator.kls = kls;
+    return res;
+}
+
+SEGARRAY_LINKAGE
+SEGARRAY_NAME*
+SEGARRAY_init_t(Koliseo_Temp* t_kls)
+{
+    // This functions sets the passed Koliseo_Temp as the backing memory for the array, and returns a pointer to it.
+    if(t_kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): t_kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    SEGARRAY_NAME* res = KLS_PUSH_T(t_kls, SEGARRAY_NAME);
+    if (res == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): res was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    res->use_temp = true;
+    res->allocator.t_kls = t_kls;
+    return res;
+}
+
+SEGARRAY_LINKAGE
+void
+SEGARRAY_reserve(SEGARRAY_NAME* array, size_t n)
+{
+    // Pushes segments until n more items fit.
+    while (array->count + n > array->capacity) {
+        SEGARRAY_add_segment(array);
+    }
+}
+
+SEGARRAY_LINKAGE
+SEGARRAY_T*
+SEGARRAY_at(SEGARRAY_NAME* array, size_t index)
+{
+    // Returns a pointer to the item at index, valid for the lifetime of the array.
+    if (index >= array->count) {
+        fprintf(stderr, "In %s, at %i: %s(): index {%zu} is not below count {%zu}\n", __FILE__, __LINE__, __func__, index, array->count);
+        exit(EXIT_FAILURE);
+    }
+    uint64_t pos = (uint64_t) index + ((uint64_t) 1 << SEGARRAY_FIRST_SHIFT);
+    int hb = segarray__log2(pos);
+    return &array->segments[hb - SEGARRAY_FIRST_SHIFT][pos - ((uint64_t) 1 << hb)];
+}
+
+SEGARRAY_LINKAGE
+SEGARRAY_T*
+SEGARRAY_push(SEGARRAY_NAME* array, SEGARRAY_T item)
+{
+    // Appends item, and returns its stable address.
+    if (array->count >= array->capacity) {
+        SEGARRAY_add_segment(array);
+    }
+    array->count++;
+    SEGARRAY_T* slot = SEGARRAY_at(array, array->count - 1);
+    *slot = item;
+    return slot;
+}
+
+SEGARRAY_LINKAGE
+void
+SEGARRAY_push_n(SEGARRAY_NAME* array, SEGARRAY_T const* items, size_t n)
+{
+    // Appends n items, with one copy per segment they span.
+    SEGARRAY_reserve(array, n);
+    while (n > 0) {
+        uint64_t pos = (uint64_t) array->count + ((uint64_t) 1 << SEGARRAY_FIRST_SHIFT);
+        int hb = segarray__log2(pos);
+        size_t off = pos - ((uint64_t) 1 << hb);
+        size_t room = ((size_t) 1 << hb) - off;
+        size_t len = (n < room ? n : room);
+        memcpy(array->segments[hb - SEGARRAY_FIRST_SHIFT] + off, items, len * sizeof(SEGARRAY_T));
+        array->count += len;
+        items += len;
+        n -= len;
+    }
+}
+
+SEGARRAY_LINKAGE
+size_t
+SEGARRAY_segment(SEGARRAY_NAME* array, size_t k, SEGARRAY_T** items)
+{
+    // Sets *items to segment k, and returns how many of its items are in use.
+    // Loops over segments scan contiguous memory.
+    if (k >= array->segment_count) {
+        *items = NULL;
+        return 0;
+    }
+    size_t start = ((size_t) 1 << (k + SEGARRAY_FIRST_SHIFT)) - ((size_t) 1 << SEGARRAY_FIRST_SHIFT);
+    size_t len = (size_t) 1 << (k + SEGARRAY_FIRST_SHIFT);
+    *items = array->segments[k];
+    if (array->count <= start) {
+        return 0;
+    }
+    return (array->count - start < len ? array->count - start : len);
+}
+
+SEGARRAY_LINKAGE
+void
+SEGARRAY_truncate(SEGARRAY_NAME* array, size_t count)
+{
+    // Drops the items from count on. Segments are kept for later pushes.
+    if (count < array->count) {
+        array->count = count;
+    }
+}
+
+#endif // SEGARRAY_DECLS_ONLY
+
+// Cleanup
+// These need to be undef'ed so they can be redefined the
+// next time you need to instantiate this template.
+#undef SEGARRAY_T
+#undef SEGARRAY_PREFIX
+#undef SEGARRAY_NAME
+#undef SEGARRAY_LINKAGE
+#undef SEGARRAY_FIRST_SHIFT
+#undef SEGARRAY_init
+#undef SEGARRAY_init_t
+#undef SEGARRAY_reserve
+#undef SEGARRAY_push
+#undef SEGARRAY_push_n
+#undef SEGARRAY_at
+#undef SEGARRAY_segment
+#undef SEGARRAY_truncate
+#undef SEGARRAY_add_segment
+#ifdef SEGARRAY_DECLS_ONLY
+#undef SEGARRAY_DECLS_ONLY
+#endif // SEGARRAY_DECLS_ONLY
+#endif // SEGARRAY_T
@@ -0,0 +1,349 @@
+#ifdef SOA_FIELDS //This ensures the library never causes any trouble if this macro was not defined.
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/*********************************************************************************\
+| soa.h                                                                           |
+| This code is based on an idea from https://www.davidpriver.com/ctemplates.html. |
+| Include this header multiple times to implement a                               |
+| structure of arrays: one array per field, with a shared                         |
+| count and capacity. Before inclusion define SOA_NAME, and                       |
+| SOA_FIELDS to a list of X(type, name) entries, like:                            |
+|                                                                                 |
+|   #define SOA_NAME particles                                                    |
+|   #define SOA_FIELDS(X) X(float, x) X(float, y) X(int, id)                      |
+|                                                                                 |
+| Each field becomes a column: soa->x[i] is the x of row i.                       |
+| Field names must differ from count, capacity, allocator and                     |
+| use_temp.                                                                       |
+| Loops over one column read dense memory, that the compiler                      |
+| can vectorize. Columns start on SOA_ALIGN byte boundaries.                      |
+| All columns share one push, so growing moves them at once.                      |
+| See SOA_PREFIX and SOA_LINKAGE for other customization points.                  |
+|                                                                                 |
+| If you define SOA_DECLS_ONLY, only the declarations                             |
+| of the type and its function will be declared.                                  |
+\*********************************************************************************/
+
+#ifndef SOA_HEADER_H
+#define SOA_HEADER_H
+// Inline functions, #defines and includes that will be
+// needed for all instantiations can go up here.
+#include <stdlib.h> // size_t
+#include <stdio.h> // fprintf, stderr
+#include <string.h> // memcpy
+
+#define SOA_IMPL(word) SOA_COMB1(SOA_PREFIX,word)
+#define SOA_COMB1(pre, word) SOA_COMB2(pre, word)
+#define SOA_COMB2(pre, word) pre##word
+
+// X() expansions over SOA_FIELDS
+#define SOA_COLUMN(type, name) type* name;
+#define SOA_ROW_FIELD(type, name) type name;
+#define SOA_PARAM(type, name) , type name
+#define SOA_STORE(type, name) soa->name[soa->count] = name;
+#define SOA_STORE_ROW(type, name) soa->name[soa->count] = row.name;
+#define SOA_LOAD(type, name) row.name = soa->name[index];
+#define SOA_SET(type, name) soa->name[index] = row.name;
+#define SOA_SWAP_LAST(type, name) soa->name[index] = soa->name[soa->count];
+
+static inline size_t soa__align_up(size_t off, size_t align)
+{
+    return (off + align - 1) & ~(align - 1);
+}
+
+#endif // SOA_HEADER_H
+
+// NOTE: this section is *not* guarded as it is intended
+// to be included multiple times.
+
+#ifndef SOA_NAME
+#error "SOA_NAME must be defined"
+#endif
+
+// Prefix for generated functions.
+#ifndef SOA_PREFIX
+#define SOA_PREFIX SOA_COMB1(SOA_NAME, _)
+#endif
+
+// Customize the linkage of the function.
+#ifndef SOA_LINKAGE
+#define SOA_LINKAGE static inline
+#endif
+
+#ifndef SOA_ROW_NAME
+#define SOA_ROW_NAME SOA_COMB1(SOA_NAME, _row)
+#endif
+
+#ifndef SOA_STARTING_CAPACITY
+#define SOA_STARTING_CAPACITY 16
+#endif // SOA_STARTING_CAPACITY
+
+// Alignment of each column. Must be a power of two.
+#ifndef SOA_ALIGN
+#define SOA_ALIGN 64
+#endif // SOA_ALIGN
+
+// One row, with a member per field.
+typedef struct SOA_ROW_NAME {
+    SOA_FIELDS(SOA_ROW_FIELD)
+} SOA_ROW_NAME;
+
+typedef struct SOA_NAME SOA_NAME;
+struct SOA_NAME {
+    bool use_temp;
+    union {
+        Koliseo* kls;
+        Koliseo_Temp* t_kls;
+    } allocator;
+    size_t count;
+    size_t capacity;
+    SOA_FIELDS(SOA_COLUMN)
+};
+
+#define SOA_init SOA_IMPL(init)
+#define SOA_init_t SOA_IMPL(init_t)
+#define SOA_reserve SOA_IMPL(reserve)
+#define SOA_push SOA_IMPL(push)
+#define SOA_push_row SOA_IMPL(push_row)
+#define SOA_get SOA_IMPL(get)
+#define SOA_set SOA_IMPL(set)
+#define SOA_swap_remove SOA_IMPL(swap_remove)
+#define SOA_truncate SOA_IMPL(truncate)
+#define SOA_grow SOA_IMPL(grow_)
+
+#ifdef SOA_DECLS_ONLY
+
+SOA_LINKAGE
+SOA_NAME*
+SOA_init(Koliseo* kls);
+
+SOA_LINKAGE
+SOA_NAME*
+SOA_init_t(Koliseo_Temp* t_kls);
+
+SOA_LINKAGE
+void
+SOA_reserve(SOA_NAME* soa, size_t n);
+
+SOA_LINKAGE
+size_t
+SOA_push(SOA_NAME* soa SOA_FIELDS(SOA_PARAM));
+
+SOA_LINKAGE
+size_t
+SOA_push_row(SOA_NAME* soa, SOA_ROW_NAME row);
+
+SOA_LINKAGE
+SOA_ROW_NAME
+SOA_get(const SOA_NAME* soa, size_t index);
+
+SOA_LINKAGE
+void
+SOA_set(SOA_NAME* soa, size_t index, SOA_ROW_NAME row);
+
+SOA_LINKAGE
+void
+SOA_swap_remove(SOA_NAME* soa, size_t index);
+
+SOA_LINKAGE
+void
+SOA_truncate(SOA_NAME* soa, size_t count);
+
+#else
+
+// Moves every column to a single new push holding at least min_cap rows, doubling the capacity as needed.
+static inline void SOA_grow(SOA_NAME* soa, size_t min_cap)
+{
+    size_t new_cap = soa->capacity?soa->capacity*2:SOA_STARTING_CAPACITY;
+    while (new_cap < min_cap) {
+        new_cap *= 2;
+    }
+    size_t size = 0;
+#define SOA_SIZE(type, name) size = soa__align_up(size, SOA_ALIGN) + new_cap * sizeof(type);
+    SOA_FIELDS(SOA_SIZE)
+#undef SOA_SIZE
+    char* block = NULL;
+    if (soa->use_temp) {
+        block = kls_temp_push_zero_ext(soa->allocator.t_kls, 1, SOA_ALIGN, size);
+    } else {
+        block = kls_push_zero_ext(soa->allocator.kls, 1, SOA_ALIGN, size);
+    }
+    if (!block) {
+        fprintf(stderr, "In %s, at %i: %s(): failed pushing {%zu} rows\n", __FILE__, __LINE__, __func__, new_cap);
+        exit(EXIT_FAILURE);
+    }
+    size_t off = 0;
+#define SOA_MOVE(type, name) { \
+        off = soa__align_up(off, SOA_ALIGN); \
+        type* col = (type*) (block + off); \
+        if (soa->count > 0) memcpy(col, soa->name, soa->count * sizeof(type)); \
+        soa->name = col; \
+        off += new_cap * sizeof(type); \
+    }
+    SOA_FIELDS(SOA_MOVE)
+#undef SOA_MOVE
+    soa->capacity = new_cap;
+}
+
+SOA_LINKAGE
+SOA_NAME*
+SOA_init(Koliseo* kls)
+{
+    // This functions sets the passed Koliseo as the backing memory for the columns, and returns a pointer to the struct.
+    if(kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    SOA_NAME* res = KLS_PUSH(kls, SOA_NAME);
+    if (res == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): res was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    res->use_temp = false;
+    res->allocator.kls = kls;
+    SOA_grow(res, SOA_STARTING_CAPACITY);
+    return res;
+}
+
+SOA_LINKAGE
+SOA_NAME*
+SOA_init_t(Koliseo_Temp* t_kls)
+{
+    // This functions sets the passed Koliseo_Temp as the backing memory for the columns, and returns a pointer to the struct.
+    if(t_kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): t_kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    SOA_NAME* res = KLS_PUSH_T(t_kls, SOA_NAME);
+    if (res == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): res was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    res->use_temp = true;
+    res->allocator.t_kls = t_kls;
+    SOA_grow(res, SOA_STARTING_CAPACITY);
+    return res;
+}
+
+SOA_LINKAGE
+void
+SOA_reserve(SOA_NAME* soa, size_t n)
+{
+    // Makes room for at least n more rows, so that the next n pushes do not move the columns.
+    if (soa->count + n > soa->capacity) {
+        SOA_grow(soa, soa->count + n);
+    }
+}
+
+SOA_LINKAGE
+size_t
+SOA_push(SOA_NAME* soa SOA_FIELDS(SOA_PARAM))
+{
+    // Appends a row from one argument per field, in SOA_FIELDS order. Returns its index.
+    if (soa->count >= soa->capacity) {
+        SOA_grow(soa, soa->count + 1);
+    }
+    SOA_FIELDS(SOA_STORE)
+    return soa->count++;
+}
+
+SOA_LINKAGE
+size_t
+SOA_push_row(SOA_NAME* soa, SOA_ROW_NAME row)
+{
+    if (soa->count >= soa->capacity) {
+        SOA_grow(soa, soa->count + 1);
+    }
+    SOA_FIELDS(SOA_STORE_ROW)
+    return soa->count++;
+}
+
+SOA_LINKAGE
+SOA_ROW_NAME
+SOA_get(const SOA_NAME* soa, size_t index)
+{
+    // Gathers row index from every column.
+    if (index >= soa->count) {
+        fprintf(stderr, "In %s, at %i: %s(): index {%zu} is not below count {%zu}\n", __FILE__, __LINE__, __func__, index, soa->count);
+        exit(EXIT_FAILURE);
+    }
+    SOA_ROW_NAME row;
+    SOA_FIELDS(SOA_LOAD)
+    return row;
+}
+
+SOA_LINKAGE
+void
+SOA_set(SOA_NAME* soa, size_t index, SOA_ROW_NAME row)
+{
+    if (index >= soa->count) {
+        fprintf(stderr, "In %s, at %i: %s(): index {%zu} is not below count {%zu}\n", __FILE__, __LINE__, __func__, index, soa->count);
+        exit(EXIT_FAILURE);
+    }
+    SOA_FIELDS(SOA_SET)
+}
+
+SOA_LINKAGE
+void
+SOA_swap_remove(SOA_NAME* soa, size_t index)
+{
+    // Removes row index in O(1), moving the last row in its place.
+    if (index >= soa->count) {
+        fprintf(stderr, "In %s, at %i: %s(): index {%zu} is not below count {%zu}\n", __FILE__, __LINE__, __func__, index, soa->count);
+        exit(EXIT_FAILURE);
+    }
+    soa->count--;
+    SOA_FIELDS(SOA_SWAP_LAST)
+}
+
+SOA_LINKAGE
+void
+SOA_truncate(SOA_NAME* soa, size_t count)
+{
+    // Drops the rows from count on. The capacity is kept for later pushes.
+    if (count < soa->count) {
+        soa->count = count;
+    }
+}
+
+#endif // SOA_DECLS_ONLY
+
+// Cleanup
+// These need to be undef'ed so they can be redefined the
+// next time you need to instantiate this template.
+#undef SOA_FIELDS
+#undef SOA_PREFIX
+#undef SOA_NAME
+#undef SOA_ROW_NAME
+#undef SOA_LINKAGE
+#undef SOA_STARTING_CAPACITY
+#undef SOA_ALIGN
+#undef SOA_init
+#undef SOA_init_t
+#undef SOA_reserve
+#undef SOA_push
+#undef SOA_push_row
+#undef SOA_get
+#undef SOA_set
+#undef SOA_swap_remove
+#undef SOA_truncate
+#undef SOA_grow
+#ifdef SOA_DECLS_ONLY
+#undef SOA_DECLS_ONLY
+#endif // SOA_DECLS_ONLY
+#endif // SOA_FIELDS
@@ -0,0 +1,493 @@
+#ifdef UDLIST_T //This ensures the library never causes any trouble if this macro was not defined.
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+    Copyright (C) 2026  jgabaut
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*****************************************************************************\
+| udllist.h                                                                   |
+| This is a template for an unrolled doubly linked list, inspired by the      |
+| dynamic array example in                                                    |
+| https://www.davidpriver.com/ctemplates.html#template-headers.               |
+| Include this header multiple times to implement an unrolled linked list.    |
+| Before inclusion define at least UDLIST_T to the type the list can hold.    |
+| See UDLIST_NAME, UDLIST_PREFIX and UDLIST_LINKAGE for other customization   |
+| points.                                                                     |
+|                                                                             |
+| Each node stores up to UDLIST_NODE_ITEMS values, contiguous from            |
+| items[start] to items[start + count - 1]. Nodes are pushed on a Koliseo     |
+| or Koliseo_Temp, and the ones emptied by removals are reused.               |
+| Iterate with:                                                               |
+|   for (node = list->firstNode; node; node = node->next)                     |
+|       for (size_t i = 0; i < node->count; i++)                              |
+|           use(node->items[node->start + i]);                                |
+|                                                                             |
+| If you define UDLIST_DECLS_ONLY, only the declarations                      |
+| of the type and its function will be declared.                              |
+\*****************************************************************************/
+
+#ifndef UDLLIST_HEADER_H
+#define UDLLIST_HEADER_H
+// Inline functions, #defines and includes that will be
+// needed for all instantiations can go up here.
+#include <stdlib.h> // size_t
+#include <stdio.h> // fprintf, stderr
+#include <string.h> // memmove, memcpy
+
+#define UDLIST_IMPL(word) UDLIST_COMB1(UDLIST_PREFIX,word)
+#define UDLIST_COMB1(pre, word) UDLIST_COMB2(pre, word)
+#define UDLIST_COMB2(pre, word) pre##word
+
+#define UDLLIST_HEADER_VERSION "0.1.0"
+
+#endif // UDLLIST_HEADER_H
+
+// NOTE: this section is *not* guarded as it is intended
+// to be included multiple times.
+
+#ifndef UDLIST_T
+#error "UDLIST_T must be defined"
+#endif
+
+// The name of the data type to be generated.
+// If not given, will expand to something like
+// `udlist_int` for an `int`.
+#ifndef UDLIST_NAME
+#define UDLIST_NAME UDLIST_COMB1(UDLIST_COMB1(udlist,_), UDLIST_T)
+#endif
+
+// Prefix for generated functions.
+#ifndef UDLIST_PREFIX
+#define UDLIST_PREFIX UDLIST_COMB1(UDLIST_NAME, _)
+#endif
+
+// Customize the linkage of the function.
+#ifndef UDLIST_LINKAGE
+#define UDLIST_LINKAGE static inline
+#endif
+
+// The name of the node data type to be generated.
+#ifndef UDLIST_NODE_NAME
+#define UDLIST_NODE_NAME UDLIST_COMB1(UDLIST_NAME, _node)
+#endif
+
+// Values held by each node. By default, nodes take about 256 bytes.
+#ifndef UDLIST_NODE_ITEMS
+#define UDLIST_NODE_ITEMS ((256 - 4 * sizeof(void*)) / sizeof(UDLIST_T) > 4 ? (256 - 4 * sizeof(void*)) / sizeof(UDLIST_T) : 4)
+#endif // UDLIST_NODE_ITEMS
+
+typedef struct UDLIST_NODE_NAME UDLIST_NODE_NAME;
+struct UDLIST_NODE_NAME {
+    UDLIST_NODE_NAME* prev;
+    UDLIST_NODE_NAME* next;
+    size_t start; // Slot of the first value
+    size_t count;
+    UDLIST_T items[UDLIST_NODE_ITEMS];
+};
+
+typedef struct UDLIST_NAME UDLIST_NAME;
+struct UDLIST_NAME {
+    bool use_temp;
+    union {
+        Koliseo* kls;
+        Koliseo_Temp* t_kls;
+    } allocator;
+    UDLIST_NODE_NAME* firstNode;
+    UDLIST_NODE_NAME* lastNode;
+    UDLIST_NODE_NAME* freeNodes; // Emptied nodes, linked by next
+    size_t len;
+};
+
+#define UDLIST_newList_kls UDLIST_IMPL(newList_kls)
+#define UDLIST_newList_t UDLIST_IMPL(newList_t)
+#define UDLIST_insertBeginning UDLIST_IMPL(insertBeginning)
+#define UDLIST_insertEnd UDLIST_IMPL(insertEnd)
+#define UDLIST_popBeginning UDLIST_IMPL(popBeginning)
+#define UDLIST_popEnd UDLIST_IMPL(popEnd)
+#define UDLIST_getAt UDLIST_IMPL(getAt)
+#define UDLIST_insertAt UDLIST_IMPL(insertAt)
+#define UDLIST_removeAt UDLIST_IMPL(removeAt)
+#define UDLIST_newNode UDLIST_IMPL(newNode_)
+#define UDLIST_linkAfter UDLIST_IMPL(linkAfter_)
+#define UDLIST_unlink UDLIST_IMPL(unlink_)
+#define UDLIST_recentre UDLIST_IMPL(recentre_)
+#define UDLIST_find UDLIST_IMPL(find_)
+
+#ifdef UDLIST_DECLS_ONLY
+
+UDLIST_LINKAGE
+UDLIST_NAME*
+UDLIST_newList_kls(Koliseo* kls);
+
+UDLIST_LINKAGE
+UDLIST_NAME*
+UDLIST_newList_t(Koliseo_Temp* t_kls);
+
+UDLIST_LINKAGE
+int
+UDLIST_insertBeginning(UDLIST_NAME* list, UDLIST_T item);
+
+UDLIST_LINKAGE
+int
+UDLIST_insertEnd(UDLIST_NAME* list, UDLIST_T item);
+
+UDLIST_LINKAGE
+int
+UDLIST_popBeginning(UDLIST_NAME* list, UDLIST_T* out);
+
+UDLIST_LINKAGE
+int
+UDLIST_popEnd(UDLIST_NAME* list, UDLIST_T* out);
+
+UDLIST_LINKAGE
+UDLIST_T*
+UDLIST_getAt(UDLIST_NAME* list, size_t pos);
+
+UDLIST_LINKAGE
+int
+UDLIST_insertAt(UDLIST_NAME* list, size_t pos, UDLIST_T item);
+
+UDLIST_LINKAGE
+int
+UDLIST_removeAt(UDLIST_NAME* list, size_t pos, UDLIST_T* out);
+
+#else
+
+// Returns an empty node, reusing an emptied one if possible.
+static inline UDLIST_NODE_NAME* UDLIST_newNode(UDLIST_NAME* list)
+{
+    UDLIST_NODE_NAME* node = list->freeNodes;
+    if (node != NULL) {
+        list->freeNodes = node->next;
+    } else if (list->use_temp) {
+        node = KLS_PUSH_T(list->allocator.t_kls, UDLIST_NODE_NAME);
+    } else {
+        node = KLS_PUSH(list->allocator.kls, UDLIST_NODE_NAME);
+    }
+    if (node == NULL) {
+        fprintf(stderr, "In %s, at %i: %s(): failed pushing node\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    node->prev = NULL;
+    node->next = NULL;
+    node->start = 0;
+    node->count = 0;
+    return node;
+}
+
+// Links new_node after node, or as the first node when node is NULL.
+static inline void UDLIST_linkAfter(UDLIST_NAME* list, UDLIST_NODE_NAME* node, UDLIST_NODE_NAME* new_node)
+{
+    new_node->prev = node;
+    new_node->next = (node ? node->next : list->firstNode);
+    if (new_node->next != NULL) {
+        new_node->next->prev = new_node;
+    } else {
+        list->lastNode = new_node;
+    }
+    if (node != NULL) {
+        node->next = new_node;
+    } else {
+        list->firstNode = new_node;
+    }
+}
+
+// Unlinks node, keeping it for later UDLIST_newNode() calls.
+static inline void UDLIST_unlink(UDLIST_NAME* list, UDLIST_NODE_NAME* node)
+{
+    if (node->prev == NULL) {
+        list->firstNode = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next == NULL) {
+        list->lastNode = node->prev;
+    } else {
+        node->next->prev = node->prev;
+    }
+    node->next = list->freeNodes;
+    list->freeNodes = node;
+}
+
+// Moves the values of node to the middle of its slots.
+static inline void UDLIST_recentre(UDLIST_NODE_NAME* node)
+{
+    size_t start = (UDLIST_NODE_ITEMS - node->count) / 2;
+    memmove(node->items + start, node->items + node->start, node->count * sizeof(UDLIST_T));
+    node->start = start;
+}
+
+// Returns the node holding value pos, setting *off to its offset in the node.
+// Walks from the nearest end, skipping whole nodes.
+static inline UDLIST_NODE_NAME* UDLIST_find(UDLIST_NAME* list, size_t pos, size_t* off)
+{
+    UDLIST_NODE_NAME* node = NULL;
+    if (pos < list->len / 2) {
+        node = list->firstNode;
+        while (pos >= node->count) {
+            pos -= node->count;
+            node = node->next;
+        }
+    } else {
+        size_t from_end = list->len - 1 - pos;
+        node = list->lastNode;
+        while (from_end >= node->count) {
+            from_end -= node->count;
+            node = node->prev;
+        }
+        pos = node->count - 1 - from_end;
+    }
+    *off = pos;
+    return node;
+}
+
+UDLIST_LINKAGE
+UDLIST_NAME*
+UDLIST_newList_kls(Koliseo* kls)
+{
+    if(kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    UDLIST_NAME* list = KLS_PUSH(kls, UDLIST_NAME);
+    if (list == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): list was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    list->use_temp = false;
+    list->allocator.kls = kls;
+    return list;
+}
+
+UDLIST_LINKAGE
+UDLIST_NAME*
+UDLIST_newList_t(Koliseo_Temp* t_kls)
+{
+    if(t_kls == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): t_kls was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    UDLIST_NAME* list = KLS_PUSH_T(t_kls, UDLIST_NAME);
+    if (list == NULL) {
+        fprintf(stderr,"In %s, at %i: %s(): list was NULL.\n", __FILE__, __LINE__, __func__);
+        exit(EXIT_FAILURE);
+    }
+    list->use_temp = true;
+    list->allocator.t_kls = t_kls;
+    return list;
+}
+
+UDLIST_LINKAGE
+int
+UDLIST_insertBeginning(UDLIST_NAME* list, UDLIST_T item)
+{
+    if (list == NULL) {
+        return -1;
+    }
+    UDLIST_NODE_NAME* node = list->firstNode;
+    if (node == NULL || (node->start == 0 && node->count > UDLIST_NODE_ITEMS / 2)) {
+        // New nodes at the front fill from their last slot
+        node = UDLIST_newNode(list);
+        node->start = UDLIST_NODE_ITEMS;
+        UDLIST_linkAfter(list, NULL, node);
+    } else if (node->start == 0) {
+        UDLIST_recentre(node);
+    }
+    node->start--;
+    node->items[node->start] = item;
+    node->count++;
+    list->len++;
+    return 0;
+}
+
+UDLIST_LINKAGE
+int
+UDLIST_insertEnd(UDLIST_NAME* list, UDLIST_T item)
+{
+    if (list == NULL) {
+        return -1;
+    }
+    UDLIST_NODE_NAME* node = list->lastNode;
+    if (node == NULL || (node->start + node->count == UDLIST_NODE_ITEMS && node->count > UDLIST_NODE_ITEMS / 2)) {
+        node = UDLIST_newNode(list);
+        UDLIST_linkAfter(list, list->lastNode, node);
+    } else if (node->start + node->count == UDLIST_NODE_ITEMS) {
+        UDLIST_recentre(node);
+    }
+    node->items[node->start + node->count] = item;
+    node->count++;
+    list->len++;
+    return 0;
+}
+
+UDLIST_LINKAGE
+int
+UDLIST_popBeginning(UDLIST_NAME* list, UDLIST_T* out)
+{
+    // Sets *out to the first value, if out is not NULL, and removes it.
+    if (list == NULL || list->len == 0) {
+        return -1;
+    }
+    UDLIST_NODE_NAME* node = list->firstNode;
+    if (out != NULL) {
+        *out = node->items[node->start];
+    }
+    node->start++;
+    node->count--;
+    list->len--;
+    if (node->count == 0) {
+        UDLIST_unlink(list, node);
+    }
+    return 0;
+}
+
+UDLIST_LINKAGE
+int
+UDLIST_popEnd(UDLIST_NAME* list, UDLIST_T* out)
+{
+    // Sets *out to the last value, if out is not NULL, and removes it.
+    if (list == NULL || list->len == 0) {
+        return -1;
+    }
+    UDLIST_NODE_NAME* node = list->lastNode;
+    node->count--;
+    if (out != NULL) {
+        *out = node->items[node->start + node->count];
+    }
+    list->len--;
+    if (node->count == 0) {
+        UDLIST_unlink(list, node);
+    }
+    return 0;
+}
+
+UDLIST_LINKAGE
+UDLIST_T*
+UDLIST_getAt(UDLIST_NAME* list, size_t pos)
+{
+    // Returns a pointer to the value at pos, valid until the next insert or remove.
+    if (list == NULL || pos >= list->len) {
+        return NULL;
+    }
+    size_t off = 0;
+    UDLIST_NODE_NAME* node = UDLIST_find(list, pos, &off);
+    return &node->items[node->start + off];
+}
+
+UDLIST_LINKAGE
+int
+UDLIST_insertAt(UDLIST_NAME* list, size_t pos, UDLIST_T item)
+{
+    // Inserts item so that it ends up at pos. Full nodes are split in half.
+    if (list == NULL || pos > list->len) {
+        return -1;
+    }
+    if (pos == 0) {
+        return UDLIST_insertBeginning(list, item);
+    }
+    if (pos == list->len) {
+        return UDLIST_insertEnd(list, item);
+    }
+    size_t off = 0;
+    UDLIST_NODE_NAME* node = UDLIST_find(list, pos, &off);
+    if (node->count == UDLIST_NODE_ITEMS) {
+        UDLIST_NODE_NAME* half = UDLIST_newNode(list);
+        size_t keep = node->count / 2;
+        half->count = node->count - keep;
+        memcpy(half->items, node->items + node->start + keep, half->count * sizeof(UDLIST_T));
+        node->count = keep;
+        UDLIST_linkAfter(list, node, half);
+        if (off > keep) {
+            node = half;
+            off -= keep;
+        }
+    }
+    UDLIST_T* at = node->items + node->start + off;
+    if (node->start + node->count < UDLIST_NODE_ITEMS) {
+        memmove(at + 1, at, (node->count - off) * sizeof(UDLIST_T));
+    } else {
+        memmove(node->items + node->start - 1, node->items + node->start, off * sizeof(UDLIST_T));
+        node->start--;
+        at--;
+    }
+    *at = item;
+    node->count++;
+    list->len++;
+    return 0;
+}
+
+UDLIST_LINKAGE
+int
+UDLIST_removeAt(UDLIST_NAME* list, size_t pos, UDLIST_T* out)
+{
+    // Sets *out to the value at pos, if out is not NULL, and removes it.
+    // A node absorbs the next one when together they fill at most half a node.
+    if (list == NULL || pos >= list->len) {
+        return -1;
+    }
+    size_t off = 0;
+    UDLIST_NODE_NAME* node = UDLIST_find(list, pos, &off);
+    UDLIST_T* at = node->items + node->start + off;
+    if (out != NULL) {
+        *out = *at;
+    }
+    memmove(at, at + 1, (node->count - off - 1) * sizeof(UDLIST_T));
+    node->count--;
+    list->len--;
+    if (node->count == 0) {
+        UDLIST_unlink(list, node);
+        return 0;
+    }
+    UDLIST_NODE_NAME* next = node->next;
+    if (next != NULL && node->count + next->count <= UDLIST_NODE_ITEMS / 2) {
+        memmove(node->items, node->items + node->start, node->count * sizeof(UDLIST_T));
+        node->start = 0;
+        memcpy(node->items + node->count, next->items + next->start, next->count * sizeof(UDLIST_T));
+        node->count += next->count;
+        UDLIST_unlink(list, next);
+    }
+    return 0;
+}
+
+#endif // UDLIST_DECLS_ONLY
+
+// Cleanup
+// These need to be undef'ed so they can be redefined the
+// next time you need to instantiate this template.
+#undef UDLIST_T
+#undef UDLIST_PREFIX
+#undef UDLIST_NAME
+#undef UDLIST_LINKAGE
+#undef UDLIST_NODE_NAME
+#undef UDLIST_NODE_ITEMS
+#undef UDLIST_newList_kls
+#undef UDLIST_newList_t
+#undef UDLIST_insertBeginning
+#undef UDLIST_insertEnd
+#undef UDLIST_popBeginning
+#undef UDLIST_popEnd
+#undef UDLIST_getAt
+#undef UDLIST_insertAt
+#undef UDLIST_removeAt
+#undef UDLIST_newNode
+#undef UDLIST_linkAfter
+#undef UDLIST_unlink
+#undef UDLIST_recentre
+#undef UDLIST_find
+#ifdef UDLIST_DECLS_ONLY
+#undef UDLIST_DECLS_ONLY
+#endif // UDLIST_DECLS_ONLY
+#endif // UDLIST_T
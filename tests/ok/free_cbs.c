@@ -0,0 +1,55 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "../../src/koliseo.h"
+
+typedef struct Counter {
+    int* runs;
+    int id;
+} Counter;
+
+static void count_run(void* ctx)
+{
+    Counter* c = ctx;
+    *(c->runs) += 1;
+    printf("Ran callback {%i}\n", c->id);
+}
+
+int main(void)
+{
+    int runs = 0;
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+
+    // A ctx living in the arena must not outlive kls_clear()
+    Counter* c = KLS_PUSH(kls, Counter);
+    *c = (Counter) { .runs = &runs, .id = 1 };
+    kls_on_free(kls, count_run, c);
+    kls_clear(kls);
+    if (runs != 1) {
+        fprintf(stderr, "kls_clear() did not run the callback.\n");
+        kls_free(kls);
+        return 1;
+    }
+
+    // Only the callbacks registered during a temp run when it ends
+    c = KLS_PUSH(kls, Counter);
+    *c = (Counter) { .runs = &runs, .id = 2 };
+    kls_on_free(kls, count_run, c);
+    Koliseo_Temp* t_kls = kls_temp_start(kls);
+    Counter* t_c = KLS_PUSH_T(t_kls, Counter);
+    *t_c = (Counter) { .runs = &runs, .id = 3 };
+    kls_on_free(kls, count_run, t_c);
+    kls_temp_end(t_kls);
+    if (runs != 2) {
+        fprintf(stderr, "kls_temp_end() ran {%i} callbacks.\n", runs - 1);
+        kls_free(kls);
+        return 1;
+    }
+
+    // Pushes over the cleared memory, then the callback left before the temp
+    memset(KLS_PUSH_ARR(kls, char, 64), 0xff, 64);
+    kls_free(kls);
+    printf("Runs: {%i}\n", runs);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return runs == 3 ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "../../src/kls_region.h"
+
+int main(void)
+{
+    Koliseo* kls = kls_new(sizeof(Koliseo) + 64);
+    kls->conf.kls_growable = 1;
+
+    for (int i = 0; i < 40; i++) {
+        int* p = KLS_PUSH(kls, int);
+        *p = i;
+    }
+
+    int blocks = 0;
+    for (Koliseo* current = kls; current != NULL; current = current->next) {
+        blocks++;
+    }
+    KLS_Autoregion_Extension_Data* data = (KLS_Autoregion_Extension_Data*) kls->extension_data[KLS_AUTOREGION_EXT_SLOT];
+    int regions = kls_rl_length(data->regs);
+    printf("Blocks: {%i}, regions: {%i}\n", blocks, regions);
+    if (blocks < 2 || regions != 41) {
+        fprintf(stderr, "Unexpected region count: {%i}.\n", regions);
+        kls_free(kls);
+        return 1;
+    }
+
+    // Start a temp on the grown chain, and grow it again
+    Koliseo_Temp* t_kls = kls_temp_start(kls);
+    if (t_kls == NULL || kls->has_temp != 1) {
+        fprintf(stderr, "Temp not tracked on the first Koliseo.\n");
+        kls_free(kls);
+        return 1;
+    }
+    for (int i = 0; i < 100; i++) {
+        int* p = KLS_PUSH_T(t_kls, int);
+        *p = i;
+    }
+    int t_blocks = 0;
+    for (Koliseo* current = kls; current != NULL; current = current->next) {
+        t_blocks++;
+    }
+    int t_regions = kls_rl_length(data->t_regs);
+    printf("Temp blocks: {%i}, temp regions: {%i}\n", t_blocks, t_regions);
+    if (t_blocks <= blocks || t_regions != 101) {
+        fprintf(stderr, "Unexpected temp region count: {%i}.\n", t_regions);
+        kls_free(kls);
+        return 1;
+    }
+    kls_temp_end(t_kls);
+    if (kls->has_temp != 0) {
+        fprintf(stderr, "Temp still active after kls_temp_end().\n");
+        kls_free(kls);
+        return 1;
+    }
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
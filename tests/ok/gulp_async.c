@@ -0,0 +1,73 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+#define ASYNC_LEN 100
+
+int main(void)
+{
+    const char* names[] = {
+        "./LICENSE",
+        "./README.md",
+        "./src/koliseo.c",
+        "./src/koliseo.h",
+        "./not_a_file.txt",
+        "./tests/ok/kstr_split.k.stderr",
+    };
+    const size_t names_len = sizeof(names) / sizeof(names[0]);
+
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+    kls->conf.kls_growable = 1;
+    Koliseo* ref_kls = kls_new(KLS_DEFAULT_SIZE * 64);
+    Kstr* ref[sizeof(names) / sizeof(names[0])];
+    Gulp_Res ref_res[sizeof(names) / sizeof(names[0])];
+    for (size_t i = 0; i < names_len; i++) {
+        size_t f_size = 0;
+        ref[i] = kls_read_file_to_kstr(ref_kls, names[i], &ref_res[i], &f_size, GULP_MAX_FILE_SIZE, false);
+    }
+
+    int mismatches = 0;
+    Kls_Gulp_Async_Backend backends[] = { KLS_GULP_ASYNC_AUTO, KLS_GULP_ASYNC_THREADS };
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        Kls_Gulp_Async as = {0};
+        if (kls_gulp_async_start(&as, kls, backends[b], 4, GULP_MAX_FILE_SIZE, false) != GULP_FILE_OK) {
+            fprintf(stderr, "Failed starting async gulp.\n");
+            return 1;
+        }
+        size_t seen[ASYNC_LEN] = {0};
+        for (size_t i = 0; i < ASYNC_LEN; i++) {
+            size_t id = 0;
+            if (!kls_gulp_async_submit(&as, names[i % names_len], &id) || id != i) mismatches++;
+        }
+        Kls_Gulp_Completion c = {0};
+        size_t done = 0;
+        while (kls_gulp_async_next(&as, &c)) {
+            size_t n = c.id % names_len;
+            if (c.id >= ASYNC_LEN || seen[c.id]++ != 0) mismatches++;
+            if (c.path != names[n] || c.res != ref_res[n]) mismatches++;
+            if (ref[n] != NULL && !kstr_eq(*ref[n], c.data)) mismatches++;
+            if (ref[n] == NULL && c.data.data != NULL) mismatches++;
+            done++;
+        }
+        if (done != ASYNC_LEN) mismatches++;
+        kls_gulp_async_end(&as);
+    }
+    printf("Mismatches: {%i}\n", mismatches);
+
+    Kls_Gulp_Async as = {0};
+    kls_gulp_async_start(&as, kls, KLS_GULP_ASYNC_AUTO, 0, 64, false);
+    kls_gulp_async_submit(&as, names[0], NULL);
+    kls_gulp_async_submit(&as, names[4], NULL);
+    Kls_Gulp_Completion c = {0};
+    while (kls_gulp_async_next(&as, &c)) {
+        printf("{%s}: {%s}\n", c.path, string_from_Gulp_Res(c.res));
+    }
+    kls_gulp_async_end(&as);
+
+    kls_free(ref_kls);
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+#define BATCH_LEN 64
+
+int main(void)
+{
+    const char* names[] = {
+        "./LICENSE",
+        "./README.md",
+        "./src/koliseo.c",
+        "./src/koliseo.h",
+        "./not_a_file.txt",
+    };
+    const size_t names_len = sizeof(names) / sizeof(names[0]);
+    const char* paths[BATCH_LEN];
+    for (size_t i = 0; i < BATCH_LEN; i++) {
+        paths[i] = names[i % names_len];
+    }
+
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+    Koliseo* ref_kls = kls_new(KLS_DEFAULT_SIZE * 64);
+
+    int mismatches = 0;
+    int workers[] = { 1, 4, 0 };
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); w++) {
+        Kls_Gulp_Batch* batch = kls_gulp_files(kls, paths, BATCH_LEN, workers[w], GULP_MAX_FILE_SIZE, false);
+        if (batch == NULL || batch->count != BATCH_LEN) {
+            fprintf(stderr, "Failed batch.\n");
+            return 1;
+        }
+        for (size_t i = 0; i < names_len; i++) {
+            Gulp_Res err = GULP_FILE_OK;
+            size_t f_size = 0;
+            Kstr* ref = kls_read_file_to_kstr(ref_kls, names[i], &err, &f_size, GULP_MAX_FILE_SIZE, false);
+            for (size_t j = i; j < BATCH_LEN; j += names_len) {
+                if (batch->results[j] != err) mismatches++;
+                if (ref != NULL && !kstr_eq(*ref, batch->files[j])) mismatches++;
+                if (ref == NULL && batch->files[j].data != NULL) mismatches++;
+            }
+            if (w == 0) {
+                printf("{%s}: {%s}\n", names[i], string_from_Gulp_Res(batch->results[i]));
+            }
+        }
+        kls_clear(ref_kls);
+    }
+    printf("Mismatches: {%i}\n", mismatches);
+
+    Kls_Gulp_Batch* small = kls_gulp_files(kls, names, 2, 2, 64, false);
+    printf("{%s}: {%s}\n", names[0], string_from_Gulp_Res(small->results[0]));
+    printf("Empty batch: {%s}\n", (kls_gulp_files(kls, names, 0, 2, 64, false) == NULL ? "NULL" : "not NULL"));
+
+    // The worker Koliseo must not depend on the cleared memory
+    kls_clear(kls);
+    memset(KLS_PUSH_ARR(kls, char, 1024), 0xff, 1024);
+
+    kls_free(ref_kls);
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
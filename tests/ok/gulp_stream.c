@@ -0,0 +1,57 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+static void stream_file(Koliseo* k, const char* filepath, Kstr gulped, size_t chunk_size)
+{
+    int fd = open(filepath, O_RDONLY);
+    Kls_Gulp_Stream stream = {0};
+    if (kls_gulp_stream_start(&stream, k, fd, chunk_size, '\n') != GULP_FILE_OK) {
+        fprintf(stderr, "%s():  kls_gulp_stream_start() failed.\n",__func__);
+        return;
+    }
+    Kstr record = {0};
+    int records = 0;
+    int mismatches = 0;
+    size_t longest = 0;
+    while (kls_gulp_stream_next(&stream, &record)) {
+        Kstr expected = kstr_token(&gulped, '\n');
+        if (!kstr_eq(record, expected)) {
+            mismatches++;
+        }
+        if (record.len > longest) {
+            longest = record.len;
+        }
+        records++;
+    }
+    kls_gulp_stream_end(&stream);
+    close(fd);
+    printf("Chunk size {%zu}: records {%i}, longest {%zu}, mismatches {%i}, leftover {%zu}\n", chunk_size, records, longest, mismatches, gulped.len);
+}
+
+int main(void) {
+    const char* filepath = "./LICENSE";
+
+    Koliseo* k = kls_new(KLS_DEFAULT_SIZE*16);
+    Kstr * gulped = KLS_GULP_FILE_KSTR(k, filepath);
+    if (gulped == NULL) {
+        fprintf(stderr, "%s():  KLS_GULP_FILE_KSTR() failed.\n",__func__);
+        kls_free(k);
+        return 1;
+    }
+    size_t chunk_sizes[] = { 7, 64, 4096, 0 };
+    for (size_t i = 0; i < sizeof(chunk_sizes)/sizeof(chunk_sizes[0]); i++) {
+        stream_file(k, filepath, *gulped, chunk_sizes[i]);
+    }
+
+    // Starting over a Koliseo with an active Koliseo_Temp fails right away
+    Koliseo_Temp* t_kls = kls_temp_start(k);
+    Kls_Gulp_Stream stream = {0};
+    Gulp_Res res = kls_gulp_stream_start(&stream, k, 0, 0, '\n');
+    printf("Start with active temp: {%s}\n", string_from_Gulp_Res(res));
+    kls_temp_end(t_kls);
+    kls_free(k);
+    return 0;
+}
@@ -0,0 +1,79 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+#define HAY_LEN 600
+
+// Naive reference search
+static bool ref_find(Kstr k, Kstr needle, size_t* pos)
+{
+    for (size_t i = 0; i + needle.len <= k.len; i++) {
+        if (memcmp(k.data + i, needle.data, needle.len) == 0) {
+            *pos = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(void)
+{
+    char hay[HAY_LEN];
+    char needle[40];
+    unsigned seed = 42;
+    int mismatches = 0;
+    int checks = 0;
+    for (int level = KSTR_SIMD_SCALAR; level <= KSTR_SIMD_AVX512; level++) {
+        kstr_set_simd_level(level);
+        // Small alphabets make for many partial matches and periodic needles
+        for (int alpha = 1; alpha <= 4; alpha++) {
+            for (int round = 0; round < 40; round++) {
+                size_t hay_len = round * (HAY_LEN / 40);
+                for (size_t i = 0; i < hay_len; i++) {
+                    seed = seed * 1103515245 + 12345;
+                    hay[i] = 'a' + (seed >> 16) % alpha;
+                }
+                for (size_t n_len = 0; n_len < sizeof(needle); n_len += 1 + n_len / 8) {
+                    for (int from_hay = 0; from_hay < 2; from_hay++) {
+                        seed = seed * 1103515245 + 12345;
+                        if (from_hay && hay_len >= n_len) {
+                            memcpy(needle, hay + (seed >> 16) % (hay_len - n_len + 1), n_len);
+                        } else {
+                            for (size_t i = 0; i < n_len; i++) {
+                                seed = seed * 1103515245 + 12345;
+                                needle[i] = 'a' + (seed >> 16) % (alpha + 1);
+                            }
+                        }
+                        Kstr k = kstr_new(hay, hay_len);
+                        Kstr n = kstr_new(needle, n_len);
+                        size_t pos = 0, ref_pos = 0;
+                        bool found = kstr_find(k, n, &pos);
+                        bool ref_found = ref_find(k, n, &ref_pos);
+                        if (found != ref_found || (found && pos != ref_pos)) mismatches++;
+                        checks++;
+                    }
+                }
+            }
+        }
+    }
+    printf("Checks: {%i}, mismatches: {%i}\n", checks, mismatches);
+
+    // Precompiled needle, reused across tokens
+    Kstr_Needle sep = kstr_needle_new(KSTR(", "));
+    Kstr list = KSTR("alpha, beta,gamma, , delta, ");
+    while (list.len > 0) {
+        Kstr tok = kstr_token_needle(&list, &sep);
+        printf("Token: {" Kstr_Fmt "}, rest len: {%zu}\n", Kstr_Arg(tok), list.len);
+    }
+    Kstr rest = KSTR("no delimiter here");
+    Kstr tok = kstr_token_kstr(&rest, KSTR("::"));
+    printf("Token: {" Kstr_Fmt "}, rest len: {%zu}\n", Kstr_Arg(tok), rest.len);
+    rest = KSTR("ab");
+    tok = kstr_token_kstr(&rest, KSTR("abc"));
+    printf("Token: {" Kstr_Fmt "}, rest len: {%zu}\n", Kstr_Arg(tok), rest.len);
+
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
@@ -0,0 +1,49 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE * 16);
+    Kstr* license = KLS_GULP_FILE_KSTR(kls, "./LICENSE");
+    if (license == NULL) {
+        fprintf(stderr, "Failed gulp.\n");
+        return 1;
+    }
+    Kstr_Intern_Pool* pool = kstr_intern_pool_new(kls, 0);
+
+    // Intern every word, then check handles against a second pass
+    size_t words = 0;
+    Kstr rest = *license;
+    while (rest.len > 0) {
+        Kstr word = kstr_trim(kstr_token(&rest, ' '));
+        if (word.len == 0) continue;
+        kstr_intern(pool, word);
+        words++;
+    }
+    int mismatches = 0;
+    rest = *license;
+    while (rest.len > 0) {
+        Kstr word = kstr_trim(kstr_token(&rest, ' '));
+        if (word.len == 0) continue;
+        const Kstr_Interned* a = kstr_intern_lookup(pool, word);
+        const Kstr_Interned* b = kstr_intern(pool, word);
+        if (a == NULL || a != b || !kstr_eq(kstr_from_interned(a), word) || a->hash != kstr_hash(word)) mismatches++;
+        if (a != NULL && a->data[a->len] != '\0') mismatches++;
+    }
+    printf("Words: {%zu}, distinct: {%zu}, mismatches: {%i}\n", words, pool->count, mismatches);
+
+    const Kstr_Interned* hello = kstr_intern(pool, KSTR("hello"));
+    char buf[] = "hello";
+    printf("Same handle: {%s}\n", (hello == kstr_intern(pool, kstr_new(buf, 5)) ? "true" : "false"));
+    printf("Hash: {%#llx}\n", (unsigned long long) hello->hash);
+    printf("Lookup missing: {%s}\n", (kstr_intern_lookup(pool, KSTR("not interned")) == NULL ? "NULL" : "not NULL"));
+    const Kstr_Interned* empty = kstr_intern(pool, KSTR(""));
+    printf("Empty: {" Kstr_Fmt "}, len: {%zu}\n", Kstr_Arg(kstr_from_interned(empty)), empty->len);
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
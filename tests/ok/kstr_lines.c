@@ -0,0 +1,71 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+#define BUF_LEN 700
+#define MAX_LINES BUF_LEN
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+    char buf[BUF_LEN];
+    Kstr ref[MAX_LINES];
+    unsigned seed = 42;
+    int mismatches = 0;
+    int checks = 0;
+    size_t strides[] = { 0, 1, 3, 64 };
+    for (int level = KSTR_SIMD_SCALAR; level <= KSTR_SIMD_AVX512; level++) {
+        kstr_set_simd_level(level);
+        for (int len = 0; len < BUF_LEN; len += 1 + len / 8) {
+            for (int i = 0; i < len; i++) {
+                seed = seed * 1103515245 + 12345;
+                buf[i] = ((seed >> 16) % 16 == 0) ? '\n' : 'a' + (seed >> 16) % 26;
+            }
+            Kstr k = kstr_new(buf, len);
+            // Reference lines
+            size_t lines = 0;
+            Kstr rest = k;
+            while (rest.len > 0) {
+                ref[lines++] = kstr_token(&rest, '\n');
+            }
+            for (size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); s++) {
+                Kstr_Line_Index* idx = kstr_line_index_new(kls, k, strides[s]);
+                if (idx == NULL || idx->lines != lines) {
+                    mismatches++;
+                    continue;
+                }
+                Kstr line = KSTR_NULL;
+                for (size_t i = 0; i < lines; i++) {
+                    if (!kstr_line_at(idx, i, &line) || line.data != ref[i].data || line.len != ref[i].len) mismatches++;
+                    size_t last = (i + 3 < lines ? i + 3 : lines - 1);
+                    const char* end = ref[last].data + ref[last].len;
+                    if (!kstr_line_range(idx, i, last - i + 1, &line) || line.data != ref[i].data || line.data + line.len != end) mismatches++;
+                    for (size_t off = ref[i].data - buf; off <= (size_t)(ref[i].data - buf) + ref[i].len && off < (size_t) len; off++) {
+                        if (kstr_line_of(idx, off) != i) mismatches++;
+                    }
+                }
+                if (kstr_line_at(idx, lines, &line) || kstr_line_range(idx, 0, lines + 1, &line)) mismatches++;
+                kls_clear(kls);
+                checks++;
+            }
+        }
+    }
+    printf("Checks: {%i}, mismatches: {%i}\n", checks, mismatches);
+
+    Kstr text = KSTR("first\nsecond\n\nfourth\nfifth\n");
+    Kstr_Line_Index* idx = kstr_line_index_new(kls, text, 2);
+    printf("Lines: {%zu}, stored offsets: {%zu}\n", idx->lines, idx->count);
+    Kstr line = KSTR_NULL;
+    for (size_t i = 0; kstr_line_at(idx, i, &line); i++) {
+        printf("Line %zu: {" Kstr_Fmt "}\n", i, Kstr_Arg(line));
+    }
+    kstr_line_range(idx, 1, 3, &line);
+    printf("Range 1-3: {" Kstr_Fmt "}\n", Kstr_Arg(line));
+    printf("Line of offset 14: {%zu}\n", kstr_line_of(idx, 14));
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
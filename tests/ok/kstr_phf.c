@@ -0,0 +1,102 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+// Returns the number of keys not mapping to their own distinct id.
+static int check(const Kstr_Phf* phf, const Kstr* keys, size_t count, Koliseo* kls)
+{
+    int mismatches = 0;
+    char* seen = KLS_PUSH_ARR(kls, char, count + 1);
+    for (size_t i = 0; i < count; i++) {
+        ptrdiff_t id = kstr_phf_lookup(phf, keys[i]);
+        if (id < 0 || (size_t) id >= count || seen[id] || !kstr_eq(kstr_phf_key(phf, (uint32_t) id), keys[i])) {
+            mismatches++;
+            continue;
+        }
+        seen[id] = 1;
+    }
+    return mismatches;
+}
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE * 256);
+    kls->conf.kls_growable = 1;
+    Kstr* license = KLS_GULP_FILE_KSTR(kls, "./LICENSE");
+    if (license == NULL) {
+        fprintf(stderr, "Failed gulp.\n");
+        return 1;
+    }
+    // The distinct words of the license
+    Kstr_Intern_Pool* pool = kstr_intern_pool_new(kls, 0);
+    size_t words = 0;
+    Kstr rest = *license;
+    while (rest.len > 0) {
+        Kstr word = kstr_trim(kstr_token(&rest, ' '));
+        if (word.len == 0) continue;
+        kstr_intern(pool, word);
+        words++;
+    }
+    Kstr* keys = KLS_PUSH_ARR(kls, Kstr, pool->count);
+    size_t count = 0;
+    for (size_t i = 0; i < pool->cap; i++) {
+        if (pool->slots[i].interned != NULL) {
+            keys[count++] = kstr_from_interned(pool->slots[i].interned);
+        }
+    }
+    Kstr_Phf* phf = kstr_phf_new(kls, keys, count);
+    if (phf == NULL) {
+        fprintf(stderr, "Failed build.\n");
+        return 1;
+    }
+    printf("Words: {%zu}, keys: {%u}, mismatches: {%i}\n", words, phf->count, check(phf, keys, count, kls));
+    printf("Lookup missing: {%td}, empty: {%td}\n", kstr_phf_lookup(phf, KSTR("not a word")), kstr_phf_lookup(phf, KSTR("")));
+
+    // Reload from a blob, and from a saved file
+    Kstr blob = kstr_phf_serialize(kls, phf);
+    Kstr_Phf* loaded = kstr_phf_load(kls, blob);
+    printf("Loaded: {%s}, mismatches: {%i}\n", (loaded != NULL ? "true" : "false"), (loaded != NULL ? check(loaded, keys, count, kls) : -1));
+    char* unaligned = KLS_PUSH_ARR(kls, char, blob.len + 1);
+    memcpy(unaligned + 1, blob.data, blob.len);
+    loaded = kstr_phf_load(kls, kstr_new(unaligned + 1, blob.len));
+    printf("Loaded unaligned: {%s}, mismatches: {%i}\n", (loaded != NULL ? "true" : "false"), (loaded != NULL ? check(loaded, keys, count, kls) : -1));
+    FILE* fp = tmpfile();
+    if (fp == NULL || !kstr_phf_save(phf, fp)) {
+        fprintf(stderr, "Failed save.\n");
+        return 1;
+    }
+    long size = ftell(fp);
+    rewind(fp);
+    char* saved = KLS_PUSH_ARR(kls, char, size);
+    size_t read = fread(saved, 1, size, fp);
+    fclose(fp);
+    printf("Saved: {%s}\n", ((size_t) size == blob.len && read == blob.len && memcmp(saved, blob.data, blob.len) == 0 ? "same as blob" : "different"));
+    loaded = kstr_phf_load(kls, kstr_new(saved, blob.len));
+    printf("Loaded saved: {%s}, same ids: {%s}\n", (loaded != NULL ? "true" : "false"),
+           (loaded != NULL && kstr_phf_lookup(loaded, keys[0]) == kstr_phf_lookup(phf, keys[0]) ? "true" : "false"));
+
+    // Malformed blobs and key sets are refused
+    printf("Load truncated: {%s}\n", (kstr_phf_load(kls, kstr_new(blob.data, blob.len - 1)) == NULL ? "NULL" : "not NULL"));
+    Kstr dups[] = { KSTR("a"), KSTR("b"), KSTR("a") };
+    printf("Duplicates: {%s}\n", (kstr_phf_new(kls, dups, 3) == NULL ? "NULL" : "not NULL"));
+    Kstr_Phf* none = kstr_phf_new(kls, NULL, 0);
+    printf("Empty set: {%u}, lookup: {%td}\n", none->count, kstr_phf_lookup(none, KSTR("a")));
+    Kstr_Phf* none_loaded = kstr_phf_load(kls, kstr_phf_serialize(kls, none));
+    printf("Empty set loaded: {%s}\n", (none_loaded != NULL && none_loaded->count == 0 ? "true" : "false"));
+
+    // Many generated keys
+    size_t many = 200000;
+    Kstr* gen = KLS_PUSH_ARR(kls, Kstr, many);
+    for (size_t i = 0; i < many; i++) {
+        char* key = kls_sprintf(kls, "key_%zu", i);
+        gen[i] = kstr_new(key, strlen(key));
+    }
+    Kstr_Phf* big = kstr_phf_new(kls, gen, many);
+    printf("Generated: {%u}, mismatches: {%i}, lookup missing: {%td}\n", big->count, check(big, gen, many, kls), kstr_phf_lookup(big, KSTR("key_x")));
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
@@ -0,0 +1,99 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+#define BUF_LEN 300
+
+// Byte-at-a-time references, matching the original implementations.
+static bool ref_indexof(Kstr k, char c, int* idx)
+{
+    for (size_t i = 0; i < k.len; i++) {
+        if (k.data[i] == c) {
+            *idx = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ref_eq_ignorecase(Kstr left, Kstr right)
+{
+    if (left.len != right.len) return false;
+    for (size_t i = 0; i < left.len; i++) {
+        char l = 'A' <= left.data[i] && 'Z' >= left.data[i] ? left.data[i] + 32 : left.data[i];
+        char r = 'A' <= right.data[i] && 'Z' >= right.data[i] ? right.data[i] + 32 : right.data[i];
+        if (l != r) return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    char buf[BUF_LEN];
+    char other[BUF_LEN];
+    unsigned seed = 42;
+    for (int i = 0; i < BUF_LEN; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (char) ((seed >> 16) & 0xFF);
+        if (buf[i] == ';' || buf[i] == '\xF0') buf[i] = 'x';
+    }
+    int mismatches = 0;
+    int checks = 0;
+    for (int level = KSTR_SIMD_SCALAR; level <= KSTR_SIMD_AVX512; level++) {
+        kstr_set_simd_level(level);
+        for (int len = 0; len < 200; len++) {
+            for (int start = 0; start < 4; start++) {
+                Kstr k = kstr_new(buf + start, len);
+                // Plant a delimiter at each position, plus none
+                for (int at = -1; at < len; at += (len / 7) + 1) {
+                    char saved = 0;
+                    if (at >= 0) {
+                        saved = buf[start + at];
+                        buf[start + at] = ';';
+                    }
+                    int idx = -1, ref_idx = -1;
+                    bool found = kstr_indexof(k, ';', &idx);
+                    bool ref_found = ref_indexof(k, ';', &ref_idx);
+                    if (found != ref_found || idx != ref_idx) mismatches++;
+
+                    Kstr tok_k = k;
+                    Kstr tok = kstr_token(&tok_k, ';');
+                    size_t ref_len = (ref_found ? (size_t) ref_idx : k.len);
+                    if (tok.len != ref_len || tok_k.len != k.len - ref_len - (ref_found ? 1 : 0)) mismatches++;
+
+                    Kstr try_k = k;
+                    Kstr part = KSTR_NULL;
+                    if (kstr_try_token(&try_k, ';', &part) != ref_found) mismatches++;
+
+                    if (at >= 0) {
+                        buf[start + at] = saved;
+                    }
+                    checks++;
+                }
+                // Equality, with a difference at each position, plus none
+                memcpy(other, buf + start, len);
+                for (int i = 0; i < len; i++) {
+                    if (other[i] >= 'a' && other[i] <= 'z' && (i % 3 == 0)) other[i] -= 32;
+                }
+                Kstr o = kstr_new(other, len);
+                for (int at = -1; at < len; at += (len / 5) + 1) {
+                    char saved = 0;
+                    if (at >= 0) {
+                        saved = other[at];
+                        other[at] = '\xF0';
+                    }
+                    if (kstr_eq(k, o) != (memcmp(k.data, o.data, len) == 0)) mismatches++;
+                    if (kstr_eq_ignorecase(k, o) != ref_eq_ignorecase(k, o)) mismatches++;
+                    if (at >= 0) {
+                        other[at] = saved;
+                    }
+                    checks++;
+                }
+            }
+        }
+    }
+    printf("Checks: {%i}, mismatches: {%i}\n", checks, mismatches);
+    return 0;
+}
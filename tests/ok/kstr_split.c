@@ -0,0 +1,61 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+#define BUF_LEN 400
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+    char buf[BUF_LEN];
+    unsigned seed = 42;
+    int mismatches = 0;
+    int checks = 0;
+    for (int level = KSTR_SIMD_SCALAR; level <= KSTR_SIMD_AVX512; level++) {
+        kstr_set_simd_level(level);
+        // Sparse to dense delimiters
+        for (int density = 1; density <= 64; density *= 4) {
+            for (int len = 0; len < BUF_LEN; len += 1 + len / 16) {
+                for (int i = 0; i < len; i++) {
+                    seed = seed * 1103515245 + 12345;
+                    buf[i] = ((seed >> 16) % 128 < (unsigned) density) ? ',' : 'a' + (seed >> 16) % 26;
+                }
+                Kstr k = kstr_new(buf, len);
+                size_t count = 0;
+                Kstr* parts = kstr_split_all(kls, k, ',', &count);
+                Kstr_Split_Iter it = kstr_split_iter(k, ',');
+                Kstr rest = k;
+                size_t i = 0;
+                Kstr part = KSTR_NULL;
+                while (rest.len > 0) {
+                    Kstr tok = kstr_token(&rest, ',');
+                    if (i >= count || !kstr_eq(tok, parts[i]) || parts[i].data != tok.data) mismatches++;
+                    if (!kstr_split_next(&it, &part) || !kstr_eq(tok, part) || part.data != tok.data) mismatches++;
+                    i++;
+                }
+                if (i != count || kstr_split_next(&it, &part)) mismatches++;
+                size_t ref_count = 0;
+                for (int j = 0; j < len; j++) ref_count += (buf[j] == ',');
+                if (kstr_count(k, ',') != ref_count) mismatches++;
+                kls_clear(kls);
+                checks++;
+            }
+        }
+    }
+    printf("Checks: {%i}, mismatches: {%i}\n", checks, mismatches);
+
+    size_t count = 0;
+    Kstr* parts = kstr_split_all(kls, KSTR("a,,bc,d,"), ',', &count);
+    printf("Count: {%zu}\n", count);
+    for (size_t i = 0; i < count; i++) {
+        printf("Part: {" Kstr_Fmt "}\n", Kstr_Arg(parts[i]));
+    }
+    parts = kstr_split_all(kls, KSTR(""), ',', &count);
+    printf("Empty count: {%zu}, parts: {%s}\n", count, (parts == NULL ? "NULL" : "not NULL"));
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
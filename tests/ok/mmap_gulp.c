@@ -0,0 +1,23 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+int main(void) {
+    const char* filepath = "./LICENSE";
+
+    Koliseo* k = kls_new(KLS_DEFAULT_SIZE*4);
+    Kstr * mapped = KLS_GULP_FILE_MMAP(k, filepath);
+    Kstr * gulped = KLS_GULP_FILE_KSTR(k, filepath);
+    if (mapped != NULL && gulped != NULL) {
+        printf("[Mapped file as Kstr]\n");
+        printf("Same as gulped: {%s}\n", kstr_eq(*mapped, *gulped) ? "true" : "false");
+        Kstr first_line = kstr_token(mapped, '\n');
+        printf("First line: {" Kstr_Fmt "}\n", Kstr_Arg(first_line));
+    } else {
+        fprintf(stderr, "%s():  KLS_GULP_FILE_MMAP() failed.\n",__func__);
+    }
+    kls_free(k);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "../../src/kls_region.h"
+
+static void print_list(const char* label, KLS_Region_List l)
+{
+    printf("%s: {", label);
+    for (; !kls_rl_empty(l); l = kls_rl_tail(l)) {
+        printf(" %s", kls_rl_head(l)->name);
+    }
+    printf(" }\n");
+}
+
+static void print_arr(const char* label, KLS_Region_Array ra)
+{
+    printf("%s [%td]: {", label, ra.count);
+    for (ptrdiff_t i = 0; i < ra.count; i++) {
+        printf(" %s", ra.regs[i]->name);
+    }
+    printf(" }\n");
+}
+
+int main(void)
+{
+    Koliseo* kls = kls_new(KLS_DEFAULT_SIZE);
+    char names[6][4] = { "r0", "r1", "r2", "r3", "r4", "r5" };
+    for (int i = 0; i < 6; i++) {
+        KLS_PUSH_NAMED(kls, int, names[i], "int");
+    }
+    KLS_Autoregion_Extension_Data* data_pt = (KLS_Autoregion_Extension_Data*) kls->extension_data[KLS_AUTOREGION_EXT_SLOT];
+
+    // Skip KLS_Header, regs holds r5 .. r0
+    KLS_Region* r[6];
+    KLS_Region_List it = data_pt->regs;
+    for (int i = 5; i >= 0; i--) {
+        r[i] = kls_rl_head(it);
+        it = kls_rl_tail(it);
+    }
+
+    KLS_Region_List l1 = kls_rl_emptyList();
+    KLS_Region_List l2 = kls_rl_emptyList();
+    // l1: r0 r3 r1 r3 r4 r0
+    int l1_idx[] = { 0, 4, 3, 1, 3, 0 };
+    for (int i = 0; i < 6; i++) {
+        l1 = kls_rl_cons(kls, r[l1_idx[i]], l1);
+    }
+    // l2: r3 r2 r0
+    int l2_idx[] = { 0, 2, 3 };
+    for (int i = 0; i < 3; i++) {
+        l2 = kls_rl_cons(kls, r[l2_idx[i]], l2);
+    }
+
+    print_list("l1", l1);
+    print_list("l2", l2);
+    print_list("append", kls_rl_append(kls, l1, l2));
+    print_list("reverse", kls_rl_reverse(kls, l1));
+    print_list("copy", kls_rl_copy(kls, l1));
+    print_list("delete r3", kls_rl_delete(kls, r[3], l1));
+    print_list("insord r2", kls_rl_insord(kls, r[2], kls_rl_copy(kls, l2)));
+    print_list("intersect", kls_rl_intersect(kls, l1, l2));
+    print_list("diff", kls_rl_diff(kls, l1, l2));
+    printf("length: {%i}\n", kls_rl_length(l1));
+
+    Koliseo* arr_kls = kls_new_conf_ext(KLS_DEFAULT_SIZE, KLS_DEFAULT_CONF, &(KLS_Hooks){0}, NULL, 0);
+    Koliseo_Temp* t_kls = kls_temp_start(arr_kls);
+    KLS_Region_Array a1 = kls_ra_from_list(t_kls, l1);
+    KLS_Region_Array a2 = kls_ra_from_list(t_kls, l2);
+    KLS_Region_Array empty = kls_ra_from_list(t_kls, kls_rl_emptyList());
+    kls_ra_sort(&a1);
+    kls_ra_sort(&a2);
+    print_arr("a1", a1);
+    print_arr("a2", a2);
+    print_arr("merge", kls_ra_merge(t_kls, a1, a2));
+    print_arr("intersect", kls_ra_intersect(t_kls, a1, a2));
+    print_arr("diff", kls_ra_diff(t_kls, a1, a2));
+    print_arr("diff empty", kls_ra_diff(t_kls, a1, empty));
+    print_arr("intersect empty", kls_ra_intersect(t_kls, empty, a2));
+    kls_temp_end(t_kls);
+    kls_free(arr_kls);
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
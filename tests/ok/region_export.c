@@ -0,0 +1,40 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "../../src/kls_region.h"
+
+typedef struct Example {
+    char tag;
+    double val;
+} Example;
+
+int main(void)
+{
+    Koliseo* kls = kls_new(sizeof(Koliseo) + 64);
+    kls->conf.kls_growable = 1;
+
+    for (int i = 0; i < 4; i++) {
+        KLS_PUSH_NAMED(kls, char, "tag", "char");
+        KLS_PUSH_NAMED(kls, Example, "example", "Example");
+    }
+
+    if (kls_export_regions_toFile(kls, stdout, KLS_REGION_EXPORT_CSV) != 0) {
+        fprintf(stderr, "Failed CSV export.\n");
+        kls_free(kls);
+        return 1;
+    }
+
+    FILE* fp = tmpfile();
+    if (fp == NULL || kls_export_regions_toFile(kls, fp, KLS_REGION_EXPORT_BIN) != 0) {
+        fprintf(stderr, "Failed binary export.\n");
+        kls_free(kls);
+        return 1;
+    }
+    long bin_size = ftell(fp);
+    fclose(fp);
+    printf("Binary size: {%li}, records: {%li}\n", bin_size, (bin_size - KLS_REGION_EXPORT_BIN_HEADER_SIZE) / KLS_REGION_EXPORT_BIN_RECORD_SIZE);
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}
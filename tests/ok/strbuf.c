@@ -0,0 +1,64 @@
+// jgabaut @ github.com/jgabaut
+// SPDX-License-Identifier: GPL-3.0-only
+#include "../../src/koliseo.h"
+#define KLS_GULP_IMPLEMENTATION
+#include "../../src/kls_gulp.h"
+
+int main(void)
+{
+    Koliseo* kls = kls_new_conf_ext(KLS_DEFAULT_SIZE, KLS_DEFAULT_CONF, &(KLS_Hooks){0}, NULL, 0);
+    Kls_StrBuf sb = {0};
+
+    // Grows in place while last
+    kls_strbuf_start(&sb, kls, 8);
+    char* start = sb.data;
+    kls_strbuf_append_str(&sb, "Hello");
+    kls_strbuf_append_kstr(&sb, KSTR(", "));
+    for (int i = 0; i < 20; i++) {
+        kls_strbuf_appendf(&sb, "%i%s", i, (i < 19 ? "," : ""));
+    }
+    ptrdiff_t len = 0;
+    char* s = kls_strbuf_finish(&sb, &len);
+    printf("in place: {%s}, len: {%td}, moved: {%i}, strlen ok: {%i}\n", s, len, s != start, (ptrdiff_t) strlen(s) == len);
+    printf("slack given back: {%i}\n", kls->offset == (s - kls->data) + len + 1);
+
+    // Moves when another push lands in between
+    kls_strbuf_start(&sb, kls, 0);
+    start = sb.data;
+    kls_strbuf_append_str(&sb, "before");
+    int* gap = KLS_PUSH(kls, int);
+    *gap = 42;
+    kls_strbuf_appendf(&sb, " and %s %0*i", "after", KLS_STRBUF_MIN_GROW, 0);
+    Kstr k = kls_strbuf_finish_kstr(&sb);
+    printf("moved: {%.*s}, len: {%zu}, moved: {%i}, gap: {%i}\n", 16, k.data, k.len, k.data != start, *gap);
+
+    // Formatting longer than the free capacity runs again once
+    kls_strbuf_start(&sb, kls, 4);
+    kls_strbuf_appendf(&sb, "%0*i", 300, 7);
+    s = kls_strbuf_finish(&sb, &len);
+    printf("long format: len: {%td}, last: {%c}\n", len, s[len - 1]);
+
+    // Empty builder
+    kls_strbuf_start(&sb, kls, 0);
+    k = kls_strbuf_finish_kstr(&sb);
+    printf("empty: len: {%zu}, term: {%i}\n", k.len, k.data[0] == '\0');
+
+    // Growable Koliseo moves to a new block
+    Koliseo* g = kls_new_conf_ext(sizeof(Koliseo) + 64, KLS_DEFAULT_CONF, &(KLS_Hooks){0}, NULL, 0);
+    g->conf.kls_growable = 1;
+    kls_strbuf_start(&sb, g, 0);
+    for (int i = 0; i < 64; i++) {
+        kls_strbuf_append(&sb, "abcd", 4);
+    }
+    s = kls_strbuf_finish(&sb, &len);
+    printf("growable: len: {%td}, strlen ok: {%i}, next: {%i}\n", len, (ptrdiff_t) strlen(s) == len, g->next != NULL);
+    kls_free(g);
+
+    char* f = kls_sprintf(kls, "%s-%i", "short", 1);
+    char* l = kls_sprintf(kls, "%0*i", 400, 1);
+    printf("kls_sprintf: {%s}, long len: {%zu}\n", f, strlen(l));
+
+    kls_free(kls);
+    printf("Done test {\"%s\"}.\n",__FILE__);
+    return 0;
+}